@@ -4,7 +4,11 @@
 #include <utility>
 
 #include "vivid/app/SDL3App.h"
+#include "vivid/input/camera_control_system.h"
 #include "vivid/log/log.h"
+#include "vivid/plugins/InputRecordingPlugin.h"
+#include "vivid/plugins/MemoryReportPlugin.h"
+#include "vivid/plugins/TransformPlugin.h"
 #include "vivid/rendering/render_component.h"
 #include "vivid/window/window_systems.h"
 
@@ -172,7 +176,7 @@ void hello_startup_system(Resources&, entt::registry& world) {
   camTransform.Position = {0.0f, 0.0f, 5.0f};
   world.emplace<CameraComponent>(cameraEntity);
   world.emplace<ViewportComponent>(cameraEntity);
-  // world.emplace<CameraControllerComponent>(cameraEntity);
+  world.emplace<CameraControllerComponent>(cameraEntity);
 }
 
 // Custom window creation system - demonstrates ECS approach
@@ -291,19 +295,67 @@ VIVID_SDL3_MAIN(
         .insert_resource<MyResource>(100)
         // .add_plugin<DefaultPlugin>()
         .add_plugin<VIVID::Window::WindowPlugin>()
-        .add_startup_system(hello_startup_system)
-        .add_startup_system(create_custom_window_system)
-        .add_startup_system(VIVID::Render::CreateWebGPUInstance)
-        .add_startup_system(VIVID::Render::RequestWebGPUAdapterSync)
-        .add_startup_system(VIVID::Render::InspectWebGPUAdapter)
-        .add_startup_system(VIVID::Render::RequestWebGPUDeviceSync)
-        .add_startup_system(VIVID::Render::InspectWebGPUDevice)
-        .add_startup_system(VIVID::Render::TestCommandQueue)
-        .add_startup_system(VIVID::Render::ConfigureSurface)
-        .add_startup_system(VIVID::Render::SyncScene)
+        .add_plugin<MemoryReportPlugin>()
+        // VIVID_RECORD_INPUT=<file> records SDL input and frame times; VIVID_REPLAY_INPUT=<file>
+        // replays them (VIVID_REPLAY_DELTA=<seconds> for a fixed step) and exits at the end.
+        .add_plugin<InputRecordingPlugin>()
+        // Parent/child transforms: cached world matrices, propagated in PostUpdate.
+        .add_plugin<TransformPlugin>()
+        // Startup graph: scene construction runs on a worker thread while the main thread does
+        // the WebGPU instance/adapter/device handshake. Systems that declare their access only
+        // serialize against conflicting systems; undeclared ones stay exclusive.
+        // Owning group for the per-frame render extraction; created before any entity exists.
+        .add_startup_system(VIVID::Render::CreateRenderGroups, SystemConfig("render_groups"))
+        .add_startup_system(
+            create_custom_window_system,
+            SystemConfig("create_window").spawns().writes<VIVID::Window::WindowComponent>())
+        .add_startup_system(hello_startup_system, SystemConfig("build_scene")
+                                                      .spawns()
+                                                      .writes<TagComponent>()
+                                                      .writes<TransformComponent>()
+                                                      .writes<MeshComponent>()
+                                                      .writes<MaterialComponent>()
+                                                      .writes<LightComponent>()
+                                                      .writes<CameraComponent>()
+                                                      .writes<ViewportComponent>()
+                                                      .writes<CameraControllerComponent>()
+                                                      .worker_thread())
+        .add_startup_system(VIVID::Render::CreateWebGPUInstance,
+                            SystemConfig("webgpu_instance").writes_resource<WebGPUResources>())
+        .add_startup_system(VIVID::Render::RequestWebGPUAdapterSync,
+                            SystemConfig("webgpu_adapter")
+                                .writes_resource<WebGPUResources>()
+                                .reads<VIVID::Window::WindowGpuComponent>())
+        .add_startup_system(VIVID::Render::InspectWebGPUAdapter,
+                            SystemConfig("inspect_adapter").reads_resource<WebGPUResources>())
+        .add_startup_system(VIVID::Render::RequestWebGPUDeviceSync,
+                            SystemConfig("webgpu_device").writes_resource<WebGPUResources>())
+        .add_startup_system(VIVID::Render::InspectWebGPUDevice,
+                            SystemConfig("inspect_device").reads_resource<WebGPUResources>())
+        .add_startup_system(VIVID::Render::TestCommandQueue,
+                            SystemConfig("test_queue").reads_resource<WebGPUResources>())
+        .add_startup_system(VIVID::Render::ConfigureSurface,
+                            SystemConfig("configure_surface")
+                                .writes_resource<WebGPUResources>()
+                                .reads<VIVID::Window::WindowGpuComponent>())
+        // Exclusive: waits for both the scene and the surface
+        .add_startup_system(VIVID::Render::SyncScene, SystemConfig("upload_scene"))
         .add_startup_system(VIVID::UI::initImGui)
-        .add_system(ScheduleLabel::Update, VIVID::UI::ShowImGuiDemo)
-        .add_system(ScheduleLabel::Update, VIVID::Render::Draw)
+        .add_system(ScheduleLabel::Update, VIVID::UI::ShowImGuiDemo, SystemConfig("imgui_demo"))
+        .add_system(ScheduleLabel::Update, VIVID::UI::ShowMemoryPanel,
+                    SystemConfig("memory_panel").after("imgui_demo"))
+        // WASD/QE + right-drag fly camera, driven only by Events<SDL_Event> so replays match
+        .add_system(ScheduleLabel::Update, VIVID_SYSTEM(VIVID::Input::camera_control_system))
+        // Upload meshes spawned after startup; skipped while nothing new was added.
+        // Runs in PreUpdate so its deferred GpuMeshComponent inserts are applied before extraction.
+        .add_system(ScheduleLabel::PreUpdate, VIVID::Render::SyncScene,
+                    SystemConfig("sync_scene")
+                        .run_if(any_added<MeshComponent>() || any_added<MeshHandle>()
+                                || any_added<MaterialComponent>()))
+        // Copies render data at the end of PostUpdate; the render thread encodes and submits
+        // frame N while frame N+1 simulates.
+        .add_system(ScheduleLabel::PostUpdate, VIVID::Render::ExtractRender,
+                    SystemConfig("extract_render").after("transform_propagate"))
         .add_system(ScheduleLabel::Event, VIVID::UI::ProcessImGuiEvent)
         .add_system(ScheduleLabel::Shutdown, VIVID::Render::ReleaseWebGPUResources)
         .add_system(ScheduleLabel::Shutdown, VIVID::UI::ShutDownImGui)
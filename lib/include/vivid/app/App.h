@@ -1,14 +1,39 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <thread>
 #include <type_traits>
 #include <vector>
 
+#include "ChangeDetection.h"
+#include "Commands.h"
+#include "Events.h"
+#include "FrameArena.h"
+#include "FrameStats.h"
+#include "MemoryReport.h"
 #include "Plugin.h"
+#include "Profiler.h"
 #include "Resources.h"
 #include "Schedule.h"
+#include "SpawnBatch.h"
+#include "StartupTimeline.h"
+#include "SystemParam.h"
+#include "TaskPool.h"
+#include "Time.h"
+
+// 以函数名作为系统名称：app.add_system(ScheduleLabel::Update, VIVID_SYSTEM(physics_step))
+// 展开为 "函数, SystemConfig("函数名")"，后面可以继续链式调用 .before() / .after() / .run_if()
+#define VIVID_SYSTEM(fn) fn, SystemConfig(#fn)
+
+// 运行模式：Headless 下跳过需要窗口的插件（Plugin::requires_window），用于无窗口的 CI 节点
+enum class RunMode { Windowed, Headless };
+
+// 退出请求：系统通过 EventWriter<AppExit> 发送，App 运行完当前帧后停止（与 exit() 相同）
+struct AppExit {};
 
 // 应用程序主类
 class App {
@@ -19,11 +44,58 @@ private:
   std::vector<std::unique_ptr<Plugin>> plugins_;
   bool running_ = true;
   bool initialized_ = false;
+  RunMode run_mode_ = RunMode::Windowed;
+  ResourceHandle<FrameStats> frame_stats_ = resources_.handle<FrameStats>();
+  ResourceHandle<FrameArena> frame_arena_ = resources_.handle<FrameArena>();
+  ResourceHandle<Events<AppExit>> app_exit_ = resources_.handle<Events<AppExit>>();
+  std::vector<void (*)(Resources &)> event_updaters_;
+  const uint64_t created_ns_ = Schedule::clock_ns();
+  bool first_frame_done_ = false;
+  std::ostream *log_ = &std::cout;
+  bool profile_frames_ = true;
 
 public:
-  App() = default;
+  // 默认插入工作线程池资源，供调度器并行执行系统；替换为 TaskPool(1) 等可调整线程数。
+  // ChangeDetection 提供变更 tick，供 Added / Changed / Removed 与 run_if 条件使用；
+  // CommandQueue 收集 Commands 记录的延迟命令，在每个阶段结束时应用；
+  // Time 在每帧开始时更新，并驱动 FixedUpdate 的固定步长；
+  // FrameArena 提供帧内临时内存（FrameScratch / frame_scratch），在 Cleanup 阶段之后重置；
+  // MemoryTracker 生成组件存储与资源的内存报告；
+  // Events<AppExit> 供系统请求退出
+  App() {
+    resources_.insert<TaskPool>();
+    resources_.insert<ChangeDetection>();
+    resources_.insert<CommandQueue>();
+    resources_.insert<Time>();
+    resources_.insert<FrameArena>();
+    resources_.insert<MemoryTracker>();
+    add_event<AppExit>(4);
+  }
+
+  // 设置运行模式，需要在添加插件之前调用
+  App &set_run_mode(RunMode mode) {
+    run_mode_ = mode;
+    return *this;
+  }
+
+  RunMode run_mode() const { return run_mode_; }
 
-  // 链式调用入口
+  // App 自身的文本输出（插件列表、启动时间线、帧统计等）写入的流，默认 std::cout；
+  // nullptr 表示不输出。多个 App 并行运行时各自设置，输出不会交错
+  App &set_log_stream(std::ostream *stream) {
+    log_ = stream;
+    return *this;
+  }
+
+  // 是否由这个 App 在每帧开始时标记性能分析器的帧（Profiler 是进程级的）。
+  // 同一进程中并行运行多个 App 时只能有一个负责标记，BatchRunner 会关闭各世界的标记
+  App &set_profile_frames(bool enabled) {
+    profile_frames_ = enabled;
+    return *this;
+  }
+
+  // 链式调用入口：进程级的单个实例，仅供只有一个 App 的程序使用；
+  // 需要多个互相独立的世界时直接构造 App（见 BatchRunner）
   static App &new_app() {
     static App instance;
     return instance;
@@ -33,48 +105,113 @@ public:
   template <typename T, typename... Args> App &add_plugin(Args &&...args) {
     static_assert(std::is_base_of_v<Plugin, T>, "T must inherit from Plugin");
     auto plugin = std::make_unique<T>(std::forward<Args>(args)...);
-    std::cout << "Adding plugin: " << plugin->name() << std::endl;
+    if (run_mode_ == RunMode::Headless && plugin->requires_window()) {
+      log() << "Skipping plugin in headless mode: " << plugin->name() << std::endl;
+      return *this;
+    }
+    log() << "Adding plugin: " << plugin->name() << std::endl;
     plugin->build(*this);
     plugins_.push_back(std::move(plugin));
     return *this;
   }
 
   // 添加系统
-  //   template <typename Fn> App &add_system(ScheduleLabel label, Fn &&fn) {
-  //     schedule_.add_system(
-  //         label, [fn = std::forward<Fn>(fn)](Resources &res, entt::registry &reg) { fn(res, reg);
-  //         });
-  //     return *this;
-  //   }
-
-  // 添加无资源访问的系统，以保持兼容性
-  //   App &add_system(ScheduleLabel label, std::function<void(entt::registry &)> fn) {
-  //     schedule_.add_system(label,
-  //                          [fn = std::move(fn)](Resources &, entt::registry &reg) { fn(reg); });
-  //     return *this;
-  //   }
-  template <typename Fn> App &add_system(ScheduleLabel label, Fn &&fn) {
+  // config 可选：系统名称、before/after 顺序约束（在 initialize() 冻结调度表时解析）以及 run_if 条件
+  template <typename Fn>
+  App &add_system(ScheduleLabel label, Fn &&fn, SystemConfig config = {}) {
+    SystemMeta meta;
+    meta.name = std::move(config.name);
+    if constexpr (std::is_class_v<std::decay_t<Fn>>) {
+      // lambda / 函数对象：用类型名作为性能分析中的默认名称；普通函数请使用 VIVID_SYSTEM
+      if (meta.name.empty()) meta.type_name = std::string(entt::type_name<std::decay_t<Fn>>::value());
+    }
+    meta.before = std::move(config.run_before);
+    meta.after = std::move(config.run_after);
+
+    // 每个分支只包一层适配 lambda，直接存入调度器的小缓冲区调用对象，不再经过 std::function
     if constexpr (std::is_invocable_v<Fn, Resources &, entt::registry &>) {
       // 双参数系统
-      schedule_.add_system(label, [fn = std::forward<Fn>(fn)](Resources &res, entt::registry &reg) {
-        fn(res, reg);
-      });
+      legacy_access(meta, config);
+      schedule_.add_system(
+          label,
+          [fn = std::forward<Fn>(fn)](Resources &res, entt::registry &reg, SystemMeta &) mutable {
+            fn(res, reg);
+          },
+          std::move(meta), std::move(config.conditions));
     } else if constexpr (std::is_invocable_v<Fn, entt::registry &>) {
       // 单参数系统
+      legacy_access(meta, config);
+      schedule_.add_system(
+          label,
+          [fn = std::forward<Fn>(fn)](Resources &, entt::registry &reg, SystemMeta &) mutable {
+            fn(reg);
+          },
+          std::move(meta), std::move(config.conditions));
+    } else if constexpr (is_param_system_v<Fn>) {
+      // 类型化参数系统：Query<...> / Res<T> / ResMut<T> / MainThread
+      // 根据参数推导读写集合，调度器据此并行执行互不冲突的系统
+      meta.access = deduce_system_access<Fn>();
+      meta.access.merge(config.access);
       schedule_.add_system(
-          label, [fn = std::forward<Fn>(fn)](Resources &, entt::registry &reg) { fn(reg); });
+          label,
+          [fn = std::forward<Fn>(fn)](Resources &res, entt::registry &reg,
+                                      SystemMeta &meta) mutable {
+            invoke_param_system(fn, res, reg, meta);
+          },
+          std::move(meta), std::move(config.conditions));
     } else {
       static_assert(
           std::is_invocable_v<Fn, entt::registry &>
-              || std::is_invocable_v<Fn, Resources &, entt::registry &>,
-          "System function must accept either (entt::registry&) or (Resources&, entt::registry&)");
+              || std::is_invocable_v<Fn, Resources &, entt::registry &> || is_param_system_v<Fn>,
+          "System function must accept either (entt::registry&), (Resources&, entt::registry&) "
+          "or system params such as Query<...>, Res<T>, ResMut<T>");
     }
     return *this;
   }
 
-  // 添加启动系统
-  template <typename Fn> App &add_startup_system(Fn &&fn) {
-    return add_system(ScheduleLabel::Startup, std::forward<Fn>(fn));
+  // 旧式系统默认独占并固定在主线程；SystemConfig 显式声明了访问时改用声明的访问
+  static void legacy_access(SystemMeta &meta, SystemConfig &config) {
+    if (!config.declared_access) {
+      meta.access.exclusive = true;
+      meta.access.main_thread = true;
+      return;
+    }
+    meta.access = std::move(config.access);
+    meta.access.main_thread = !config.on_worker_thread;
+  }
+
+  // 添加启动系统；声明了依赖（after/before）和访问的启动系统可以并行运行
+  template <typename Fn> App &add_startup_system(Fn &&fn, SystemConfig config = {}) {
+    return add_system(ScheduleLabel::Startup, std::forward<Fn>(fn), std::move(config));
+  }
+
+  // 注册事件类型：插入 Events<T> 资源，每帧开始时交换其双缓冲区
+  template <typename T> App &add_event(size_t capacity = 256) {
+    if (!resources_.has<Events<T>>()) {
+      resources_.insert<Events<T>>(capacity);
+      event_updaters_.push_back([](Resources &res) { res.get<Events<T>>()->update(); });
+    }
+    return *this;
+  }
+
+  // 创建 Owned... 的拥有型分组并缓存句柄，供 Group<...> 参数和旧式系统（owning_group）使用；
+  // 在插件 build 中调用，热点渲染查询因此遍历紧密排列的组件数组
+  template <typename... Owned> App &add_group() {
+    owning_group<Owned...>(resources_, world_);
+    return *this;
+  }
+
+  // 在内存报告中统计这些组件的组件数组大小和 HeapSize
+  template <typename... Ts> App &track_memory() {
+    if (auto *tracker = resources_.get<MemoryTracker>()) (tracker->track<Ts>(), ...);
+    return *this;
+  }
+
+  // 批量创建 count 个实体：原型值复制给每个实体，per_entity(values) 为每个实体各自的值。
+  // 在启动之前或帧之间调用；系统中使用 Commands::spawn_batch
+  template <typename... Args>
+  std::vector<entt::entity> spawn_batch(size_t count, const Args &...args) {
+    return ::spawn_batch(resources_, world_, count, args...);
   }
 
   // 插入资源
@@ -101,38 +238,66 @@ public:
 
   // 传统运行模式（保持向后兼容）
   void run() {
-    std::cout << "Starting application..." << std::endl;
+    log() << "Starting application..." << std::endl;
 
-    // 运行启动系统
-    schedule_.run_schedule(ScheduleLabel::Startup, resources_, world_);
+    // 冻结调度表，然后运行启动系统
+    schedule_.freeze(resources_, world_);
+    run_startup();
     initialized_ = true;
 
     // 主循环
     while (running_) {
-      schedule_.run_schedule(ScheduleLabel::PreUpdate, resources_, world_);
-      schedule_.run_schedule(ScheduleLabel::Update, resources_, world_);
-      schedule_.run_schedule(ScheduleLabel::PostUpdate, resources_, world_);
-      schedule_.run_schedule(ScheduleLabel::Render, resources_, world_);
-      schedule_.run_schedule(ScheduleLabel::Cleanup, resources_, world_);
+      run_frame();
     }
 
     // --- Application Shutdown ---
-    std::cout << "Application shutting down..." << std::endl;
-    schedule_.run_schedule(ScheduleLabel::Shutdown, resources_, world_);
+    log() << "Application shutting down..." << std::endl;
+    run_stage(ScheduleLabel::Shutdown);
+    if (frame_stats_) frame_stats_->report(log());
 
-    std::cout << "Application finished." << std::endl;
+    log() << "Application finished." << std::endl;
+  }
+
+  // 基准运行模式：不限帧率地运行 frames 帧（或直到 exit()），关闭时输出帧统计。
+  // frame_delta > 0 时每帧让 Time 前进固定的秒数而不读取时钟，模拟结果与机器速度无关；
+  // 为 0 时使用实测帧间隔。通常配合 set_run_mode(RunMode::Headless) 使用。
+  const FrameStats &run_frames(uint64_t frames, double frame_delta = 0.0) {
+    if (!frame_stats_) resources_.insert<FrameStats>();
+    frame_stats_->clear();
+    frame_stats_->reserve(frames);
+
+    initialize(0, nullptr);
+    for (uint64_t i = 0; i < frames; ++i) {
+      if (!step(frame_delta)) break;
+    }
+    shutdown();
+    return *frame_stats_;
+  }
+
+  // 运行一帧；frame_delta > 0 时 Time 前进固定的秒数，为 0 时读取时钟。
+  // 需要先 initialize()，返回之后是否仍在运行
+  bool step(double frame_delta = 0.0) {
+    if (!initialized_ || !running_) return false;
+    if (frame_delta > 0.0) {
+      if (auto *time = resources_.get<Time>()) time->advance(frame_delta);
+      run_frame(false);
+    } else {
+      run_frame();
+    }
+    return running_;
   }
 
   // SDL3 Callback 模式支持
 
   // 初始化应用（对应 SDL_AppInit）
-  bool initialize(int argc, char **argv) {
+  bool initialize(int /*argc*/, char ** /*argv*/) {
     if (initialized_) return true;
 
-    std::cout << "Initializing SDL3 application..." << std::endl;
+    log() << "Initializing SDL3 application..." << std::endl;
 
-    // 运行启动系统
-    schedule_.run_schedule(ScheduleLabel::Startup, resources_, world_);
+    // 冻结调度表，然后运行启动系统
+    schedule_.freeze(resources_, world_);
+    run_startup();
     initialized_ = true;
 
     return true;
@@ -143,20 +308,15 @@ public:
     if (!initialized_ || !running_) return false;
 
     // 运行一帧的系统调度
-    schedule_.run_schedule(ScheduleLabel::PreUpdate, resources_, world_);
-    schedule_.run_schedule(ScheduleLabel::Update, resources_, world_);
-    schedule_.run_schedule(ScheduleLabel::PostUpdate, resources_, world_);
-    schedule_.run_schedule(ScheduleLabel::Render, resources_, world_);
-    schedule_.run_schedule(ScheduleLabel::Cleanup, resources_, world_);
+    run_frame();
 
     return running_;
   }
 
-  // 处理事件（对应 SDL_AppEvent）
+  // 立即运行一次 Event 阶段。
+  // 事件通常写入 Events<T>，由每帧开始时的 Event 阶段统一处理；SDL_AppEvent 不再逐个事件调用此函数
   bool handle_event() {
-    // 这里可以添加事件处理逻辑
-    // 具体的事件处理可以通过系统或插件来实现
-    schedule_.run_schedule(ScheduleLabel::Event, resources_, world_);
+    run_stage(ScheduleLabel::Event);
     return running_;
   }
 
@@ -164,15 +324,93 @@ public:
   void shutdown() {
     if (!initialized_) return;
 
-    std::cout << "SDL3 application shutting down..." << std::endl;
-    schedule_.run_schedule(ScheduleLabel::Shutdown, resources_, world_);
+    log() << "SDL3 application shutting down..." << std::endl;
+    run_stage(ScheduleLabel::Shutdown);
+    if (frame_stats_) frame_stats_->report(log());
+
+    log() << "SDL3 application finished." << std::endl;
+  }
 
-    std::cout << "SDL3 application finished." << std::endl;
+  // 运行 Startup 阶段并记录启动时间线（各系统起止时间与关键路径），结果存为 StartupTimeline 资源
+  void run_startup() {
+    schedule_.set_timed(ScheduleLabel::Startup, true);
+    const uint64_t start = Schedule::clock_ns();
+    run_stage(ScheduleLabel::Startup);
+    const uint64_t end = Schedule::clock_ns();
+    schedule_.set_timed(ScheduleLabel::Startup, false);
+
+    auto &timeline = resources_.insert<StartupTimeline>(
+        StartupTimeline::build(schedule_, start, end, std::this_thread::get_id()));
+    timeline.launch_ms = static_cast<double>(end - created_ns_) / 1.0e6;
+    timeline.report(log());
+  }
+
+  // 一帧：更新时间，交换事件缓冲区并运行一次 Event 阶段，
+  // PreUpdate 之后按累加器运行 0..N 次 FixedUpdate，再运行其余阶段，最后重置帧内存池。
+  // 本帧有系统发送了 AppExit 时停止运行
+  void run_frame(bool update_time = true) {
+    auto &profiler = Profiler::instance();
+    if (profile_frames_ && profiler.enabled()) profiler.mark_frame();
+    if (frame_stats_) frame_stats_->begin_frame();
+    auto *time = resources_.get<Time>();
+    if (time && update_time) time->update();
+
+    for (auto update : event_updaters_) update(resources_);
+    run_stage(ScheduleLabel::Event);
+    run_stage(ScheduleLabel::PreUpdate);
+    if (time) {
+      while (time->consume_fixed_step()) {
+        run_stage(ScheduleLabel::FixedUpdate);
+      }
+    }
+    run_stage(ScheduleLabel::Update);
+    run_stage(ScheduleLabel::PostUpdate);
+    run_stage(ScheduleLabel::Render);
+    run_stage(ScheduleLabel::Cleanup);
+    if (app_exit_ && !app_exit_->empty()) running_ = false;
+    if (frame_arena_) frame_arena_->reset();
+    trim_change_history();
+    if (frame_stats_) frame_stats_->end_frame();
+    if (profile_frames_) profiler.flush_pending_dump();
+
+    if (!first_frame_done_) {
+      first_frame_done_ = true;
+      const double ms = static_cast<double>(Schedule::clock_ns() - created_ns_) / 1.0e6;
+      if (auto *timeline = resources_.get<StartupTimeline>()) timeline->first_frame_ms = ms;
+      log() << "Cold start to first frame: " << ms << " ms" << std::endl;
+    }
+  }
+
+  // 运行一个阶段，然后在阶段边界统一应用该阶段记录的延迟命令
+  void run_stage(ScheduleLabel label) {
+    const bool timed = static_cast<bool>(frame_stats_);
+    const auto start = timed ? FrameStats::Clock::now() : FrameStats::Clock::time_point{};
+
+    schedule_.run_schedule(label, resources_, world_);
+    if (auto *commands = resources_.get<CommandQueue>()) {
+      commands->apply(world_);
+    }
+
+    if (timed) frame_stats_->record_stage(label, FrameStats::Clock::now() - start);
+  }
+
+  // 丢弃所有读取者都已看过的变更记录；超过 max_change_age 帧的记录无论是否看过都丢弃
+  void trim_change_history() {
+    if (auto *detection = resources_.get<ChangeDetection>()) {
+      schedule_.expire_change_ticks(detection->end_frame());
+      detection->trim(schedule_.oldest_change_reader_tick());
+    }
   }
 
   // 检查应用是否正在运行
   bool is_running() const { return running_; }
 
+  // set_log_stream 设置的输出流；未设置输出时返回一个丢弃一切的流
+  std::ostream &log() {
+    static thread_local std::ostream null_stream(nullptr);
+    return log_ ? *log_ : null_stream;
+  }
+
   // 检查应用是否已初始化
   bool is_initialized() const { return initialized_; }
 };
\ No newline at end of file
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "App.h"
+#include "TaskPool.h"
+
+// =============================================================================
+// 批量运行多个互相独立的世界
+//
+// 每个世界是一个完整的 App：自己的 registry、资源、调度表、事件和时间，彼此不共享状态。
+// BatchRunner 把所有世界的一帧作为一批任务分给同一个线程池，K 个世界在多个核心上并行步进：
+//
+//   BatchRunner batch(BatchConfig{64}, [&](App &app, size_t index) {
+//     app.add_plugin<ScenarioPlugin>(scenarios[index]);
+//   });
+//   batch.run(600);  // 每个世界最多 600 帧，全部退出（AppExit）时提前结束
+//   for (size_t i = 0; i < batch.size(); ++i) collect(*batch.world(i).resource<ScenarioResult>());
+//
+// 世界以 Headless 模式创建，不带 TaskPool 资源：世界内的各阶段在分到的线程上顺序执行，
+// 并行度来自世界之间，不会为每个世界再创建一组工作线程。
+// 每个世界的 App 输出和在其线程上写出的 VividLogger 日志分别缓存，每帧结束后按世界顺序
+// 加上 "[world i]" 前缀写入 BatchConfig::log，多个世界的日志不会交错。
+// 性能分析器是进程级的，由 BatchRunner 而不是各个世界标记帧。
+// =============================================================================
+
+struct BatchConfig {
+  size_t worlds = 1;
+  double frame_delta = 1.0 / 60.0;  // 每帧固定步长（秒），结果与调度无关；0 使用实测帧间隔
+  size_t threads = 0;               // 工作线程数，0 为 hardware_concurrency - 1（调用线程也参与）
+  std::ostream *log = &std::cout;   // 汇总日志的输出，nullptr 表示丢弃
+};
+
+class BatchRunner {
+public:
+  // 配置第 index 个世界：添加插件、系统和资源；在调用线程上按顺序调用
+  using Setup = std::function<void(App &app, size_t index)>;
+
+  BatchRunner(BatchConfig config, const Setup &setup);
+  ~BatchRunner();
+
+  BatchRunner(const BatchRunner &) = delete;
+  BatchRunner &operator=(const BatchRunner &) = delete;
+
+  size_t size() const { return worlds_.size(); }
+  App &world(size_t index) { return worlds_[index]->app; }
+
+  // 第 index 个世界是否仍在运行（未退出、未出错）
+  bool running(size_t index) const { return !worlds_[index]->done; }
+  size_t running_count() const;
+
+  // 第 index 个世界已运行的帧数
+  uint64_t frames(size_t index) const { return worlds_[index]->frames; }
+
+  // 第 index 个世界抛出的异常信息；出错的世界停止运行，不影响其他世界
+  const std::string &error(size_t index) const { return worlds_[index]->error; }
+
+  // 并行运行所有世界的 Startup 阶段
+  void initialize();
+
+  // 所有仍在运行的世界各运行一帧，返回之后是否还有世界在运行
+  bool step();
+
+  // initialize，然后最多 frames 帧（或直到全部退出），最后 shutdown；返回运行的批次帧数
+  uint64_t run(uint64_t frames);
+
+  // 并行运行所有世界的 Shutdown 阶段；析构时会自动调用
+  void shutdown();
+
+private:
+  struct World {
+    App app;
+    std::ostringstream log;
+    uint64_t frames = 0;
+    bool done = false;
+    std::string error;
+  };
+
+  // 在线程池上对每个世界并行执行 fn(world)，期间该线程的日志写入世界自己的缓存
+  void for_each_world(bool running_only, void (*fn)(World &world, double frame_delta));
+
+  // 按世界顺序把缓存的日志写入 config_.log
+  void flush_logs();
+
+  BatchConfig config_;
+  TaskPool pool_;
+  std::vector<std::unique_ptr<World>> worlds_;
+  bool initialized_ = false;
+  bool shut_down_ = false;
+};
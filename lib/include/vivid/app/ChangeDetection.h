@@ -0,0 +1,262 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <entt/entt.hpp>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+#include "Resources.h"
+
+// =============================================================================
+// 变更检测
+//
+// ChangeDetection 资源维护一个单调递增的 tick，调度器在每个系统运行前后各推进一次，
+// 系统元数据（SystemMeta::last_run_tick）记录它上次运行时的 tick。
+// ComponentTracker<T> 监听 entt 的 on_construct / on_update / on_destroy 信号，
+// 记录组件 T 在哪个 tick 被添加、修改、移除；Added<T> / Changed<T> / Removed<T>
+// 据此只访问自系统上次运行以来被触碰过的实体，any_added<T>() 等运行条件据此跳过整个系统。
+//
+// 变更历史最多保留 max_change_age 帧：超过这么多帧仍未运行的读取者（例如 run_if 一直不满足）
+// 只能看到最近这些帧的变更，历史记录因此不会无限增长。
+//
+// 注意：on_update 只在 registry.patch / replace / emplace_or_replace 时触发，
+// 直接通过引用修改组件不会被记录为 Changed。
+// 同一组件类型的 patch 不能在系统内部的 parallel_for 中并发调用。
+// =============================================================================
+
+// 带 tick 的实体记录
+struct TickedEntity {
+  entt::entity entity;
+  uint64_t tick;
+};
+
+class ComponentTrackerBase {
+public:
+  virtual ~ComponentTrackerBase() = default;
+
+  // 丢弃 tick 不大于 oldest 的历史记录（所有读取者都已经看过）
+  virtual void trim(uint64_t oldest) = 0;
+};
+
+// 全局变更 tick 以及所有组件追踪器
+class ChangeDetection {
+public:
+  static constexpr size_t kDefaultMaxChangeAge = 1024;  // 帧
+
+private:
+  // 从 1 开始：尚未运行过的系统 last_run_tick 为 0，能看到此前的所有变更
+  std::atomic<uint64_t> tick_{1};
+  std::vector<ComponentTrackerBase *> trackers_;
+
+  // 最近 max_change_age 帧结束时的 tick，环形缓冲区
+  std::vector<uint64_t> frame_ticks_ = std::vector<uint64_t>(kDefaultMaxChangeAge, 0);
+  size_t frame_ = 0;
+
+public:
+  ChangeDetection() = default;
+  ChangeDetection(const ChangeDetection &) = delete;
+  ChangeDetection &operator=(const ChangeDetection &) = delete;
+
+  uint64_t tick() const { return tick_.load(std::memory_order_acquire); }
+
+  // 推进 tick，返回新值
+  uint64_t advance() { return tick_.fetch_add(1, std::memory_order_acq_rel) + 1; }
+
+  // 变更历史最多保留的帧数，至少为 1
+  void set_max_change_age(size_t frames) {
+    frame_ticks_.assign(std::max<size_t>(frames, 1), 0);
+    frame_ = 0;
+  }
+
+  size_t max_change_age() const { return frame_ticks_.size(); }
+
+  // 记录一帧结束，返回 max_change_age 帧之前结束时的 tick（不足这么多帧时为 0），
+  // 不晚于它的变更不再保留
+  uint64_t end_frame() {
+    auto &slot = frame_ticks_[frame_];
+    frame_ = (frame_ + 1) % frame_ticks_.size();
+    const uint64_t expired = slot;
+    slot = tick();
+    return expired;
+  }
+
+  void add_tracker(ComponentTrackerBase *tracker) { trackers_.push_back(tracker); }
+
+  void remove_tracker(ComponentTrackerBase *tracker) {
+    trackers_.erase(std::remove(trackers_.begin(), trackers_.end(), tracker), trackers_.end());
+  }
+
+  void trim(uint64_t oldest) {
+    for (auto *tracker : trackers_) {
+      tracker->trim(oldest);
+    }
+  }
+};
+
+// 单个组件类型的变更记录，作为资源存放在 Resources 中
+template <typename T> class ComponentTracker final : public ComponentTrackerBase {
+private:
+  struct Ticks {
+    uint64_t added;
+    uint64_t changed;
+  };
+
+  ChangeDetection *detection_;
+  entt::registry *registry_;
+
+  entt::storage<Ticks> ticks_;
+  std::vector<TickedEntity> added_;
+  std::vector<TickedEntity> changed_;
+  std::vector<TickedEntity> removed_;
+
+  uint64_t last_added_ = 0;
+  uint64_t last_changed_ = 0;
+  uint64_t last_removed_ = 0;
+
+  // 日志按 tick 单调递增，二分查找第一条 tick > since 的记录
+  static std::vector<TickedEntity>::const_iterator first_after(
+      const std::vector<TickedEntity> &log, uint64_t since) {
+    return std::upper_bound(
+        log.begin(), log.end(), since,
+        [](uint64_t value, const TickedEntity &entry) { return value < entry.tick; });
+  }
+
+  static void trim_log(std::vector<TickedEntity> &log, uint64_t oldest) {
+    log.erase(log.begin(), first_after(log, oldest));
+  }
+
+  void on_construct(entt::registry &, entt::entity entity) {
+    const uint64_t tick = detection_->tick();
+    if (ticks_.contains(entity)) {
+      ticks_.get(entity) = Ticks{tick, tick};
+    } else {
+      ticks_.emplace(entity, Ticks{tick, tick});
+    }
+    added_.push_back(TickedEntity{entity, tick});
+    changed_.push_back(TickedEntity{entity, tick});
+    last_added_ = last_changed_ = tick;
+  }
+
+  void on_update(entt::registry &, entt::entity entity) {
+    const uint64_t tick = detection_->tick();
+    if (!ticks_.contains(entity)) {
+      ticks_.emplace(entity, Ticks{tick, tick});
+    } else if (ticks_.get(entity).changed == tick) {
+      return;  // 同一个 tick 内已经记录过
+    } else {
+      ticks_.get(entity).changed = tick;
+    }
+    changed_.push_back(TickedEntity{entity, tick});
+    last_changed_ = tick;
+  }
+
+  void on_destroy(entt::registry &, entt::entity entity) {
+    const uint64_t tick = detection_->tick();
+    ticks_.remove(entity);
+    removed_.push_back(TickedEntity{entity, tick});
+    last_removed_ = tick;
+  }
+
+public:
+  ComponentTracker(ChangeDetection &detection, entt::registry &registry)
+      : detection_(&detection), registry_(&registry) {
+    registry.on_construct<T>().template connect<&ComponentTracker::on_construct>(*this);
+    registry.on_update<T>().template connect<&ComponentTracker::on_update>(*this);
+    registry.on_destroy<T>().template connect<&ComponentTracker::on_destroy>(*this);
+    detection.add_tracker(this);
+  }
+
+  ~ComponentTracker() override {
+    registry_->on_construct<T>().template disconnect<&ComponentTracker::on_construct>(*this);
+    registry_->on_update<T>().template disconnect<&ComponentTracker::on_update>(*this);
+    registry_->on_destroy<T>().template disconnect<&ComponentTracker::on_destroy>(*this);
+    detection_->remove_tracker(this);
+  }
+
+  ComponentTracker(const ComponentTracker &) = delete;
+  ComponentTracker &operator=(const ComponentTracker &) = delete;
+
+  // 批量添加（spawn_batch）：begin_batch 暂停逐个实体的 on_construct 记录，
+  // end_batch 恢复监听并一次记录 [first, last) 中新添加的实体。范围内的实体之前不能有组件 T
+  void begin_batch() {
+    registry_->on_construct<T>().template disconnect<&ComponentTracker::on_construct>(*this);
+  }
+
+  template <typename It> void end_batch(It first, It last) {
+    registry_->on_construct<T>().template connect<&ComponentTracker::on_construct>(*this);
+    if (first == last) return;
+
+    const uint64_t tick = detection_->tick();
+    const auto count = static_cast<size_t>(std::distance(first, last));
+    ticks_.reserve(ticks_.size() + count);
+    ticks_.insert(first, last, Ticks{tick, tick});
+    added_.reserve(added_.size() + count);
+    changed_.reserve(changed_.size() + count);
+    for (auto it = first; it != last; ++it) {
+      added_.push_back(TickedEntity{*it, tick});
+      changed_.push_back(TickedEntity{*it, tick});
+    }
+    last_added_ = last_changed_ = tick;
+  }
+
+  // 变更日志中的记录总数
+  size_t history_size() const { return added_.size() + changed_.size() + removed_.size(); }
+
+  uint64_t last_added() const { return last_added_; }
+  uint64_t last_changed() const { return last_changed_; }
+  uint64_t last_removed() const { return last_removed_; }
+
+  bool added_since(entt::entity entity, uint64_t since) const {
+    return ticks_.contains(entity) && ticks_.get(entity).added > since;
+  }
+
+  bool changed_since(entt::entity entity, uint64_t since) const {
+    return ticks_.contains(entity) && ticks_.get(entity).changed > since;
+  }
+
+  // 遍历 since 之后添加的实体，每个实体只访问一次
+  template <typename Fn> void each_added(uint64_t since, Fn &&fn) const {
+    for (auto it = first_after(added_, since); it != added_.end(); ++it) {
+      if (ticks_.contains(it->entity) && ticks_.get(it->entity).added == it->tick) fn(it->entity);
+    }
+  }
+
+  // 遍历 since 之后添加或修改的实体，每个实体只访问一次
+  template <typename Fn> void each_changed(uint64_t since, Fn &&fn) const {
+    for (auto it = first_after(changed_, since); it != changed_.end(); ++it) {
+      if (ticks_.contains(it->entity) && ticks_.get(it->entity).changed == it->tick) {
+        fn(it->entity);
+      }
+    }
+  }
+
+  // 遍历 since 之后移除了组件 T 的实体（实体本身可能已被销毁）
+  template <typename Fn> void each_removed(uint64_t since, Fn &&fn) const {
+    for (auto it = first_after(removed_, since); it != removed_.end(); ++it) {
+      fn(it->entity);
+    }
+  }
+
+  void trim(uint64_t oldest) override {
+    trim_log(added_, oldest);
+    trim_log(changed_, oldest);
+    trim_log(removed_, oldest);
+  }
+};
+
+// 为组件 T 创建追踪器（已存在时什么也不做）。需要在组件被修改之前、于主线程上调用；
+// 调度器在冻结调度表时为声明了 Added / Changed / Removed 的系统自动调用。
+template <typename T> ComponentTracker<T> *track_changes(Resources &resources,
+                                                        entt::registry &registry) {
+  if (auto *tracker = resources.get<ComponentTracker<T>>()) return tracker;
+  auto *detection = resources.get<ChangeDetection>();
+  if (!detection) return nullptr;
+  return &resources.insert<ComponentTracker<T>>(*detection, registry);
+}
+
+// 保留给“从未有读取者”的情况：丢弃全部历史
+inline constexpr uint64_t kNoChangeReaders = std::numeric_limits<uint64_t>::max();
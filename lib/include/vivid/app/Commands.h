@@ -0,0 +1,376 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <entt/entt.hpp>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Resources.h"
+#include "SpawnBatch.h"
+#include "SystemParam.h"
+
+// =============================================================================
+// 延迟命令（Commands）
+//
+// 系统在运行期间不直接对注册表做结构性修改（创建/销毁实体、添加/移除组件），
+// 而是把命令记录到当前线程的命令缓冲区中；App 在每个阶段结束时统一应用：
+//
+//   void spawn_system(Commands commands, Query<const SpawnerComponent> spawners) {
+//     spawners.each([&](const SpawnerComponent &spawner) {
+//       commands.spawn().insert<TransformComponent>(spawner.position).insert<MeshComponent>();
+//     });
+//   }
+//
+// 每个线程各自一块缓冲区，记录时不需要加锁，互不冲突的系统可以继续并行执行。
+// 应用时按组件类型分组：同一类型的所有插入先一次性预留存储，再依次写入。
+// 同一阶段内的应用顺序固定为：创建实体 → 插入组件 → 移除组件 → 自定义命令 → 销毁实体。
+// 同一线程对同一实体、同一组件的插入和移除按记录顺序生效，后记录的为准：
+// remove<T>(e); insert<T>(e, v) 之后 e 上有 T。
+// =============================================================================
+
+// 命令目标：已有实体，或本缓冲区中第 pending 个待创建的实体
+struct CommandTarget {
+  static constexpr uint32_t kExisting = UINT32_MAX;
+
+  entt::entity entity = entt::null;
+  uint32_t pending = kExisting;
+
+  entt::entity resolve(const std::vector<entt::entity> &spawned) const {
+    return pending == kExisting ? entity : spawned[pending];
+  }
+};
+
+namespace vivid_detail {
+
+  class ComponentCommandsBase {
+  public:
+    virtual ~ComponentCommandsBase() = default;
+
+    // 本轮是否已经登记到缓冲区的类型列表中
+    bool queued = false;
+
+    virtual size_t insert_count() const = 0;
+    virtual void reserve(entt::registry &registry, size_t additional) = 0;
+    virtual void apply_inserts(entt::registry &registry,
+                               const std::vector<entt::entity> &spawned)
+        = 0;
+    virtual void apply_removes(entt::registry &registry,
+                               const std::vector<entt::entity> &spawned)
+        = 0;
+    virtual void clear() = 0;
+  };
+
+  // 单个组件类型的插入/移除命令；sequence 为缓冲区内的记录序号，从 1 开始
+  template <typename T> class ComponentCommands final : public ComponentCommandsBase {
+  public:
+    struct Insert {
+      CommandTarget target;
+      uint32_t sequence;
+      T value;
+    };
+
+    struct Remove {
+      CommandTarget target;
+      uint32_t sequence;
+    };
+
+    std::vector<Insert> inserts;
+    std::vector<Remove> removes;
+
+    size_t insert_count() const override { return inserts.size(); }
+
+    void reserve(entt::registry &registry, size_t additional) override {
+      auto &storage = registry.storage<T>();
+      storage.reserve(storage.size() + additional);
+    }
+
+    void apply_inserts(entt::registry &registry,
+                       const std::vector<entt::entity> &spawned) override {
+      for (auto &insert : inserts) {
+        const auto entity = insert.target.resolve(spawned);
+        if (!registry.valid(entity)) continue;
+        registry.emplace_or_replace<T>(entity, std::move(insert.value));
+      }
+    }
+
+    // 插入已经全部应用，跳过记录在同一实体最后一次插入之前的移除
+    void apply_removes(entt::registry &registry,
+                       const std::vector<entt::entity> &spawned) override {
+      if (removes.empty()) return;
+      last_insert_.clear();
+      for (const auto &insert : inserts) {
+        auto &last = last_insert_[insert.target.resolve(spawned)];
+        last = std::max(last, insert.sequence);
+      }
+      for (const auto &remove : removes) {
+        const auto entity = remove.target.resolve(spawned);
+        if (!registry.valid(entity)) continue;
+        auto it = last_insert_.find(entity);
+        if (it != last_insert_.end() && it->second > remove.sequence) continue;
+        registry.remove<T>(entity);
+      }
+    }
+
+    void clear() override {
+      inserts.clear();
+      removes.clear();
+      queued = false;
+    }
+
+  private:
+    std::unordered_map<entt::entity, uint32_t> last_insert_;  // 实体 -> 最后一次插入的序号
+  };
+
+}  // namespace vivid_detail
+
+// 单个线程的命令缓冲区
+class CommandBuffer {
+private:
+  friend class CommandQueue;
+
+  uint32_t spawn_count_ = 0;
+  uint32_t sequence_ = 0;  // 插入/移除的记录序号
+  std::vector<entt::entity> spawned_;
+  std::vector<CommandTarget> despawns_;
+  std::vector<std::function<void(entt::registry &)>> custom_;
+
+  // 按组件类型分组，跨帧复用；types_ 为本轮用到的类型，保持首次出现的顺序，保证应用顺序确定
+  std::unordered_map<entt::id_type, std::unique_ptr<vivid_detail::ComponentCommandsBase>> batches_;
+  std::vector<entt::id_type> types_;
+
+  template <typename T> vivid_detail::ComponentCommands<T> &batch() {
+    const auto id = entt::type_hash<T>::value();
+    auto &slot = batches_[id];
+    if (!slot) slot = std::make_unique<vivid_detail::ComponentCommands<T>>();
+    if (!slot->queued) {
+      slot->queued = true;
+      types_.push_back(id);
+    }
+    return static_cast<vivid_detail::ComponentCommands<T> &>(*slot);
+  }
+
+public:
+  CommandTarget spawn() { return CommandTarget{entt::null, spawn_count_++}; }
+
+  template <typename T, typename... Args> void insert(CommandTarget target, Args &&...args) {
+    auto &commands = batch<T>();
+    if constexpr (std::is_aggregate_v<T>) {
+      commands.inserts.push_back({target, ++sequence_, T{std::forward<Args>(args)...}});
+    } else {
+      commands.inserts.push_back({target, ++sequence_, T(std::forward<Args>(args)...)});
+    }
+  }
+
+  template <typename T> void remove(CommandTarget target) {
+    batch<T>().removes.push_back({target, ++sequence_});
+  }
+
+  void despawn(CommandTarget target) { despawns_.push_back(target); }
+
+  void add(std::function<void(entt::registry &)> command) { custom_.push_back(std::move(command)); }
+};
+
+namespace vivid_detail {
+
+  // 线程上次使用的命令缓冲区；用全局递增的编号而不是地址识别 CommandQueue，避免地址复用后误命中
+  struct CommandQueueCache {
+    uint64_t owner = 0;
+    CommandBuffer *buffer = nullptr;
+  };
+
+  inline thread_local CommandQueueCache command_queue_cache;
+
+}  // namespace vivid_detail
+
+// 所有线程的命令缓冲区，作为资源由 App 持有
+class CommandQueue {
+private:
+  struct ThreadBuffer {
+    std::thread::id thread;
+    std::unique_ptr<CommandBuffer> buffer;
+  };
+
+  static inline std::atomic<uint64_t> next_id_{1};
+
+  const uint64_t id_ = next_id_.fetch_add(1, std::memory_order_relaxed);
+  std::mutex mutex_;
+  std::vector<ThreadBuffer> buffers_;
+
+public:
+  CommandQueue() = default;
+  CommandQueue(const CommandQueue &) = delete;
+  CommandQueue &operator=(const CommandQueue &) = delete;
+
+  // 当前线程的缓冲区，第一次使用时创建
+  CommandBuffer &local() {
+    auto &cache = vivid_detail::command_queue_cache;
+    if (cache.owner == id_) return *cache.buffer;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto thread = std::this_thread::get_id();
+    auto it = std::find_if(buffers_.begin(), buffers_.end(),
+                           [&](const ThreadBuffer &entry) { return entry.thread == thread; });
+    if (it == buffers_.end()) {
+      buffers_.push_back(ThreadBuffer{thread, std::make_unique<CommandBuffer>()});
+      it = buffers_.end() - 1;
+    }
+    cache = vivid_detail::CommandQueueCache{id_, it->buffer.get()};
+    return *it->buffer;
+  }
+
+  // 在主线程上、没有系统运行时调用
+  void apply(entt::registry &registry) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // 1. 创建实体
+    bool any = false;
+    for (auto &[thread, buffer] : buffers_) {
+      buffer->spawned_.resize(buffer->spawn_count_);
+      if (buffer->spawn_count_ != 0) {
+        registry.create(buffer->spawned_.begin(), buffer->spawned_.end());
+        any = true;
+      }
+      any = any || !buffer->types_.empty() || !buffer->despawns_.empty()
+            || !buffer->custom_.empty();
+    }
+    if (!any) return;
+
+    // 2. 按组件类型分组：先为所有缓冲区中同类型的插入一次性预留存储
+    std::unordered_map<entt::id_type,
+                       std::vector<std::pair<vivid_detail::ComponentCommandsBase *, CommandBuffer *>>>
+        groups;
+    std::vector<entt::id_type> order;
+    for (auto &[thread, buffer] : buffers_) {
+      for (auto id : buffer->types_) {
+        auto &group = groups[id];
+        if (group.empty()) order.push_back(id);
+        group.emplace_back(buffer->batches_[id].get(), buffer.get());
+      }
+    }
+
+    for (auto id : order) {
+      auto &group = groups[id];
+      size_t total = 0;
+      for (auto &[batch, buffer] : group) total += batch->insert_count();
+      if (total == 0) continue;
+      group.front().first->reserve(registry, total);
+      for (auto &[batch, buffer] : group) batch->apply_inserts(registry, buffer->spawned_);
+    }
+
+    // 3. 移除组件
+    for (auto id : order) {
+      for (auto &[batch, buffer] : groups[id]) batch->apply_removes(registry, buffer->spawned_);
+    }
+
+    // 4. 自定义命令、5. 销毁实体
+    for (auto &[thread, buffer] : buffers_) {
+      for (auto &command : buffer->custom_) command(registry);
+    }
+    for (auto &[thread, buffer] : buffers_) {
+      for (const auto &target : buffer->despawns_) {
+        const auto entity = target.resolve(buffer->spawned_);
+        if (registry.valid(entity)) registry.destroy(entity);
+      }
+    }
+
+    // 清空但保留容量，下一帧复用
+    for (auto &[thread, buffer] : buffers_) {
+      buffer->spawn_count_ = 0;
+      buffer->sequence_ = 0;
+      buffer->spawned_.clear();
+      buffer->despawns_.clear();
+      buffer->custom_.clear();
+      for (auto id : buffer->types_) buffer->batches_[id]->clear();
+      buffer->types_.clear();
+    }
+  }
+};
+
+// 针对单个实体的命令构建器，只能在创建它的线程上使用
+class EntityCommands {
+private:
+  CommandBuffer *buffer_;
+  CommandTarget target_;
+
+public:
+  EntityCommands(CommandBuffer &buffer, CommandTarget target) : buffer_(&buffer), target_(target) {}
+
+  template <typename T, typename... Args> EntityCommands &insert(Args &&...args) {
+    buffer_->insert<T>(target_, std::forward<Args>(args)...);
+    return *this;
+  }
+
+  template <typename T> EntityCommands &remove() {
+    buffer_->remove<T>(target_);
+    return *this;
+  }
+
+  void despawn() { buffer_->despawn(target_); }
+};
+
+// 系统参数：延迟命令
+class Commands {
+private:
+  CommandQueue *queue_;
+  Resources *resources_ = nullptr;  // 批量创建时用于找到变更追踪器
+
+public:
+  explicit Commands(CommandQueue &queue) : queue_(&queue) {}
+
+  // 旧式 (Resources&, entt::registry&) 系统中使用
+  explicit Commands(Resources &resources)
+      : queue_(resources.get<CommandQueue>()), resources_(&resources) {}
+
+  // 创建实体；实体在阶段结束时才真正创建
+  EntityCommands spawn() {
+    auto &buffer = queue_->local();
+    return EntityCommands(buffer, buffer.spawn());
+  }
+
+  EntityCommands entity(entt::entity entity) {
+    return EntityCommands(queue_->local(), CommandTarget{entity, CommandTarget::kExisting});
+  }
+
+  template <typename T, typename... Args> void insert(entt::entity entity, Args &&...args) {
+    this->entity(entity).template insert<T>(std::forward<Args>(args)...);
+  }
+
+  template <typename T> void remove(entt::entity entity) {
+    this->entity(entity).template remove<T>();
+  }
+
+  void despawn(entt::entity entity) { this->entity(entity).despawn(); }
+
+  // 批量创建 count 个实体（见 SpawnBatch.h），参数按值保存到阶段结束时，与自定义命令一起应用
+  template <typename... Args> void spawn_batch(size_t count, Args &&...args) {
+    add([resources = resources_, count,
+         components = std::make_tuple(std::forward<Args>(args)...)](entt::registry &registry) {
+      std::apply(
+          [&](const auto &...values) {
+            vivid_detail::spawn_batch(resources, registry, count, values...);
+          },
+          components);
+    });
+  }
+
+  // 任意需要直接访问注册表的命令
+  void add(std::function<void(entt::registry &)> command) {
+    queue_->local().add(std::move(command));
+  }
+};
+
+// 命令只写入线程局部缓冲区，不与任何系统冲突
+template <> struct SystemParam<Commands> {
+  static void access(SystemAccess &) {}
+
+  static Commands fetch(Resources &res, entt::registry &, SystemMeta &) { return Commands(res); }
+};
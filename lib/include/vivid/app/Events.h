@@ -0,0 +1,201 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+#include "Resources.h"
+#include "SystemParam.h"
+
+// =============================================================================
+// 类型化事件（Events<T>）
+//
+// 事件在帧之间（或由系统通过 EventWriter<T>）写入，系统通过 EventReader<T> 每帧批量读取：
+//
+//   app.add_event<SDL_Event>();
+//
+//   void imgui_event_system(EventReader<SDL_Event> events, MainThread) {
+//     events.each([](const SDL_Event &event) { ImGui_ImplSDL3_ProcessEvent(&event); });
+//   }
+//
+// 双缓冲：App 在每帧开始时调用 update()，交换两块缓冲区并清空较旧的一块。
+// 事件在写入的那一帧和下一帧都可以读到，因此读取者无论排在写入者之前还是之后都不会漏掉。
+// 每个读取者各自记录读到了哪个事件编号（游标存放在系统的 Local 状态中），
+// 同一事件对同一系统只出现一次；多个读取者只读 Events<T>，可以并行执行。
+//
+// 缓冲区在构造时按 capacity 预留，正常情况下发送事件不做堆分配；超出容量时才扩容。
+// 可选的合并函数（set_coalesce）把连续的同类事件合并成一个，例如一帧内的多次鼠标移动；
+// 可选的过滤函数（set_filter）丢弃不需要的事件，例如回放录制的输入时屏蔽实时输入。
+// =============================================================================
+template <typename T> class Events {
+public:
+  // 合并函数：返回 true 表示已把 next 合并进 last，不再追加新事件
+  using CoalesceFn = bool (*)(T &last, const T &next);
+  // 过滤函数：返回 false 的事件被 send() 丢弃
+  using FilterFn = bool (*)(const T &event);
+
+private:
+  struct Buffer {
+    std::vector<T> events;
+    uint64_t start_id = 0;  // 第一个事件的编号
+  };
+
+  Buffer buffers_[2];
+  size_t current_ = 0;  // 正在写入的缓冲区
+  uint64_t next_id_ = 0;
+  CoalesceFn coalesce_ = nullptr;
+  FilterFn filter_ = nullptr;
+
+  Buffer &current() { return buffers_[current_]; }
+  const Buffer &previous() const { return buffers_[current_ ^ 1]; }
+
+public:
+  explicit Events(size_t capacity = 256) {
+    buffers_[0].events.reserve(capacity);
+    buffers_[1].events.reserve(capacity);
+  }
+
+  // 只与当前写入缓冲区的最后一个事件合并；已被读取过的事件再被合并时，读取者看不到合并的部分，
+  // 因此只适用于在帧之间发送的事件（如 SDL 输入事件）
+  void set_coalesce(CoalesceFn coalesce) { coalesce_ = coalesce; }
+
+  // 传入 nullptr 取消过滤
+  void set_filter(FilterFn filter) { filter_ = filter; }
+
+  void send(const T &event) {
+    if (filter_ && !filter_(event)) return;
+    auto &buffer = current();
+    if (coalesce_ && !buffer.events.empty() && coalesce_(buffer.events.back(), event)) return;
+    buffer.events.push_back(event);
+    ++next_id_;
+  }
+
+  void send(T &&event) {
+    if (filter_ && !filter_(event)) return;
+    auto &buffer = current();
+    if (coalesce_ && !buffer.events.empty() && coalesce_(buffer.events.back(), event)) return;
+    buffer.events.push_back(std::move(event));
+    ++next_id_;
+  }
+
+  // 原样追加事件，不经过过滤和合并（回放录制的事件时使用）
+  void inject(const T &event) {
+    current().events.push_back(event);
+    ++next_id_;
+  }
+
+  // 每帧调用一次：丢弃两帧前的事件，开始新的写入缓冲区（保留容量）
+  void update() {
+    current_ ^= 1;
+    auto &buffer = current();
+    buffer.events.clear();
+    buffer.start_id = next_id_;
+  }
+
+  // 清空全部事件，已有读取者的游标仍然有效
+  void clear() {
+    for (auto &buffer : buffers_) {
+      buffer.events.clear();
+      buffer.start_id = next_id_;
+    }
+  }
+
+  // 当前保留的事件数（两块缓冲区之和）
+  size_t size() const { return buffers_[0].events.size() + buffers_[1].events.size(); }
+  bool empty() const { return size() == 0; }
+
+  // 下一个事件的编号；新读取者从这里开始只会看到之后的事件
+  uint64_t next_id() const { return next_id_; }
+
+  // 按发送顺序遍历编号不小于 cursor 的事件，返回新的游标
+  template <typename Fn> uint64_t read(uint64_t cursor, Fn &&fn) const {
+    for (const Buffer *buffer : {&previous(), &buffers_[current_]}) {
+      const auto &events = buffer->events;
+      const uint64_t end = buffer->start_id + events.size();
+      if (cursor >= end) continue;
+      for (uint64_t id = std::max(cursor, buffer->start_id); id < end; ++id) {
+        fn(events[static_cast<size_t>(id - buffer->start_id)]);
+      }
+    }
+    return next_id_;
+  }
+
+  // 编号不小于 cursor 的事件数
+  size_t unread(uint64_t cursor) const {
+    size_t count = 0;
+    for (const Buffer *buffer : {&previous(), &buffers_[current_]}) {
+      const uint64_t end = buffer->start_id + buffer->events.size();
+      if (cursor < end) count += static_cast<size_t>(end - std::max(cursor, buffer->start_id));
+    }
+    return count;
+  }
+};
+
+namespace vivid_detail {
+
+  // EventReader 的游标，每个系统、每种事件类型一份
+  template <typename T> struct EventCursor {
+    uint64_t next = 0;
+  };
+
+}  // namespace vivid_detail
+
+// 系统参数：读取事件
+template <typename T> class EventReader {
+private:
+  const Events<T> *events_;
+  uint64_t *cursor_;
+
+public:
+  EventReader(const Events<T> *events, uint64_t *cursor) : events_(events), cursor_(cursor) {}
+
+  // 遍历本系统尚未读过的事件，并把它们标记为已读
+  template <typename Fn> void each(Fn &&fn) {
+    if (!events_) return;
+    *cursor_ = events_->read(*cursor_, std::forward<Fn>(fn));
+  }
+
+  size_t size() const { return events_ ? events_->unread(*cursor_) : 0; }
+  bool empty() const { return size() == 0; }
+
+  // 跳过所有未读事件
+  void clear() {
+    if (events_) *cursor_ = events_->next_id();
+  }
+};
+
+// 系统参数：发送事件
+template <typename T> class EventWriter {
+private:
+  Events<T> *events_;
+
+public:
+  explicit EventWriter(Events<T> *events) : events_(events) {}
+
+  void send(const T &event) {
+    if (events_) events_->send(event);
+  }
+
+  void send(T &&event) {
+    if (events_) events_->send(std::move(event));
+  }
+};
+
+template <typename T> struct SystemParam<EventReader<T>> {
+  static void access(SystemAccess &access) { access.read_resource<Events<T>>(); }
+
+  static EventReader<T> fetch(Resources &res, entt::registry &, SystemMeta &meta) {
+    auto &cursor = vivid_detail::system_local<vivid_detail::EventCursor<T>>(meta);
+    return EventReader<T>(res.get<Events<T>>(), &cursor.next);
+  }
+};
+
+template <typename T> struct SystemParam<EventWriter<T>> {
+  static void access(SystemAccess &access) { access.write_resource<Events<T>>(); }
+
+  static EventWriter<T> fetch(Resources &res, entt::registry &, SystemMeta &) {
+    return EventWriter<T>(res.get<Events<T>>());
+  }
+};
@@ -0,0 +1,277 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Resources.h"
+#include "SystemParam.h"
+
+// =============================================================================
+// 帧内存池（FrameArena）
+//
+// 系统每帧临时使用的内存从线性分配器中按指针递增分配，不逐个释放，
+// App 在 Cleanup 阶段结束后统一重置，下一帧从头复用同一块内存：
+//
+//   void collect_system(Query<const TransformComponent> q, FrameScratch scratch) {
+//     auto visible = scratch.vector<entt::entity>();  // std::pmr::vector，内存来自本帧
+//     visible.reserve(q.world().storage<TransformComponent>().size());
+//     ...
+//   }
+//
+// 旧式系统通过 frame_scratch(res) 取得 std::pmr::memory_resource*。
+// 每个线程有自己的子分配器，并行执行的系统（以及 parallel_for 的任务）互不加锁。
+// 某一帧用量超过块大小时会追加新块；重置时把多块合并为一块，之后的帧不再向系统申请内存。
+//
+// 内存在本帧 Cleanup 之后失效：不要保存到组件或资源里跨帧使用，
+// 也不要交给渲染线程（RenderThread 在下一帧仍在读取提取出的数据）。
+// =============================================================================
+
+// 单线程线性分配器；deallocate 不回收，reset() 统一释放
+class LinearArena : public std::pmr::memory_resource {
+public:
+  static constexpr size_t kBlockAlignment = 64;
+
+private:
+  struct Block {
+    std::byte *data = nullptr;
+    size_t size = 0;
+  };
+
+  std::vector<Block> blocks_;  // 最后一块为当前块
+  size_t block_size_;
+  size_t offset_ = 0;      // 当前块内已用字节
+  size_t used_ = 0;        // 之前各块已用字节之和
+  size_t high_water_ = 0;  // 单帧最大用量
+  uint64_t block_allocs_ = 0;
+
+  static std::byte *allocate_block(size_t size) {
+    return static_cast<std::byte *>(::operator new(size, std::align_val_t(kBlockAlignment)));
+  }
+
+  static void free_block(const Block &block) {
+    ::operator delete(block.data, block.size, std::align_val_t(kBlockAlignment));
+  }
+
+  void push_block(size_t size) {
+    blocks_.push_back(Block{allocate_block(size), size});
+    ++block_allocs_;
+  }
+
+protected:
+  // block 内从 offset 起满足 alignment 的位置
+  static size_t align_offset(const Block &block, size_t offset, size_t alignment) {
+    const auto base = reinterpret_cast<uintptr_t>(block.data);
+    return ((base + offset + alignment - 1) & ~(uintptr_t(alignment) - 1)) - base;
+  }
+
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    if (!blocks_.empty()) {
+      const Block &block = blocks_.back();
+      const size_t start = align_offset(block, offset_, alignment);
+      if (start + bytes <= block.size) {
+        offset_ = start + bytes;
+        return block.data + start;
+      }
+      used_ += offset_;
+    }
+
+    // 当前块放不下：追加一块，至少能容纳这次分配
+    const size_t padded = bytes + std::max(alignment, kBlockAlignment);
+    push_block(std::max(block_size_, padded));
+    const size_t start = align_offset(blocks_.back(), 0, alignment);
+    offset_ = start + bytes;
+    return blocks_.back().data + start;
+  }
+
+  void do_deallocate(void *, size_t, size_t) override {}
+
+  bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+
+public:
+  explicit LinearArena(size_t block_size = 64 * 1024) : block_size_(block_size) {}
+
+  ~LinearArena() override {
+    for (const auto &block : blocks_) free_block(block);
+  }
+
+  LinearArena(const LinearArena &) = delete;
+  LinearArena &operator=(const LinearArena &) = delete;
+
+  // 未初始化的 T[count]，只适用于可平凡析构的类型
+  template <typename T> T *allocate_array(size_t count) {
+    static_assert(std::is_trivially_destructible_v<T>, "arena memory is never destructed");
+    return static_cast<T *>(allocate(count * sizeof(T), alignof(T)));
+  }
+
+  // 值初始化的 T[count]
+  template <typename T> T *make_array(size_t count) {
+    T *values = allocate_array<T>(count);
+    std::uninitialized_value_construct_n(values, count);
+    return values;
+  }
+
+  // 释放本帧的全部分配。用了多块时合并成一块容纳全部用量，稳定后每帧只用一块、不再申请内存
+  void reset() {
+    const size_t used = bytes_used();
+    high_water_ = std::max(high_water_, used);
+    if (blocks_.size() > 1) {
+      size_t total = 0;
+      for (const auto &block : blocks_) {
+        total += block.size;
+        free_block(block);
+      }
+      blocks_.clear();
+      block_size_ = std::max(block_size_, total);
+      push_block(block_size_);
+    }
+    offset_ = 0;
+    used_ = 0;
+  }
+
+  size_t bytes_used() const { return used_ + offset_; }
+  size_t high_water() const { return std::max(high_water_, bytes_used()); }
+  size_t capacity() const {
+    size_t total = 0;
+    for (const auto &block : blocks_) total += block.size;
+    return total;
+  }
+
+  // 向系统申请内存块的累计次数，稳定状态下不再增加
+  uint64_t block_allocations() const { return block_allocs_; }
+};
+
+namespace vivid_detail {
+
+  // 线程上次使用的子分配器；用全局递增的编号而不是地址识别 FrameArena，避免地址复用后误命中
+  struct FrameArenaCache {
+    uint64_t owner = 0;
+    LinearArena *arena = nullptr;
+  };
+
+  inline thread_local FrameArenaCache frame_arena_cache;
+
+}  // namespace vivid_detail
+
+// 帧内存池资源：每个线程一个 LinearArena，App 在每帧 Cleanup 阶段之后调用 reset()
+class FrameArena {
+private:
+  struct ThreadArena {
+    std::thread::id thread;
+    std::unique_ptr<LinearArena> arena;
+  };
+
+  static inline std::atomic<uint64_t> next_id_{1};
+
+  const uint64_t id_ = next_id_.fetch_add(1, std::memory_order_relaxed);
+  size_t block_size_;
+  mutable std::mutex mutex_;
+  std::vector<ThreadArena> arenas_;
+
+public:
+  explicit FrameArena(size_t block_size = 64 * 1024) : block_size_(block_size) {}
+
+  FrameArena(const FrameArena &) = delete;
+  FrameArena &operator=(const FrameArena &) = delete;
+
+  // 当前线程的子分配器，第一次使用时创建
+  LinearArena &local() {
+    auto &cache = vivid_detail::frame_arena_cache;
+    if (cache.owner == id_) return *cache.arena;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto thread = std::this_thread::get_id();
+    auto it = std::find_if(arenas_.begin(), arenas_.end(),
+                           [&](const ThreadArena &entry) { return entry.thread == thread; });
+    if (it == arenas_.end()) {
+      arenas_.push_back(ThreadArena{thread, std::make_unique<LinearArena>(block_size_)});
+      it = arenas_.end() - 1;
+    }
+    cache = vivid_detail::FrameArenaCache{id_, it->arena.get()};
+    return *it->arena;
+  }
+
+  // 只能在没有系统运行时调用（App 在 Cleanup 阶段之后调用）
+  void reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &entry : arenas_) entry.arena->reset();
+  }
+
+  size_t bytes_used() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t total = 0;
+    for (auto &entry : arenas_) total += entry.arena->bytes_used();
+    return total;
+  }
+
+  // 全部子分配器持有的内存块大小之和
+  size_t capacity() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t total = 0;
+    for (auto &entry : arenas_) total += entry.arena->capacity();
+    return total;
+  }
+
+  uint64_t block_allocations() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t total = 0;
+    for (auto &entry : arenas_) total += entry.arena->block_allocations();
+    return total;
+  }
+};
+
+template <> struct HeapSize<FrameArena> {
+  static size_t of(const FrameArena &arena) { return arena.capacity(); }
+};
+
+// 旧式系统使用：当前线程的帧内存；没有 FrameArena 资源时退回默认的堆分配
+inline std::pmr::memory_resource *frame_scratch(Resources &res) {
+  if (auto *arena = res.get<FrameArena>()) return &arena->local();
+  return std::pmr::get_default_resource();
+}
+
+// 系统参数：本帧的临时内存。只读 FrameArena（子分配器按线程划分），不与其他系统冲突。
+// 每次调用都取当前线程的子分配器，系统内 parallel_for 的任务也可以直接使用
+class FrameScratch {
+private:
+  FrameArena *arena_;
+
+public:
+  explicit FrameScratch(FrameArena *arena) : arena_(arena) {}
+
+  std::pmr::memory_resource *resource() const {
+    if (arena_) return &arena_->local();
+    return std::pmr::get_default_resource();
+  }
+
+  template <typename T> std::pmr::vector<T> vector() const {
+    return std::pmr::vector<T>(resource());
+  }
+
+  // 值初始化的 T[count]，只适用于可平凡析构的类型；内存不单独释放，需要 FrameArena 资源
+  template <typename T> T *make_array(size_t count) const {
+    static_assert(std::is_trivially_destructible_v<T>, "arena memory is never destructed");
+    T *values = static_cast<T *>(resource()->allocate(count * sizeof(T), alignof(T)));
+    std::uninitialized_value_construct_n(values, count);
+    return values;
+  }
+};
+
+template <> struct SystemParam<FrameScratch> {
+  static void access(SystemAccess &access) { access.read_resource<FrameArena>(); }
+
+  static FrameScratch fetch(Resources &res, entt::registry &, SystemMeta &) {
+    return FrameScratch(res.get<FrameArena>());
+  }
+};
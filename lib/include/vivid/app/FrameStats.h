@@ -0,0 +1,119 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <vector>
+
+#include "Schedule.h"
+
+// =============================================================================
+// 帧统计
+//
+// 作为资源插入后，App 记录每帧耗时以及每个阶段的耗时，退出时输出汇总：
+//   min / mean / p50 / p99 / max 帧时间，各阶段的平均与最大耗时。
+// App::run_frames 会自动插入；普通 run() 中手动插入 FrameStats 也会在退出时输出。
+// 这是所有 CPU 端性能改动做回归对比的基准。
+// =============================================================================
+class FrameStats {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Summary {
+    uint64_t frames = 0;
+    double min_ms = 0.0;
+    double mean_ms = 0.0;
+    double p50_ms = 0.0;
+    double p99_ms = 0.0;
+    double max_ms = 0.0;
+  };
+
+  struct StageStats {
+    uint64_t runs = 0;
+    double total_ms = 0.0;
+    double max_ms = 0.0;
+  };
+
+private:
+  std::vector<double> frame_ms_;
+  std::array<StageStats, kScheduleLabelCount> stages_{};
+  Clock::time_point frame_start_{};
+
+  static double to_ms(Clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+  }
+
+  // 最近秩百分位数，sorted 已升序
+  static double percentile(const std::vector<double> &sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    const auto rank = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(rank, sorted.size() - 1)];
+  }
+
+public:
+  // 预留帧数，避免统计过程中重新分配
+  void reserve(size_t frames) { frame_ms_.reserve(frames); }
+
+  void begin_frame() { frame_start_ = Clock::now(); }
+  void end_frame() { frame_ms_.push_back(to_ms(Clock::now() - frame_start_)); }
+
+  void record_stage(ScheduleLabel label, Clock::duration duration) {
+    auto &stage = stages_[static_cast<size_t>(label)];
+    const double ms = to_ms(duration);
+    ++stage.runs;
+    stage.total_ms += ms;
+    stage.max_ms = std::max(stage.max_ms, ms);
+  }
+
+  void clear() {
+    frame_ms_.clear();
+    stages_ = {};
+  }
+
+  uint64_t frames() const { return frame_ms_.size(); }
+  const std::vector<double> &frame_times_ms() const { return frame_ms_; }
+  const StageStats &stage(ScheduleLabel label) const { return stages_[static_cast<size_t>(label)]; }
+
+  Summary summary() const {
+    Summary result;
+    result.frames = frame_ms_.size();
+    if (frame_ms_.empty()) return result;
+
+    std::vector<double> sorted = frame_ms_;
+    std::sort(sorted.begin(), sorted.end());
+    double total = 0.0;
+    for (double ms : sorted) total += ms;
+
+    result.min_ms = sorted.front();
+    result.max_ms = sorted.back();
+    result.mean_ms = total / static_cast<double>(sorted.size());
+    result.p50_ms = percentile(sorted, 0.50);
+    result.p99_ms = percentile(sorted, 0.99);
+    return result;
+  }
+
+  void report(std::ostream &out) const {
+    const Summary s = summary();
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+
+    out << "Frame stats (" << s.frames << " frames, ms): min " << s.min_ms << "  mean "
+        << s.mean_ms << "  p50 " << s.p50_ms << "  p99 " << s.p99_ms << "  max " << s.max_ms
+        << '\n';
+    for (size_t i = 0; i < kScheduleLabelCount; ++i) {
+      const auto &stage = stages_[i];
+      if (stage.runs == 0) continue;
+      out << "  " << std::left << std::setw(12) << schedule_label_name(static_cast<ScheduleLabel>(i))
+          << std::right << " runs " << std::setw(8) << stage.runs << "  mean " << std::setw(9)
+          << stage.total_ms / static_cast<double>(stage.runs) << "  max " << std::setw(9)
+          << stage.max_ms << "  total " << stage.total_ms << '\n';
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+  }
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// =============================================================================
+// 堆内存大小特征（HeapSize）
+//
+// 一个值通过自己持有的容器间接占用的堆内存（不含 sizeof(T) 本身），供内存报告统计。
+// 默认为 0；std::vector / std::string 已有特化，含容器的组件或资源可以特化 HeapSize 累加各成员：
+//
+//   template <> struct HeapSize<MeshComponent> {
+//     static size_t of(const MeshComponent &mesh) {
+//       return heap_size(mesh.m_Vertices) + heap_size(mesh.m_Indices);
+//     }
+//   };
+//
+// 统计按容量（capacity）而不是元素个数计算，与实际占用一致；不计分配器的额外开销。
+// =============================================================================
+template <typename T, typename = void> struct HeapSize {
+  static size_t of(const T &) { return 0; }
+};
+
+template <typename T> size_t heap_size(const T &value) { return HeapSize<T>::of(value); }
+
+template <typename T, typename Alloc> struct HeapSize<std::vector<T, Alloc>> {
+  static size_t of(const std::vector<T, Alloc> &values) {
+    size_t bytes = values.capacity() * sizeof(T);
+    if constexpr (!std::is_arithmetic_v<T> && !std::is_pointer_v<T> && !std::is_enum_v<T>) {
+      for (const auto &value : values) bytes += heap_size(value);
+    }
+    return bytes;
+  }
+};
+
+template <typename Char, typename Traits, typename Alloc>
+struct HeapSize<std::basic_string<Char, Traits, Alloc>> {
+  static size_t of(const std::basic_string<Char, Traits, Alloc> &text) {
+    // 短字符串存放在对象内部（SSO），没有堆分配；空字符串的容量即为内部缓冲区大小
+    static const size_t inline_capacity = std::basic_string<Char, Traits, Alloc>().capacity();
+    return text.capacity() > inline_capacity ? (text.capacity() + 1) * sizeof(Char) : 0;
+  }
+};
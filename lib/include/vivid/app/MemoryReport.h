@@ -0,0 +1,213 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <entt/entt.hpp>
+#include <functional>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "HeapSize.h"
+#include "Resources.h"
+
+// =============================================================================
+// 内存报告
+//
+// MemoryTracker 作为资源由 App 默认插入，build() 生成某一时刻的 MemoryReport：
+//   - registry 中的每个组件存储：实体数、稠密数组（实体 + 组件）与稀疏数组的字节数，
+//     以及通过组件持有的容器间接占用的堆内存（HeapSize，需要先 track<T>() 注册）；
+//   - Resources 中的每个资源：sizeof 与 HeapSize；
+//   - 外部来源（track_external），例如 SyncScene 创建的 GPU 缓冲区。
+//
+//   app.track_memory<MeshComponent, MaterialComponent>();
+//   tracker.build(res, world).report(std::cout);
+//
+// 未注册的组件存储仍会列出，只是没有组件数组和堆内存的大小。
+// 统计需要遍历被注册组件的全部实例，适合调试面板或每隔若干帧输出，不要每帧调用。
+// =============================================================================
+struct MemoryReport {
+  struct Storage {
+    std::string name;
+    size_t count = 0;
+    size_t component_size = 0;  // 未注册的组件为 0
+    size_t dense_bytes = 0;     // 实体数组 + 组件数组，按容量计
+    size_t sparse_bytes = 0;
+    size_t heap_bytes = 0;
+    bool tracked = false;
+
+    size_t total() const { return dense_bytes + sparse_bytes + heap_bytes; }
+  };
+
+  struct Resource {
+    std::string name;
+    size_t bytes = 0;
+    size_t heap_bytes = 0;
+
+    size_t total() const { return bytes + heap_bytes; }
+  };
+
+  struct External {
+    std::string name;
+    size_t count = 0;
+    size_t bytes = 0;
+  };
+
+  std::vector<Storage> storages;  // 按总字节数降序
+  std::vector<Resource> resources;
+  std::vector<External> external;
+
+  size_t storage_bytes() const { return sum(storages); }
+  size_t resource_bytes() const { return sum(resources); }
+  size_t external_bytes() const {
+    size_t total = 0;
+    for (const auto &entry : external) total += entry.bytes;
+    return total;
+  }
+
+  void report(std::ostream &out) const {
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+    out << std::fixed << std::setprecision(1);
+
+    out << "Memory report: components " << kib(storage_bytes()) << " KiB, resources "
+        << kib(resource_bytes()) << " KiB, external " << kib(external_bytes()) << " KiB\n";
+    out << "  components                 count    dense KiB   sparse KiB     heap KiB\n";
+    for (const auto &entry : storages) {
+      out << "    " << std::left << std::setw(20) << short_name(entry.name) << std::right
+          << std::setw(9) << entry.count << std::setw(13) << kib(entry.dense_bytes)
+          << std::setw(13) << kib(entry.sparse_bytes) << std::setw(13);
+      if (entry.tracked) {
+        out << kib(entry.heap_bytes);
+      } else {
+        out << '-';
+      }
+      out << '\n';
+    }
+    out << "  resources                    KiB     heap KiB\n";
+    for (const auto &entry : resources) {
+      out << "    " << std::left << std::setw(20) << short_name(entry.name) << std::right
+          << std::setw(9) << kib(entry.bytes) << std::setw(13) << kib(entry.heap_bytes) << '\n';
+    }
+    for (const auto &entry : external) {
+      out << "  " << entry.name << ": " << entry.count << " object(s), " << kib(entry.bytes)
+          << " KiB\n";
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+  }
+
+  static double kib(size_t bytes) { return static_cast<double>(bytes) / 1024.0; }
+
+  // 去掉命名空间和 struct / class 前缀，便于在表格中显示
+  static std::string short_name(const std::string &name) {
+    const auto pos = name.rfind("::");
+    std::string result = pos == std::string::npos ? name : name.substr(pos + 2);
+    for (const char *prefix : {"struct ", "class "}) {
+      if (result.rfind(prefix, 0) == 0) result.erase(0, std::char_traits<char>::length(prefix));
+    }
+    return result;
+  }
+
+private:
+  template <typename Entry> static size_t sum(const std::vector<Entry> &entries) {
+    size_t total = 0;
+    for (const auto &entry : entries) total += entry.total();
+    return total;
+  }
+};
+
+class MemoryTracker {
+public:
+  // 外部内存来源，返回对象个数和字节数
+  using ExternalFn = std::function<MemoryReport::External(Resources &, entt::registry &)>;
+
+private:
+  struct Tracked {
+    entt::id_type id = 0;
+    size_t size = 0;
+    size_t (*heap_bytes)(entt::registry &) = nullptr;
+  };
+
+  struct Source {
+    std::string name;
+    ExternalFn fn;
+  };
+
+  std::vector<Tracked> tracked_;
+  std::vector<Source> sources_;
+  uint64_t log_interval_ = 0;
+
+public:
+  // 注册组件类型，报告中包含其组件数组大小和 HeapSize；重复注册无影响
+  template <typename T> MemoryTracker &track() {
+    static_assert(!std::is_empty_v<T>, "empty components have no component array");
+    const auto id = entt::type_hash<T>::value();
+    for (const auto &entry : tracked_) {
+      if (entry.id == id) return *this;
+    }
+    tracked_.push_back(Tracked{id, sizeof(T), [](entt::registry &registry) {
+                                 size_t bytes = 0;
+                                 registry.view<T>().each(
+                                     [&](const T &value) { bytes += heap_size(value); });
+                                 return bytes;
+                               }});
+    return *this;
+  }
+
+  // 注册外部来源；同名来源会被替换，可以在创建资源的系统中反复调用
+  MemoryTracker &track_external(std::string name, ExternalFn fn) {
+    for (auto &source : sources_) {
+      if (source.name == name) {
+        source.fn = std::move(fn);
+        return *this;
+      }
+    }
+    sources_.push_back(Source{std::move(name), std::move(fn)});
+    return *this;
+  }
+
+  // 每隔 frames 帧输出一次报告（由 MemoryReportPlugin 的系统读取），0 为关闭
+  void set_log_interval(uint64_t frames) { log_interval_ = frames; }
+  uint64_t log_interval() const { return log_interval_; }
+
+  // 只能在没有系统运行时调用（主线程上的独占系统、帧之间）
+  MemoryReport build(Resources &res, entt::registry &registry) const {
+    MemoryReport report;
+
+    for (auto [id, pool] : registry.storage()) {
+      MemoryReport::Storage entry;
+      entry.name = std::string(pool.type().name());
+      entry.count = pool.size();
+      entry.sparse_bytes = pool.extent() * sizeof(entt::entity);
+      entry.dense_bytes = pool.capacity() * sizeof(entt::entity);
+      for (const auto &tracked : tracked_) {
+        if (tracked.id != id) continue;
+        entry.tracked = true;
+        entry.component_size = tracked.size;
+        entry.dense_bytes += pool.capacity() * tracked.size;
+        entry.heap_bytes = tracked.heap_bytes(registry);
+      }
+      report.storages.push_back(std::move(entry));
+    }
+    std::sort(report.storages.begin(), report.storages.end(),
+              [](const auto &a, const auto &b) { return a.total() > b.total(); });
+
+    res.each([&](std::string_view name, size_t size, size_t heap_bytes) {
+      report.resources.push_back(MemoryReport::Resource{std::string(name), size, heap_bytes});
+    });
+    std::sort(report.resources.begin(), report.resources.end(),
+              [](const auto &a, const auto &b) { return a.total() > b.total(); });
+
+    for (const auto &source : sources_) {
+      auto entry = source.fn(res, registry);
+      entry.name = source.name;
+      report.external.push_back(std::move(entry));
+    }
+    return report;
+  }
+};
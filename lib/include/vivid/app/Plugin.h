@@ -12,4 +12,7 @@ public:
     virtual ~Plugin() = default;
     virtual void build(App &app) = 0;
     virtual std::string name() const = 0;
+
+    // 需要窗口 / 图形上下文的插件返回 true，无头模式（RunMode::Headless）下跳过
+    virtual bool requires_window() const { return false; }
 };
\ No newline at end of file
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+// =============================================================================
+// 性能分析器
+//
+// 调度器为每个阶段、每个系统自动记录一段耗时；系统内部可以用 VIVID_PROFILE_SCOPE 标记更细的区间：
+//
+//   void physics_step(Query<RigidBodyComponent, TransformComponent> bodies) {
+//     VIVID_PROFILE_SCOPE("integrate");
+//     ...
+//   }
+//
+// 每个线程写自己的环形缓冲区，记录时不加锁；缓冲区写满后覆盖最旧的事件。
+// 运行时开关：
+//
+//   Profiler::instance().set_enabled(true);
+//   Profiler::instance().request_dump("trace.json", 120);  // 在当前帧结束时导出最近 120 帧
+//
+// 导出为 Chrome trace_event JSON，可直接在 Perfetto（ui.perfetto.dev）或 chrome://tracing 中打开。
+// 关闭时每个区间只有一次 relaxed 原子读取；定义 VIVID_DISABLE_PROFILER 则宏完全展开为空。
+// =============================================================================
+class Profiler {
+public:
+  struct Event {
+    const char *name;
+    const char *category;
+    uint64_t start_ns;
+    uint64_t end_ns;
+  };
+
+  static constexpr size_t kDefaultEventsPerThread = 1 << 16;
+  static constexpr size_t kMaxFrames = 1024;
+
+  static Profiler &instance();
+
+  bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+  void set_enabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+
+  // 自分析器创建以来的纳秒数
+  uint64_t now_ns() const {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now() - epoch_)
+                                     .count());
+  }
+
+  // 返回与分析器同寿命的字符串副本，用于动态生成的区间名（如系统名）
+  const char *intern(std::string_view name);
+
+  // 写入当前线程的环形缓冲区
+  void record(const char *name, const char *category, uint64_t start_ns, uint64_t end_ns);
+
+  // 设置当前线程在 trace 中显示的名称
+  void set_thread_name(std::string name);
+
+  // 之后新建的线程缓冲区容量（事件数）
+  void set_events_per_thread(size_t events);
+
+  // 标记新一帧的开始，由 App 在主线程上调用
+  void mark_frame();
+
+  // 请求在当前帧结束时导出最近 frames 帧；可以在任意线程、任意系统中调用
+  void request_dump(std::string path, uint32_t frames = 120);
+
+  // 执行挂起的导出请求，由 App 在帧末、没有系统运行时调用
+  bool flush_pending_dump();
+
+  // 立即导出最近 frames 帧为 Chrome trace JSON；调用时不能有其他线程正在记录
+  bool write_chrome_trace(const std::string &path, uint32_t frames) const;
+
+private:
+  struct ThreadBuffer {
+    uint32_t tid = 0;
+    std::string name;
+    std::vector<Event> events;
+    std::atomic<uint64_t> written{0};
+  };
+
+  Profiler() = default;
+
+  ThreadBuffer &local();
+
+  const std::chrono::steady_clock::time_point epoch_ = std::chrono::steady_clock::now();
+  std::atomic<bool> enabled_{false};
+  std::atomic<bool> dump_pending_{false};
+
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<ThreadBuffer>> threads_;
+  std::unordered_set<std::string> names_;
+  size_t events_per_thread_ = kDefaultEventsPerThread;
+  std::string dump_path_;
+  uint32_t dump_frames_ = 0;
+
+  // 最近 kMaxFrames 帧的开始时间，只由主线程写入
+  std::vector<uint64_t> frame_starts_ = std::vector<uint64_t>(kMaxFrames, 0);
+  uint64_t frame_count_ = 0;
+};
+
+// RAII 计时区间：构造时开始，析构时写入当前线程的缓冲区
+class ProfileScope {
+private:
+  const char *name_;
+  const char *category_;
+  uint64_t start_ = 0;
+
+public:
+  explicit ProfileScope(const char *name, const char *category = "scope")
+      : name_(name && Profiler::instance().enabled() ? name : nullptr), category_(category) {
+    if (name_) start_ = Profiler::instance().now_ns();
+  }
+
+  ~ProfileScope() {
+    if (name_) {
+      auto &profiler = Profiler::instance();
+      profiler.record(name_, category_, start_, profiler.now_ns());
+    }
+  }
+
+  ProfileScope(const ProfileScope &) = delete;
+  ProfileScope &operator=(const ProfileScope &) = delete;
+};
+
+#define VIVID_PROFILE_CONCAT_INNER(a, b) a##b
+#define VIVID_PROFILE_CONCAT(a, b) VIVID_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef VIVID_DISABLE_PROFILER
+#  define VIVID_PROFILE_SCOPE(name)
+#else
+// name 必须是字符串字面量或生命周期足够长的字符串（见 Profiler::intern）
+#  define VIVID_PROFILE_SCOPE(name) \
+    ProfileScope VIVID_PROFILE_CONCAT(vivid_profile_scope_, __LINE__)(name)
+#endif
@@ -1,49 +1,209 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <entt/entt.hpp>
 #include <memory>
-#include <unordered_map>
-#include <typeindex>
+#include <new>
+#include <string_view>
 #include <utility>
+#include <vector>
+
+#include "HeapSize.h"
+
+// 资源类型的顺序编号：每种类型第一次使用时分配，之后固定不变，用作 Resources 稠密数组的下标
+namespace vivid_detail
+{
+    inline size_t next_resource_type_id()
+    {
+        static std::atomic<size_t> counter{0};
+        return counter.fetch_add(1, std::memory_order_relaxed);
+    }
+} // namespace vivid_detail
+
+template <typename T>
+size_t resource_type_id()
+{
+    static const size_t id = vivid_detail::next_resource_type_id();
+    return id;
+}
+
+// 资源槽：地址在 Resources 生命周期内保持不变，ResourceHandle 直接指向它
+struct ResourceSlot
+{
+    void *ptr = nullptr;
+    void (*destroy)(void *) = nullptr;
+
+    // 内存报告使用：类型名、sizeof 与通过容器持有的堆内存（HeapSize）
+    std::string_view name;
+    size_t size = 0;
+    size_t (*heap_size)(const void *) = nullptr;
+};
+
+// 可缓存的资源句柄
+//
+// 在启动阶段通过 Resources::handle<T>() 获取一次，之后每次 get() 只需一次指针读取。
+// 资源被移除或重新插入后句柄仍然有效（分别返回 nullptr / 新对象），
+// 但不能比创建它的 Resources 活得更久。
+template <typename T>
+class ResourceHandle
+{
+private:
+    ResourceSlot *slot_ = nullptr;
+
+public:
+    ResourceHandle() = default;
+    explicit ResourceHandle(ResourceSlot *slot) : slot_(slot) {}
+
+    T *get() const { return slot_ ? static_cast<T *>(slot_->ptr) : nullptr; }
+    T *operator->() const { return get(); }
+    T &operator*() const { return *get(); }
+    explicit operator bool() const { return get() != nullptr; }
+};
 
 // 资源管理器
+//
+// 按资源类型编号索引的稠密数组，get / has 不做哈希查找。
+// 每个资源单独分配并至少按缓存行对齐，不同线程写不同资源时不会发生伪共享。
 class Resources
 {
 private:
-    std::unordered_map<std::type_index, std::unique_ptr<void, void (*)(void *)>> resources_;
+    static constexpr size_t kCacheLineSize = 64;
+
+    std::vector<std::unique_ptr<ResourceSlot>> slots_;
+
+    ResourceSlot *find_slot(size_t id) const
+    {
+        return id < slots_.size() ? slots_[id].get() : nullptr;
+    }
+
+    ResourceSlot &slot(size_t id)
+    {
+        if (id >= slots_.size())
+        {
+            slots_.resize(id + 1);
+        }
+        if (!slots_[id])
+        {
+            slots_[id] = std::make_unique<ResourceSlot>();
+        }
+        return *slots_[id];
+    }
+
+    static void reset(ResourceSlot &slot)
+    {
+        if (slot.ptr)
+        {
+            slot.destroy(slot.ptr);
+            slot.ptr = nullptr;
+            slot.destroy = nullptr;
+            slot.heap_size = nullptr;
+        }
+    }
+
+    template <typename T>
+    static constexpr std::align_val_t alignment()
+    {
+        return std::align_val_t(std::max(alignof(T), kCacheLineSize));
+    }
 
 public:
+    Resources() = default;
+    Resources(const Resources &) = delete;
+    Resources &operator=(const Resources &) = delete;
+
+    ~Resources()
+    {
+        // 按类型编号逆序销毁：先被使用的资源类型（如 App 构造时插入的 TaskPool）最后析构
+        for (auto it = slots_.rbegin(); it != slots_.rend(); ++it)
+        {
+            if (*it)
+            {
+                reset(**it);
+            }
+        }
+    }
+
     template <typename T, typename... Args>
     T &insert(Args &&...args)
     {
-        auto deleter = [](void *ptr)
-        { delete static_cast<T *>(ptr); };
-        auto resource = std::make_unique<T>(std::forward<Args>(args)...);
-        T *ptr = resource.get();
-        resources_.insert_or_assign(std::type_index(typeid(T)),
-                                    std::unique_ptr<void, void (*)(void *)>(resource.release(), deleter));
+        void *memory = ::operator new(sizeof(T), alignment<T>());
+        T *ptr = nullptr;
+        try
+        {
+            ptr = ::new (memory) T(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            ::operator delete(memory, alignment<T>());
+            throw;
+        }
+
+        auto &target = slot(resource_type_id<T>());
+        reset(target);
+        target.ptr = ptr;
+        target.destroy = [](void *p)
+        {
+            static_cast<T *>(p)->~T();
+            ::operator delete(p, alignment<T>());
+        };
+        target.name = entt::type_name<T>::value();
+        target.size = sizeof(T);
+        target.heap_size = [](const void *p)
+        {
+            return heap_size(*static_cast<const T *>(p));
+        };
         return *ptr;
     }
 
     template <typename T>
     T *get()
     {
-        auto it = resources_.find(std::type_index(typeid(T)));
-        if (it != resources_.end())
-        {
-            return static_cast<T *>(it->second.get());
-        }
-        return nullptr;
+        auto *target = find_slot(resource_type_id<T>());
+        return target ? static_cast<T *>(target->ptr) : nullptr;
+    }
+
+    template <typename T>
+    const T *get() const
+    {
+        auto *target = find_slot(resource_type_id<T>());
+        return target ? static_cast<const T *>(target->ptr) : nullptr;
     }
 
     template <typename T>
     bool has() const
     {
-        return resources_.find(std::type_index(typeid(T))) != resources_.end();
+        auto *target = find_slot(resource_type_id<T>());
+        return target && target->ptr;
     }
 
     template <typename T>
     void remove()
     {
-        resources_.erase(std::type_index(typeid(T)));
+        if (auto *target = find_slot(resource_type_id<T>()))
+        {
+            reset(*target);
+        }
+    }
+
+    // 遍历已插入的资源：fn(name, size, heap_bytes)
+    template <typename Fn>
+    void each(Fn &&fn) const
+    {
+        for (const auto &target : slots_)
+        {
+            if (target && target->ptr)
+            {
+                fn(target->name, target->size, target->heap_size(target->ptr));
+            }
+        }
+    }
+
+    // 获取稳定句柄；资源尚未插入时也可以获取，插入后句柄自动可用
+    template <typename T>
+    ResourceHandle<T> handle()
+    {
+        return ResourceHandle<T>(&slot(resource_type_id<T>()));
     }
-};
\ No newline at end of file
+};
@@ -11,21 +11,16 @@
 
 #include <functional>
 #include <memory>
-#include <queue>
 #include <string>
 #include <unordered_map>
 
 #include "App.h"
 #include "vivid/log/log.h"
 
-// TODO: 事件系统
-struct EventQueues {
-  std::queue<SDL_Event> raw_sdl_events;  // 原始SDL事件
-  // std::queue<InputEvent> input_events;            // 输入事件
-  // std::queue<WindowEvent> window_events;          // 窗口事件
-  // std::queue<SystemEvent> system_events;          // 系统事件
-  // ... 更多特定事件队列
-};
+// 原始 SDL 事件：SDL_AppEvent 在帧之间写入 Events<SDL_Event>，
+// 系统在每帧开始时的 Event 阶段通过 EventReader<SDL_Event> 批量读取。
+// 同一窗口连续的鼠标移动事件合并为一个（相对位移累加，其余取最新值）。
+bool coalesce_sdl_event(SDL_Event& last, const SDL_Event& next);
 
 // 为了向后兼容，创建别名
 using SDL3LogLevel = VividLogLevel;
@@ -149,6 +144,9 @@ struct SDL3AppState {
   SDL3AssertConfig assert_config;
   bool initialized = false;
 
+  // SDL_AppEvent 每个事件都要访问，初始化时取一次句柄
+  ResourceHandle<Events<SDL_Event>> sdl_events;
+
   SDL3AppState() = default;
   ~SDL3AppState() = default;
 
@@ -171,7 +169,10 @@ private:
   SDL3AssertConfig assert_config_;
 
 public:
-  SDL3AppBuilder() : app_(std::make_unique<App>()) {}
+  SDL3AppBuilder() : app_(std::make_unique<App>()) {
+    app_->add_event<SDL_Event>();
+    app_->resource<Events<SDL_Event>>()->set_coalesce(coalesce_sdl_event);
+  }
 
   // 禁用拷贝，启用移动
   SDL3AppBuilder(const SDL3AppBuilder&) = delete;
@@ -186,14 +187,15 @@ public:
   }
 
   // 添加系统
-  template <typename Fn> SDL3AppBuilder& add_system(ScheduleLabel label, Fn&& fn) {
-    app_->add_system(label, std::forward<Fn>(fn));
+  template <typename Fn>
+  SDL3AppBuilder& add_system(ScheduleLabel label, Fn&& fn, SystemConfig config = {}) {
+    app_->add_system(label, std::forward<Fn>(fn), std::move(config));
     return *this;
   }
 
   // 添加启动系统
-  template <typename Fn> SDL3AppBuilder& add_startup_system(Fn&& fn) {
-    app_->add_startup_system(std::forward<Fn>(fn));
+  template <typename Fn> SDL3AppBuilder& add_startup_system(Fn&& fn, SystemConfig config = {}) {
+    app_->add_startup_system(std::forward<Fn>(fn), std::move(config));
     return *this;
   }
 
@@ -1,59 +1,691 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <entt/entt.hpp>
+#include <exception>
 #include <functional>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "Profiler.h"
 #include "Resources.h"
+#include "SystemFunction.h"
+#include "SystemParam.h"
+#include "TaskPool.h"
 
 // 系统函数类型
 using SystemFn = std::function<void(Resources &, entt::registry &)>;
 
+// 调度器内部使用的系统调用形式，额外传入系统自身的元数据
+using SystemRunner = SystemFunction;
+
 // 调度阶段枚举
 enum class ScheduleLabel {
   Startup,
   PreUpdate,
+  FixedUpdate,  // 固定步长，每帧运行 0..N 次，见 Time.h
   Update,
   PostUpdate,
   Render,
   Cleanup,
   Shutdown,
-  Event
+  Event  // 每帧开始时运行一次，批量处理上一帧以来的事件（Events<T>）
+};
+
+inline constexpr size_t kScheduleLabelCount = static_cast<size_t>(ScheduleLabel::Event) + 1;
+
+inline const char *schedule_label_name(ScheduleLabel label) {
+  switch (label) {
+    case ScheduleLabel::Startup: return "Startup";
+    case ScheduleLabel::PreUpdate: return "PreUpdate";
+    case ScheduleLabel::FixedUpdate: return "FixedUpdate";
+    case ScheduleLabel::Update: return "Update";
+    case ScheduleLabel::PostUpdate: return "PostUpdate";
+    case ScheduleLabel::Render: return "Render";
+    case ScheduleLabel::Cleanup: return "Cleanup";
+    case ScheduleLabel::Shutdown: return "Shutdown";
+    case ScheduleLabel::Event: return "Event";
+  }
+  return "Unknown";
+}
+
+// 运行条件：返回 false 时本次跳过系统（不更新系统的 last_run_tick，
+// 最近 max_change_age 帧内的变更不会丢失）
+// 条件的访问集合会并入系统自身的访问集合，参与冲突图的构建。
+struct RunCondition {
+  using Fn = std::function<bool(Resources &, entt::registry &, const SystemMeta &)>;
+
+  Fn fn;
+  SystemAccess access;
+
+  RunCondition(Fn condition, SystemAccess condition_access)
+      : fn(std::move(condition)), access(std::move(condition_access)) {}
+
+  // 任意 bool(Resources&, entt::registry&)：访问未知，按独占处理
+  template <typename F, typename = std::enable_if_t<
+                            std::is_invocable_r_v<bool, F &, Resources &, entt::registry &>>>
+  RunCondition(F condition)  // NOLINT(google-explicit-constructor)
+      : fn([condition = std::move(condition)](Resources &res, entt::registry &world,
+                                              const SystemMeta &) mutable {
+          return condition(res, world);
+        }) {
+    access.exclusive = true;
+    access.main_thread = true;
+  }
+
+  bool operator()(Resources &res, entt::registry &world, const SystemMeta &meta) const {
+    return fn(res, world, meta);
+  }
+};
+
+inline RunCondition operator&&(RunCondition lhs, RunCondition rhs) {
+  SystemAccess access = lhs.access;
+  access.merge(rhs.access);
+  return RunCondition(
+      [lhs = std::move(lhs.fn), rhs = std::move(rhs.fn)](
+          Resources &res, entt::registry &world, const SystemMeta &meta) {
+        return lhs(res, world, meta) && rhs(res, world, meta);
+      },
+      std::move(access));
+}
+
+inline RunCondition operator||(RunCondition lhs, RunCondition rhs) {
+  SystemAccess access = lhs.access;
+  access.merge(rhs.access);
+  return RunCondition(
+      [lhs = std::move(lhs.fn), rhs = std::move(rhs.fn)](
+          Resources &res, entt::registry &world, const SystemMeta &meta) {
+        return lhs(res, world, meta) || rhs(res, world, meta);
+      },
+      std::move(access));
+}
+
+inline RunCondition operator!(RunCondition condition) {
+  return RunCondition(
+      [fn = std::move(condition.fn)](Resources &res, entt::registry &world,
+                                     const SystemMeta &meta) { return !fn(res, world, meta); },
+      std::move(condition.access));
+}
+
+// 自系统上次运行以来有实体添加了组件 T
+template <typename T> RunCondition any_added() {
+  SystemAccess access;
+  access.read_changes<T>();
+  return RunCondition(
+      [](Resources &res, entt::registry &, const SystemMeta &meta) {
+        auto *tracker = res.get<ComponentTracker<T>>();
+        return tracker && tracker->last_added() > meta.last_run_tick;
+      },
+      std::move(access));
+}
+
+// 自系统上次运行以来有实体添加或修改了组件 T
+template <typename T> RunCondition any_changed() {
+  SystemAccess access;
+  access.read_changes<T>();
+  return RunCondition(
+      [](Resources &res, entt::registry &, const SystemMeta &meta) {
+        auto *tracker = res.get<ComponentTracker<T>>();
+        return tracker && tracker->last_changed() > meta.last_run_tick;
+      },
+      std::move(access));
+}
+
+// 自系统上次运行以来有实体移除了组件 T
+template <typename T> RunCondition any_removed() {
+  SystemAccess access;
+  access.read_changes<T>();
+  return RunCondition(
+      [](Resources &res, entt::registry &, const SystemMeta &meta) {
+        auto *tracker = res.get<ComponentTracker<T>>();
+        return tracker && tracker->last_removed() > meta.last_run_tick;
+      },
+      std::move(access));
+}
+
+// 资源 T 存在
+template <typename T> RunCondition resource_exists() {
+  SystemAccess access;
+  access.read_resource<T>();
+  return RunCondition([](Resources &res, entt::registry &,
+                         const SystemMeta &) { return res.has<T>(); },
+                      std::move(access));
+}
+
+// 系统配置：名称、显式顺序约束与运行条件
+//
+//   app.add_system(ScheduleLabel::Update, physics_step,
+//                  SystemConfig("physics").after("input").before("transform_propagate"));
+//   app.add_system(ScheduleLabel::Update, upload_meshes,
+//                  SystemConfig("upload").run_if(any_added<MeshComponent>()));
+struct SystemConfig {
+  SystemConfig() = default;
+  SystemConfig(std::string system_name) : name(std::move(system_name)) {}  // NOLINT
+  SystemConfig(const char *system_name) : name(system_name) {}             // NOLINT
+
+  // 本系统必须在 other 之前运行
+  SystemConfig &before(std::string other) {
+    run_before.push_back(std::move(other));
+    return *this;
+  }
+
+  // 本系统必须在 other 之后运行
+  SystemConfig &after(std::string other) {
+    run_after.push_back(std::move(other));
+    return *this;
+  }
+
+  // 所有条件都满足时才运行
+  SystemConfig &run_if(RunCondition condition) {
+    conditions.push_back(std::move(condition));
+    return *this;
+  }
+
+  // 显式访问声明：旧式 (Resources&, entt::registry&) 系统默认独占且固定在主线程；
+  // 声明了访问后只与访问冲突的系统串行，其余依赖用 before/after 表达。
+  // 主要用于启动阶段，让场景构建、网格生成等与 WebGPU 适配器/设备握手并行：
+  //
+  //   app.add_startup_system(build_scene,
+  //                          SystemConfig("build_scene").spawns().writes<MeshComponent>().worker_thread());
+  //
+  // 系统只能访问声明过的组件和资源；创建实体需要声明 spawns()。
+  template <typename T> SystemConfig &reads() {
+    access.read_component<T>();
+    declared_access = true;
+    return *this;
+  }
+
+  template <typename T> SystemConfig &writes() {
+    access.write_component<T>();
+    declared_access = true;
+    return *this;
+  }
+
+  template <typename T> SystemConfig &reads_resource() {
+    access.read_resource<T>();
+    declared_access = true;
+    return *this;
+  }
+
+  template <typename T> SystemConfig &writes_resource() {
+    access.write_resource<T>();
+    declared_access = true;
+    return *this;
+  }
+
+  // 创建 / 销毁实体
+  SystemConfig &spawns() { return writes<entt::entity>(); }
+
+  // 允许在工作线程上运行（默认在主线程上运行）
+  SystemConfig &worker_thread() {
+    on_worker_thread = true;
+    declared_access = true;
+    return *this;
+  }
+
+  std::string name;
+  std::vector<std::string> run_before;
+  std::vector<std::string> run_after;
+  std::vector<RunCondition> conditions;
+  SystemAccess access;
+  bool declared_access = false;
+  bool on_worker_thread = false;
+};
+
+// 单个系统一次运行的起止时间（steady_clock 纳秒）及所在线程
+struct SystemTiming {
+  uint64_t start_ns = 0;
+  uint64_t end_ns = 0;
+  std::thread::id thread;
+};
+
+// 已注册的系统
+struct SystemDescriptor {
+  SystemRunner run;
+  SystemMeta meta;
+  std::vector<RunCondition> conditions;
 };
 
 // 系统调度器
+//
+// 系统注册时只追加到对应阶段的数组中；App::initialize / App::run 时调用 freeze() 冻结调度表：
+// 按 before/after 约束做拓扑排序（无约束的系统保持注册顺序），把系统按最终顺序连续存放，
+// 并构建并行执行用的依赖图。之后每帧按 ScheduleLabel 直接索引阶段数组，不再做哈希查找。
+// 冻结后仍可添加系统，所在阶段会在下一次运行前重新冻结。
 class Schedule {
 private:
-  std::unordered_map<ScheduleLabel, std::vector<SystemFn>> systems_;
+  struct Stage {
+    // 冻结后按执行顺序排列
+    std::vector<SystemDescriptor> systems;
+
+    // 记录每个系统本次运行的起止时间（启动阶段时间线）
+    bool timed = false;
+    std::vector<SystemTiming> timings;
+
+    // 依赖图：dependents[i] 为必须等待系统 i 完成后才能运行的系统
+    std::vector<std::vector<size_t>> dependents;
+    std::vector<size_t> dependency_count;
+    bool parallelizable = false;
+    bool frozen = false;
+  };
+
+  std::array<Stage, kScheduleLabelCount> stages_;
+
+  static Stage &stage_of(std::array<Stage, kScheduleLabelCount> &stages, ScheduleLabel label) {
+    return stages[static_cast<size_t>(label)];
+  }
+
+  // 解析 before/after 约束，返回 edges[i]：必须在系统 i 之后运行的系统（注册顺序下标）
+  static std::vector<std::vector<size_t>> ordering_edges(const Stage &stage) {
+    const size_t count = stage.systems.size();
+    std::unordered_map<std::string, size_t> by_name;
+    for (size_t i = 0; i < count; ++i) {
+      const auto &name = stage.systems[i].meta.name;
+      if (name.empty()) continue;
+      if (!by_name.emplace(name, i).second) {
+        std::cerr << "Schedule: duplicate system name '" << name
+                  << "', ordering constraints refer to the first one" << std::endl;
+      }
+    }
+
+    auto lookup = [&](const std::string &owner, const std::string &name, size_t &index) {
+      auto it = by_name.find(name);
+      if (it == by_name.end()) {
+        std::cerr << "Schedule: system '" << owner << "' is ordered against unknown system '"
+                  << name << "', constraint ignored" << std::endl;
+        return false;
+      }
+      index = it->second;
+      return true;
+    };
+
+    std::vector<std::vector<size_t>> edges(count);
+    for (size_t i = 0; i < count; ++i) {
+      const auto &meta = stage.systems[i].meta;
+      size_t other = 0;
+      for (const auto &name : meta.before) {
+        if (lookup(meta.name, name, other) && other != i) edges[i].push_back(other);
+      }
+      for (const auto &name : meta.after) {
+        if (lookup(meta.name, name, other) && other != i) edges[other].push_back(i);
+      }
+    }
+    return edges;
+  }
+
+  // 冻结一个阶段：拓扑排序、按顺序重排系统、构建依赖图
+  static void freeze_stage(Stage &stage, Resources &resources, entt::registry &registry) {
+    const size_t count = stage.systems.size();
+    auto edges = ordering_edges(stage);
+
+    // Kahn 拓扑排序，就绪系统中总是先取注册顺序最早的，保证无约束时顺序不变
+    std::vector<size_t> indegree(count, 0);
+    for (const auto &targets : edges) {
+      for (auto target : targets) ++indegree[target];
+    }
+    std::priority_queue<size_t, std::vector<size_t>, std::greater<size_t>> ready;
+    for (size_t i = 0; i < count; ++i) {
+      if (indegree[i] == 0) ready.push(i);
+    }
+    std::vector<size_t> order;
+    order.reserve(count);
+    while (!ready.empty()) {
+      size_t index = ready.top();
+      ready.pop();
+      order.push_back(index);
+      for (auto target : edges[index]) {
+        if (--indegree[target] == 0) ready.push(target);
+      }
+    }
+
+    if (order.size() != count) {
+      std::string cycle;
+      for (size_t i = 0; i < count; ++i) {
+        if (indegree[i] == 0) continue;
+        if (!cycle.empty()) cycle += ", ";
+        cycle += stage.systems[i].meta.name.empty() ? "<unnamed>" : stage.systems[i].meta.name;
+      }
+      throw std::runtime_error("Schedule: cyclic before/after constraints between systems: "
+                               + cycle);
+    }
+
+    // 按拓扑顺序连续存放
+    std::vector<size_t> position(count);
+    std::vector<SystemDescriptor> sorted;
+    sorted.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      position[order[i]] = i;
+      sorted.push_back(std::move(stage.systems[order[i]]));
+    }
+    stage.systems = std::move(sorted);
+
+    // 显式约束边（换算到新下标）
+    std::vector<std::vector<size_t>> constrained(count);
+    for (size_t from = 0; from < count; ++from) {
+      for (auto to : edges[from]) constrained[position[from]].push_back(position[to]);
+    }
+
+    // 依赖图：冲突的系统以及有显式约束的系统保持排序后的先后顺序
+    stage.dependents.assign(count, {});
+    stage.dependency_count.assign(count, 0);
+    stage.parallelizable = false;
+
+    for (size_t i = 0; i < count; ++i) {
+      const auto &access = stage.systems[i].meta.access;
+      for (auto init : access.initializers) {
+        init(resources, registry);
+      }
+      if (!access.main_thread) stage.parallelizable = true;
+
+      for (size_t j = 0; j < i; ++j) {
+        const auto &after_j = constrained[j];
+        if (access.conflicts_with(stage.systems[j].meta.access)
+            || std::find(after_j.begin(), after_j.end(), i) != after_j.end()) {
+          stage.dependents[j].push_back(i);
+          ++stage.dependency_count[i];
+        }
+      }
+    }
+
+    stage.parallelizable = stage.parallelizable && count > 1;
+    stage.frozen = true;
+  }
+
+  // 运行单个系统：检查运行条件、推进变更 tick，运行后记录本次的 tick
+  static void run_system(SystemDescriptor &system, Resources &resources, entt::registry &registry) {
+    for (const auto &condition : system.conditions) {
+      if (!condition(resources, registry, system.meta)) return;
+    }
+
+    ProfileScope scope(system.meta.profile_name, "system");
+
+    auto *detection = resources.get<ChangeDetection>();
+    if (!detection) {
+      system.run(resources, registry, system.meta);
+      return;
+    }
+
+    // 并行阶段中其他系统会在本系统运行期间推进 tick，自己的修改可能记在大于开始时 tick 的位置；
+    // 所以运行结束后取当前 tick 作为 last_run_tick，下次运行不会再看到自己的修改。
+    // 期间并发运行的系统都与本系统无冲突，不会修改它读取的组件，不会因此漏掉变更。
+    // 之后再推进一次，此后（包括系统之外）的变更都晚于 last_run_tick
+    detection->advance();
+    system.run(resources, registry, system.meta);
+    system.meta.last_run_tick = detection->tick();
+    detection->advance();
+  }
+
+  // 运行阶段中的第 index 个系统，需要时记录时间
+  static void run_indexed(Stage &stage, size_t index, Resources &resources,
+                          entt::registry &registry) {
+    if (!stage.timed) {
+      run_system(stage.systems[index], resources, registry);
+      return;
+    }
+    auto &timing = stage.timings[index];
+    timing.thread = std::this_thread::get_id();
+    timing.start_ns = clock_ns();
+    run_system(stage.systems[index], resources, registry);
+    timing.end_ns = clock_ns();
+  }
+
+  // 一次并行执行的共享状态，生命周期限定在 run_parallel 调用内
+  struct ParallelRun {
+    Stage &stage;
+    Resources &resources;
+    entt::registry &registry;
+    TaskPool &pool;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<size_t> pending;
+    std::deque<size_t> main_ready;
+    size_t finished = 0;
+    std::exception_ptr error;
+
+    ParallelRun(Stage &s, Resources &res, entt::registry &reg, TaskPool &p)
+        : stage(s), resources(res), registry(reg), pool(p), pending(s.dependency_count) {}
+
+    void dispatch(size_t index) {
+      if (stage.systems[index].meta.access.main_thread) {
+        std::lock_guard<std::mutex> lock(mutex);
+        main_ready.push_back(index);
+        cv.notify_all();
+      } else {
+        pool.submit([this, index] { execute(index); });
+      }
+    }
+
+    void execute(size_t index) {
+      try {
+        run_indexed(stage, index, resources, registry);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error) error = std::current_exception();
+      }
+      complete(index);
+    }
+
+    void complete(size_t index) {
+      std::vector<size_t> worker_ready;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++finished;
+        for (auto dependent : stage.dependents[index]) {
+          if (--pending[dependent] == 0) {
+            if (stage.systems[dependent].meta.access.main_thread) {
+              main_ready.push_back(dependent);
+            } else {
+              worker_ready.push_back(dependent);
+            }
+          }
+        }
+        // 在持锁时通知：主线程被唤醒后可能立即销毁本对象
+        cv.notify_all();
+      }
+      for (auto ready : worker_ready) {
+        pool.submit([this, ready] { execute(ready); });
+      }
+    }
+
+    void run() {
+      std::vector<size_t> roots;
+      for (size_t i = 0; i < pending.size(); ++i) {
+        if (pending[i] == 0) roots.push_back(i);
+      }
+      for (auto root : roots) {
+        dispatch(root);
+      }
+
+      // 主线程负责执行所有主线程系统；空闲时帮忙执行线程池中的任务，最后等待其余系统完成
+      for (;;) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!main_ready.empty()) {
+          size_t index = main_ready.front();
+          main_ready.pop_front();
+          lock.unlock();
+          execute(index);
+          continue;
+        }
+        if (finished == pending.size()) break;
+        lock.unlock();
+
+        if (pool.try_run_one()) continue;
+
+        lock.lock();
+        cv.wait(lock, [this] { return !main_ready.empty() || finished == pending.size(); });
+      }
+
+      if (error) std::rethrow_exception(error);
+    }
+  };
 
 public:
+  // 添加旧式系统：访问完整的 Resources / registry，独占执行且固定在主线程
   void add_system(ScheduleLabel label, SystemFn system) {
-    systems_[label].push_back(std::move(system));
+    SystemMeta meta;
+    meta.access.exclusive = true;
+    meta.access.main_thread = true;
+    add_system(
+        label,
+        [system = std::move(system)](Resources &res, entt::registry &reg, SystemMeta &) {
+          system(res, reg);
+        },
+        std::move(meta));
   }
 
-  void run_schedule(ScheduleLabel label, Resources &resources, entt::registry &registry) {
-    auto it = systems_.find(label);
-    if (it != systems_.end()) {
-      if (label == ScheduleLabel::Shutdown) {
-        // Execute shutdown systems in reverse order of registration (LIFO)
-        // to ensure dependencies are handled correctly.
-        for (auto rit = it->second.rbegin(); rit != it->second.rend(); ++rit) {
-          (*rit)(resources, registry);
+  // 添加带访问声明的系统
+  void add_system(ScheduleLabel label, SystemRunner run, SystemMeta meta,
+                  std::vector<RunCondition> conditions = {}) {
+    for (const auto &condition : conditions) {
+      meta.access.merge(condition.access);
+    }
+    auto &stage = stage_of(stages_, label);
+    if (!meta.name.empty()) {
+      meta.profile_name = Profiler::instance().intern(meta.name);
+    } else if (!meta.type_name.empty()) {
+      meta.profile_name = Profiler::instance().intern(meta.type_name);
+    } else {
+      meta.profile_name = Profiler::instance().intern(std::string(schedule_label_name(label)) + "#"
+                                                      + std::to_string(stage.systems.size()));
+    }
+    stage.systems.push_back(
+        SystemDescriptor{std::move(run), std::move(meta), std::move(conditions)});
+    stage.frozen = false;
+  }
+
+  // 冻结所有阶段的调度表；约束成环时抛出 std::runtime_error
+  void freeze(Resources &resources, entt::registry &registry) {
+    for (auto &stage : stages_) {
+      if (!stage.frozen) freeze_stage(stage, resources, registry);
+    }
+  }
+
+  // 把 last_run_tick 早于 expired 的读取者推进到 expired：它们下次运行时只能看到此后的变更
+  void expire_change_ticks(uint64_t expired) {
+    for (size_t i = 0; i < kScheduleLabelCount; ++i) {
+      const auto label = static_cast<ScheduleLabel>(i);
+      if (label == ScheduleLabel::Startup || label == ScheduleLabel::Shutdown) continue;
+      for (auto &system : stages_[i].systems) {
+        if (system.meta.access.reads_changes) {
+          system.meta.last_run_tick = std::max(system.meta.last_run_tick, expired);
         }
-      } else {
-        for (auto &system : it->second) {
-          system(resources, registry);
+      }
+    }
+  }
+
+  // 读取变更记录的每帧系统中最早的 last_run_tick，更早的变更历史已无人需要。
+  // Startup / Shutdown 只运行一次，不计入。
+  uint64_t oldest_change_reader_tick() const {
+    uint64_t oldest = kNoChangeReaders;
+    for (size_t i = 0; i < kScheduleLabelCount; ++i) {
+      const auto label = static_cast<ScheduleLabel>(i);
+      if (label == ScheduleLabel::Startup || label == ScheduleLabel::Shutdown) continue;
+      for (const auto &system : stages_[i].systems) {
+        if (system.meta.access.reads_changes) {
+          oldest = std::min(oldest, system.meta.last_run_tick);
         }
       }
     }
+    return oldest;
   }
 
-  void clear_schedule(ScheduleLabel label) {
-    auto it = systems_.find(label);
-    if (it != systems_.end()) {
-      it->second.clear();
+  void run_schedule(ScheduleLabel label, Resources &resources, entt::registry &registry) {
+    auto &stage = stage_of(stages_, label);
+    auto &systems = stage.systems;
+    if (systems.empty()) return;
+
+    if (!stage.frozen) freeze_stage(stage, resources, registry);
+
+    ProfileScope scope(schedule_label_name(label), "stage");
+    if (stage.timed) stage.timings.assign(systems.size(), SystemTiming{});
+
+    if (label == ScheduleLabel::Shutdown) {
+      // Execute shutdown systems in reverse order of registration (LIFO)
+      // to ensure dependencies are handled correctly.
+      for (auto rit = systems.rbegin(); rit != systems.rend(); ++rit) {
+        run_system(*rit, resources, registry);
+      }
+      return;
+    }
+
+    auto *pool = resources.get<TaskPool>();
+    if (!pool || pool->thread_count() == 0 || !stage.parallelizable) {
+      for (size_t i = 0; i < systems.size(); ++i) {
+        run_indexed(stage, i, resources, registry);
+      }
+      return;
     }
+
+    ParallelRun run(stage, resources, registry, *pool);
+    run.run();
+  }
+
+  // SystemTiming 使用的时钟
+  static uint64_t clock_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+  }
+
+  // 开启后记录该阶段每个系统的起止时间，见 timings()
+  void set_timed(ScheduleLabel label, bool timed) { stage_of(stages_, label).timed = timed; }
+
+  // 按执行顺序排列的系统数、元数据以及最近一次运行的时间
+  size_t system_count(ScheduleLabel label) const {
+    return stages_[static_cast<size_t>(label)].systems.size();
+  }
+  const SystemMeta &system_meta(ScheduleLabel label, size_t index) const {
+    return stages_[static_cast<size_t>(label)].systems[index].meta;
+  }
+  const std::vector<SystemTiming> &timings(ScheduleLabel label) const {
+    return stages_[static_cast<size_t>(label)].timings;
   }
-};
\ No newline at end of file
+
+  // 关键路径：依赖图（冲突边 + 顺序约束边）中按最近一次耗时计算的最长路径，返回系统下标。
+  // 阶段的墙钟时间不可能短于这条路径，缩短启动时间应从这条路径上的系统入手。
+  std::vector<size_t> critical_path(ScheduleLabel label) const {
+    const auto &stage = stages_[static_cast<size_t>(label)];
+    const size_t count = stage.timings.size();
+    if (count == 0 || count != stage.systems.size()) return {};
+
+    // 系统按拓扑顺序存放，依赖边总是从小下标指向大下标
+    std::vector<uint64_t> finish(count, 0);
+    std::vector<size_t> previous(count, count);
+    for (size_t i = 0; i < count; ++i) {
+      const auto &timing = stage.timings[i];
+      finish[i] += timing.end_ns - timing.start_ns;
+      for (auto dependent : stage.dependents[i]) {
+        // 进入 dependent 之前 finish[dependent] 暂存其前驱中最晚的完成时间
+        if (previous[dependent] == count || finish[i] > finish[dependent]) {
+          finish[dependent] = finish[i];
+          previous[dependent] = i;
+        }
+      }
+    }
+
+    size_t last = static_cast<size_t>(std::max_element(finish.begin(), finish.end())
+                                      - finish.begin());
+    std::vector<size_t> path;
+    for (size_t i = last; i != count; i = previous[i]) path.push_back(i);
+    std::reverse(path.begin(), path.end());
+    return path;
+  }
+
+  void clear_schedule(ScheduleLabel label) {
+    auto &stage = stage_of(stages_, label);
+    stage.systems.clear();
+    stage.frozen = false;
+  }
+};
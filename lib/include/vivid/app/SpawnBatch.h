@@ -0,0 +1,103 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <entt/entt.hpp>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ChangeDetection.h"
+#include "Resources.h"
+
+// =============================================================================
+// 批量创建实体（spawn_batch）
+//
+// 一次创建 count 个实体并添加同一组组件，用于加载关卡、生成大量物体：
+//
+//   // 原型值复制给每个实体
+//   app.spawn_batch(500000, TransformComponent{}, cube_mesh, MaterialComponent{...});
+//
+//   // per_entity(values) 给每个实体各自的值，可以与原型值混用
+//   commands.spawn_batch(count, per_entity(std::move(transforms)), cube_mesh, material);
+//
+// 与逐个 create + emplace 相比：实体存储和每个组件存储都先按最终大小预留一次，
+// 组件用 entt 的范围 insert 连续写入；变更追踪器（ComponentTracker）在插入期间暂停逐个实体的
+// on_construct 记录，插入完成后一次记录整段范围，Added<T> / any_added<T>() 照常生效。
+// 其他监听 on_construct 的回调（例如拥有型分组）仍然逐个实体触发。
+// =============================================================================
+
+// 每个实体各自的组件值，按实体创建顺序对应；个数少于 count 时只创建这么多实体
+template <typename T> struct PerEntity {
+  std::vector<T> values;
+};
+
+template <typename T> PerEntity<T> per_entity(std::vector<T> values) {
+  return PerEntity<T>{std::move(values)};
+}
+
+namespace vivid_detail {
+
+  template <typename Arg> struct spawn_arg {
+    using component = std::decay_t<Arg>;
+    static size_t extent(const component &) { return std::numeric_limits<size_t>::max(); }
+  };
+
+  template <typename T> struct spawn_arg<PerEntity<T>> {
+    using component = T;
+    static size_t extent(const PerEntity<T> &column) { return column.values.size(); }
+  };
+
+  template <typename T> void insert_range(entt::registry &registry,
+                                          const std::vector<entt::entity> &entities,
+                                          const T &prototype) {
+    if constexpr (std::is_empty_v<T>) {
+      registry.insert<T>(entities.begin(), entities.end());
+    } else {
+      registry.insert<T>(entities.begin(), entities.end(), prototype);
+    }
+  }
+
+  template <typename T> void insert_range(entt::registry &registry,
+                                          const std::vector<entt::entity> &entities,
+                                          const PerEntity<T> &column) {
+    registry.insert<T>(entities.begin(), entities.end(), column.values.begin());
+  }
+
+  template <typename Arg>
+  void spawn_component(Resources *res, entt::registry &registry,
+                       const std::vector<entt::entity> &entities, const Arg &arg) {
+    using T = typename spawn_arg<Arg>::component;
+    auto &storage = registry.storage<T>();
+    storage.reserve(storage.size() + entities.size());
+
+    auto *tracker = res ? res->get<ComponentTracker<T>>() : nullptr;
+    if (tracker) tracker->begin_batch();
+    insert_range(registry, entities, arg);
+    if (tracker) tracker->end_batch(entities.begin(), entities.end());
+  }
+
+  template <typename... Args>
+  std::vector<entt::entity> spawn_batch(Resources *res, entt::registry &registry, size_t count,
+                                        const Args &...args) {
+    count = std::min({count, spawn_arg<Args>::extent(args)...});
+    std::vector<entt::entity> entities(count);
+    if (count == 0) return entities;
+
+    auto &pool = registry.storage<entt::entity>();
+    pool.reserve(pool.size() + count);
+    registry.create(entities.begin(), entities.end());
+    (spawn_component(res, registry, entities, args), ...);
+    return entities;
+  }
+
+}  // namespace vivid_detail
+
+// 在主线程上、没有系统运行时调用（旧式系统、启动阶段之前）；系统中使用 Commands::spawn_batch
+template <typename... Args>
+std::vector<entt::entity> spawn_batch(Resources &res, entt::registry &registry, size_t count,
+                                      const Args &...args) {
+  return vivid_detail::spawn_batch(&res, registry, count, args...);
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Schedule.h"
+
+// =============================================================================
+// 启动时间线
+//
+// App 在 Startup 阶段结束后根据调度器记录的系统起止时间生成，作为资源保存：
+// 每个启动系统的开始时间、耗时、所在线程，以及依赖图上的关键路径。
+// first_frame_ms 为从 App 构造到第一帧结束的时间（冷启动到首帧），第一帧结束后填入。
+// =============================================================================
+class StartupTimeline {
+public:
+  struct Entry {
+    std::string name;
+    double start_ms = 0.0;  // 相对 Startup 阶段开始
+    double duration_ms = 0.0;
+    uint32_t thread = 0;  // 0 为主线程，其余按首次出现的顺序编号
+    bool critical = false;
+  };
+
+  std::vector<Entry> entries;  // 按开始时间排序
+  double wall_ms = 0.0;        // Startup 阶段的墙钟时间
+  double critical_path_ms = 0.0;
+  double launch_ms = 0.0;       // App 构造到 Startup 结束
+  double first_frame_ms = 0.0;  // App 构造到第一帧结束，尚未完成第一帧时为 0
+  uint32_t threads = 0;
+
+  // 根据 Startup 阶段最近一次运行的时间生成
+  static StartupTimeline build(const Schedule &schedule, uint64_t stage_start_ns,
+                               uint64_t stage_end_ns, std::thread::id main_thread) {
+    StartupTimeline timeline;
+    timeline.wall_ms = to_ms(stage_end_ns - stage_start_ns);
+
+    const auto &timings = schedule.timings(ScheduleLabel::Startup);
+    const auto path = schedule.critical_path(ScheduleLabel::Startup);
+
+    std::vector<std::thread::id> threads{main_thread};
+    for (size_t i = 0; i < timings.size(); ++i) {
+      const auto &timing = timings[i];
+      const auto &meta = schedule.system_meta(ScheduleLabel::Startup, i);
+
+      Entry entry;
+      entry.name = meta.profile_name ? meta.profile_name : meta.name;
+      entry.start_ms = to_ms(timing.start_ns - std::min(timing.start_ns, stage_start_ns));
+      entry.duration_ms = to_ms(timing.end_ns - timing.start_ns);
+      auto it = std::find(threads.begin(), threads.end(), timing.thread);
+      if (it == threads.end()) it = threads.insert(threads.end(), timing.thread);
+      entry.thread = static_cast<uint32_t>(it - threads.begin());
+      entry.critical = std::find(path.begin(), path.end(), i) != path.end();
+      if (entry.critical) timeline.critical_path_ms += entry.duration_ms;
+      timeline.entries.push_back(std::move(entry));
+    }
+    timeline.threads = static_cast<uint32_t>(threads.size());
+
+    std::stable_sort(timeline.entries.begin(), timeline.entries.end(),
+                     [](const Entry &a, const Entry &b) { return a.start_ms < b.start_ms; });
+    return timeline;
+  }
+
+  void report(std::ostream &out) const {
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+
+    out << "Startup timeline: wall " << wall_ms << " ms, critical path " << critical_path_ms
+        << " ms, " << entries.size() << " systems on " << threads << " thread(s)\n";
+    for (const auto &entry : entries) {
+      out << "  " << (entry.critical ? '*' : ' ') << " [" << std::setw(9) << entry.start_ms
+          << " +" << std::setw(9) << entry.duration_ms << " ms] t" << entry.thread << "  "
+          << entry.name << '\n';
+    }
+    out << "  (* = critical path)\n";
+
+    out.flags(flags);
+    out.precision(precision);
+  }
+
+private:
+  static double to_ms(uint64_t ns) { return static_cast<double>(ns) / 1.0e6; }
+};
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <entt/entt.hpp>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "Resources.h"
+#include "SystemParam.h"
+
+// 小缓冲区类型擦除的系统调用对象
+//
+// 与 std::function 相比：不可拷贝、只可移动；捕获较小的可调用对象（大多数系统 lambda、函数指针）
+// 直接存放在内部缓冲区中，不做堆分配；调用时只经过一次函数指针跳转。
+// 超出缓冲区大小或对齐要求的对象退回到堆上存放。
+class SystemFunction {
+public:
+  static constexpr size_t kInlineSize = 48;
+
+  SystemFunction() = default;
+
+  template <typename Fn, typename = std::enable_if_t<
+                             !std::is_same_v<std::decay_t<Fn>, SystemFunction>
+                             && std::is_invocable_v<std::decay_t<Fn> &, Resources &,
+                                                    entt::registry &, SystemMeta &>>>
+  SystemFunction(Fn &&fn) {  // NOLINT(google-explicit-constructor)
+    using Stored = std::decay_t<Fn>;
+    if constexpr (fits_inline<Stored>()) {
+      ::new (static_cast<void *>(&storage_)) Stored(std::forward<Fn>(fn));
+      ops_ = inline_ops<Stored>();
+    } else {
+      heap_ = new Stored(std::forward<Fn>(fn));
+      ops_ = heap_ops<Stored>();
+    }
+  }
+
+  SystemFunction(SystemFunction &&other) noexcept { move_from(other); }
+
+  SystemFunction &operator=(SystemFunction &&other) noexcept {
+    if (this != &other) {
+      reset();
+      move_from(other);
+    }
+    return *this;
+  }
+
+  SystemFunction(const SystemFunction &) = delete;
+  SystemFunction &operator=(const SystemFunction &) = delete;
+
+  ~SystemFunction() { reset(); }
+
+  void operator()(Resources &res, entt::registry &world, SystemMeta &meta) {
+    ops_->invoke(*this, res, world, meta);
+  }
+
+  explicit operator bool() const { return ops_ != nullptr; }
+
+private:
+  struct Ops {
+    void (*invoke)(SystemFunction &, Resources &, entt::registry &, SystemMeta &);
+    void (*move)(SystemFunction &dst, SystemFunction &src);
+    void (*destroy)(SystemFunction &);
+  };
+
+  template <typename T> static constexpr bool fits_inline() {
+    return sizeof(T) <= kInlineSize && alignof(T) <= alignof(std::max_align_t)
+           && std::is_nothrow_move_constructible_v<T>;
+  }
+
+  template <typename T> static T &inline_target(SystemFunction &self) {
+    return *std::launder(reinterpret_cast<T *>(&self.storage_));
+  }
+
+  template <typename T> static const Ops *inline_ops() {
+    static constexpr Ops ops = {
+        [](SystemFunction &self, Resources &res, entt::registry &world, SystemMeta &meta) {
+          inline_target<T>(self)(res, world, meta);
+        },
+        [](SystemFunction &dst, SystemFunction &src) {
+          ::new (static_cast<void *>(&dst.storage_)) T(std::move(inline_target<T>(src)));
+          inline_target<T>(src).~T();
+        },
+        [](SystemFunction &self) { inline_target<T>(self).~T(); },
+    };
+    return &ops;
+  }
+
+  template <typename T> static const Ops *heap_ops() {
+    static constexpr Ops ops = {
+        [](SystemFunction &self, Resources &res, entt::registry &world, SystemMeta &meta) {
+          (*static_cast<T *>(self.heap_))(res, world, meta);
+        },
+        [](SystemFunction &dst, SystemFunction &src) {
+          dst.heap_ = src.heap_;
+          src.heap_ = nullptr;
+        },
+        [](SystemFunction &self) { delete static_cast<T *>(self.heap_); },
+    };
+    return &ops;
+  }
+
+  void move_from(SystemFunction &other) noexcept {
+    ops_ = other.ops_;
+    if (ops_) {
+      ops_->move(*this, other);
+      other.ops_ = nullptr;
+    }
+  }
+
+  void reset() {
+    if (ops_) {
+      ops_->destroy(*this);
+      ops_ = nullptr;
+    }
+  }
+
+  const Ops *ops_ = nullptr;
+  union {
+    std::aligned_storage_t<kInlineSize, alignof(std::max_align_t)> storage_;
+    void *heap_;
+  };
+};
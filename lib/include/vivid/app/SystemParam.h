@@ -0,0 +1,526 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ChangeDetection.h"
+#include "Resources.h"
+
+// =============================================================================
+// 系统参数（System Params）
+//
+// 系统除了旧的 (Resources&, entt::registry&) 形式外，还可以直接声明类型化参数：
+//
+//   void move_system(Query<TransformComponent, const VelocityComponent> q, Res<Time> time);
+//   void upload_system(Query<const MeshComponent, Added<MeshComponent>> q, Removed<MeshComponent> gone);
+//
+// 调度器根据参数类型推导出每个系统读写了哪些组件和资源（SystemAccess），
+// 据此在同一个 ScheduleLabel 内构建冲突图，让互不冲突的系统并行执行。
+// =============================================================================
+
+// 系统的读写访问集合
+struct SystemAccess {
+  std::vector<entt::id_type> component_reads;
+  std::vector<entt::id_type> component_writes;
+  std::vector<entt::id_type> resource_reads;
+  std::vector<entt::id_type> resource_writes;
+
+  // 在并行执行前于主线程上执行的初始化：预先创建组件存储（entt 的存储是惰性创建的，
+  // 不能在工作线程上创建）、创建变更追踪器等
+  std::vector<void (*)(Resources &, entt::registry &)> initializers;
+
+  // 独占系统：需要完整的 Resources& / entt::registry&，与所有系统冲突
+  bool exclusive = false;
+
+  // 主线程系统：SDL / ImGui / WebGPU surface 等必须在主线程上运行
+  bool main_thread = false;
+
+  // 读取变更记录（Added / Changed / Removed），调度器据此决定变更历史可以丢弃到哪里
+  bool reads_changes = false;
+
+  template <typename T> void read_component() {
+    add_unique(component_reads, entt::type_hash<std::remove_const_t<T>>::value());
+    initializers.push_back(
+        [](Resources &, entt::registry &registry) { registry.storage<std::remove_const_t<T>>(); });
+  }
+
+  template <typename T> void write_component() {
+    add_unique(component_writes, entt::type_hash<T>::value());
+    initializers.push_back([](Resources &, entt::registry &registry) { registry.storage<T>(); });
+  }
+
+  // 读取组件 T 的变更记录
+  template <typename T> void read_changes() {
+    read_component<T>();
+    reads_changes = true;
+    initializers.push_back([](Resources &resources, entt::registry &registry) {
+      track_changes<std::remove_const_t<T>>(resources, registry);
+    });
+  }
+
+  template <typename T> void read_resource() {
+    add_unique(resource_reads, entt::type_hash<T>::value());
+  }
+
+  template <typename T> void write_resource() {
+    add_unique(resource_writes, entt::type_hash<T>::value());
+    // 预先创建资源槽：工作线程上插入资源时不会扩容 Resources 的槽数组
+    initializers.push_back([](Resources &resources, entt::registry &) { resources.handle<T>(); });
+  }
+
+  // 合并另一组访问（例如运行条件的访问）
+  void merge(const SystemAccess &other) {
+    for (auto id : other.component_reads) add_unique(component_reads, id);
+    for (auto id : other.component_writes) add_unique(component_writes, id);
+    for (auto id : other.resource_reads) add_unique(resource_reads, id);
+    for (auto id : other.resource_writes) add_unique(resource_writes, id);
+    initializers.insert(initializers.end(), other.initializers.begin(), other.initializers.end());
+    exclusive = exclusive || other.exclusive;
+    main_thread = main_thread || other.main_thread;
+    reads_changes = reads_changes || other.reads_changes;
+  }
+
+  // 两个系统是否不能同时运行
+  bool conflicts_with(const SystemAccess &other) const {
+    if (exclusive || other.exclusive) return true;
+    return overlaps(component_writes, other.component_writes)
+           || overlaps(component_writes, other.component_reads)
+           || overlaps(component_reads, other.component_writes)
+           || overlaps(resource_writes, other.resource_writes)
+           || overlaps(resource_writes, other.resource_reads)
+           || overlaps(resource_reads, other.resource_writes);
+  }
+
+private:
+  static void add_unique(std::vector<entt::id_type> &ids, entt::id_type id) {
+    for (auto existing : ids) {
+      if (existing == id) return;
+    }
+    ids.push_back(id);
+  }
+
+  static bool overlaps(const std::vector<entt::id_type> &a, const std::vector<entt::id_type> &b) {
+    for (auto x : a) {
+      for (auto y : b) {
+        if (x == y) return true;
+      }
+    }
+    return false;
+  }
+};
+
+// 每个系统的元数据，由调度器持有，在参数获取时传入
+struct SystemMeta {
+  std::string name;
+  SystemAccess access;
+
+  // 显式顺序约束（按系统名称），在冻结调度表时通过拓扑排序解析
+  std::vector<std::string> before;
+  std::vector<std::string> after;
+
+  // 上次运行时的变更 tick，Added / Changed / Removed 只返回此后的变更
+  uint64_t last_run_tick = 0;
+
+  // 未显式命名时取自可调用对象的类型名，仅用于性能分析显示，不参与顺序约束
+  std::string type_name;
+
+  // 性能分析器中显示的名称，添加系统时由 Profiler::intern 生成
+  const char *profile_name = nullptr;
+
+  // 系统私有状态（Local<T>、EventReader 的读取游标），第一次获取时创建
+  std::shared_ptr<Resources> locals;
+};
+
+// =============================================================================
+// 参数类型
+// =============================================================================
+
+// 变更过滤器，用在 Query 的参数列表中
+template <typename T> struct Added {};    // 自系统上次运行以来添加了 T
+template <typename T> struct Changed {};  // 自系统上次运行以来添加或修改（patch / replace）了 T
+
+namespace vivid_detail {
+
+  template <typename T> struct change_filter : std::false_type {};
+  template <typename T> struct change_filter<Added<T>> : std::true_type {
+    using component = T;
+  };
+  template <typename T> struct change_filter<Changed<T>> : std::true_type {
+    using component = T;
+  };
+
+  template <typename T> inline constexpr bool is_change_filter_v = change_filter<T>::value;
+
+  // 从 Query 的参数中挑出组件与过滤器
+  template <typename... Terms> struct query_terms {
+    using components = decltype(std::tuple_cat(
+        std::declval<std::conditional_t<is_change_filter_v<Terms>, std::tuple<>,
+                                        std::tuple<Terms>>>()...));
+    using filters = decltype(std::tuple_cat(
+        std::declval<std::conditional_t<is_change_filter_v<Terms>, std::tuple<Terms>,
+                                        std::tuple<>>>()...));
+  };
+
+  template <typename Tuple> struct view_of;
+  template <typename... Components> struct view_of<std::tuple<Components...>> {
+    static auto get(entt::registry &world) { return world.view<Components...>(); }
+  };
+
+}  // namespace vivid_detail
+
+// 组件查询：Query<const A, B> 只读 A、读写 B
+// 可以附加变更过滤器：Query<const A, Changed<A>> 只遍历自系统上次运行以来 A 被添加或修改的实体
+template <typename... Terms> class Query {
+private:
+  using Components = typename vivid_detail::query_terms<Terms...>::components;
+  using Filters = typename vivid_detail::query_terms<Terms...>::filters;
+  static_assert(std::tuple_size_v<Components> > 0, "Query needs at least one component");
+
+  entt::registry *world_;
+  Resources *resources_;
+  uint64_t last_run_tick_;
+
+  template <typename Filter> bool passes(entt::entity entity) const {
+    using T = typename vivid_detail::change_filter<Filter>::component;
+    auto *tracker = resources_->get<ComponentTracker<T>>();
+    if (!tracker) return false;
+    if constexpr (std::is_same_v<Filter, Added<T>>) {
+      return tracker->added_since(entity, last_run_tick_);
+    } else {
+      return tracker->changed_since(entity, last_run_tick_);
+    }
+  }
+
+  template <typename View, typename Fn>
+  void invoke(const View &view, entt::entity entity, Fn &fn) const {
+    std::apply(
+        [&](auto &&...components) {
+          if constexpr (std::is_invocable_v<Fn &, entt::entity, decltype(components)...>) {
+            fn(entity, std::forward<decltype(components)>(components)...);
+          } else {
+            fn(std::forward<decltype(components)>(components)...);
+          }
+        },
+        view.get(entity));
+  }
+
+  // 以第一个过滤器的变更日志为驱动，只访问被触碰过的实体
+  template <typename... Fs, typename Fn> void each_filtered(std::tuple<Fs...> *, Fn &fn) const {
+    using Leading = std::tuple_element_t<0, std::tuple<Fs...>>;
+    using T = typename vivid_detail::change_filter<Leading>::component;
+    auto *tracker = resources_ ? resources_->get<ComponentTracker<T>>() : nullptr;
+    if (!tracker) return;
+
+    auto view = this->view();
+    auto visit = [&](entt::entity entity) {
+      if (!view.contains(entity)) return;
+      if (!(passes<Fs>(entity) && ...)) return;
+      invoke(view, entity, fn);
+    };
+    if constexpr (std::is_same_v<Leading, Added<T>>) {
+      tracker->each_added(last_run_tick_, visit);
+    } else {
+      tracker->each_changed(last_run_tick_, visit);
+    }
+  }
+
+public:
+  explicit Query(entt::registry &world, Resources *resources = nullptr, uint64_t last_run_tick = 0)
+      : world_(&world), resources_(resources), last_run_tick_(last_run_tick) {}
+
+  // 不含过滤器的完整视图
+  auto view() const { return vivid_detail::view_of<Components>::get(*world_); }
+
+  template <typename Fn> void each(Fn &&fn) const {
+    if constexpr (std::tuple_size_v<Filters> == 0) {
+      view().each(std::forward<Fn>(fn));
+    } else {
+      each_filtered(static_cast<Filters *>(nullptr), fn);
+    }
+  }
+
+  entt::registry &world() const { return *world_; }
+};
+
+namespace vivid_detail {
+
+  // 拥有型分组的句柄，缓存为资源
+  template <typename... Owned> struct OwningGroup {
+    using handle_type = decltype(std::declval<entt::registry &>().group<Owned...>());
+    handle_type group;
+  };
+
+}  // namespace vivid_detail
+
+// 取得 Owned... 的拥有型分组，第一次调用时创建并把句柄缓存到 res。
+// 创建分组会重排这些组件的存储，只能在主线程上、没有其他系统运行时调用（插件构建、冻结调度表、独占系统）
+template <typename... Owned> auto owning_group(Resources &res, entt::registry &world) {
+  using Cache = vivid_detail::OwningGroup<std::remove_const_t<Owned>...>;
+  if (auto *cache = res.get<Cache>()) return cache->group;
+  return res.insert<Cache>(Cache{world.group<std::remove_const_t<Owned>...>()}).group;
+}
+
+// 拥有型分组查询：Group<TransformComponent, const MaterialComponent>
+//
+// 分组拥有这些组件的存储，把同时拥有全部组件的实体排在每个存储的前部且顺序一致，
+// 遍历时是几组紧密排列的数组同步前进，不需要视图那样逐个实体查稀疏集。
+// 分组在冻结调度表时创建一次，之后每次获取只读取缓存的句柄。
+// 限制：一种组件只能属于一个拥有型分组；添加或移除被拥有的组件会同时重排分组内所有存储，
+// 只能在独占系统中或通过 Commands（在阶段之间应用）进行。
+template <typename... Owned> class Group {
+public:
+  using handle_type =
+      typename vivid_detail::OwningGroup<std::remove_const_t<Owned>...>::handle_type;
+
+private:
+  handle_type group_;
+
+public:
+  explicit Group(handle_type group) : group_(group) {}
+
+  // fn(entity, components...) 或 fn(components...)
+  template <typename Fn> void each(Fn &&fn) const { group_.each(std::forward<Fn>(fn)); }
+
+  size_t size() const { return group_.size(); }
+  bool empty() const { return size() == 0; }
+  const handle_type &handle() const { return group_; }
+};
+
+// 自系统上次运行以来移除了组件 T 的实体（实体本身可能已被销毁）
+template <typename T> class Removed {
+private:
+  const ComponentTracker<T> *tracker_;
+  uint64_t last_run_tick_;
+
+public:
+  Removed(const ComponentTracker<T> *tracker, uint64_t last_run_tick)
+      : tracker_(tracker), last_run_tick_(last_run_tick) {}
+
+  template <typename Fn> void each(Fn &&fn) const {
+    if (tracker_) tracker_->each_removed(last_run_tick_, fn);
+  }
+
+  bool empty() const { return !tracker_ || tracker_->last_removed() <= last_run_tick_; }
+};
+
+// 只读资源
+template <typename T> class Res {
+private:
+  const T *ptr_;
+
+public:
+  explicit Res(const T *ptr) : ptr_(ptr) {}
+
+  const T *get() const { return ptr_; }
+  const T *operator->() const { return ptr_; }
+  const T &operator*() const { return *ptr_; }
+  explicit operator bool() const { return ptr_ != nullptr; }
+};
+
+// 可写资源
+template <typename T> class ResMut {
+private:
+  T *ptr_;
+
+public:
+  explicit ResMut(T *ptr) : ptr_(ptr) {}
+
+  T *get() const { return ptr_; }
+  T *operator->() const { return ptr_; }
+  T &operator*() const { return *ptr_; }
+  explicit operator bool() const { return ptr_ != nullptr; }
+};
+
+// 主线程标记：声明此参数的系统始终在主线程上执行
+struct MainThread {};
+
+// 系统私有状态：每个系统各自一份，跨帧保留，不参与冲突检测
+template <typename T> class Local {
+private:
+  T *ptr_;
+
+public:
+  explicit Local(T *ptr) : ptr_(ptr) {}
+
+  T *get() const { return ptr_; }
+  T *operator->() const { return ptr_; }
+  T &operator*() const { return *ptr_; }
+};
+
+namespace vivid_detail {
+
+  template <typename T> T &system_local(SystemMeta &meta) {
+    if (!meta.locals) meta.locals = std::make_shared<Resources>();
+    if (auto *value = meta.locals->get<T>()) return *value;
+    return meta.locals->insert<T>();
+  }
+
+}  // namespace vivid_detail
+
+// =============================================================================
+// 参数特征：每种参数类型如何声明访问、如何获取
+// =============================================================================
+
+template <typename T, typename = void> struct SystemParam;
+
+template <typename... Terms> struct SystemParam<Query<Terms...>> {
+  static void access(SystemAccess &access) { (register_term<Terms>(access), ...); }
+
+  static Query<Terms...> fetch(Resources &res, entt::registry &world, SystemMeta &meta) {
+    return Query<Terms...>(world, &res, meta.last_run_tick);
+  }
+
+private:
+  template <typename C> static void register_term(SystemAccess &access) {
+    if constexpr (vivid_detail::is_change_filter_v<C>) {
+      access.read_changes<typename vivid_detail::change_filter<C>::component>();
+    } else if constexpr (std::is_const_v<C>) {
+      access.read_component<C>();
+    } else {
+      access.write_component<C>();
+    }
+  }
+};
+
+template <typename... Owned> struct SystemParam<Group<Owned...>> {
+  static void access(SystemAccess &access) {
+    (register_owned<Owned>(access), ...);
+    access.initializers.push_back(
+        [](Resources &res, entt::registry &world) { owning_group<Owned...>(res, world); });
+  }
+
+  static Group<Owned...> fetch(Resources &res, entt::registry &world, SystemMeta &) {
+    return Group<Owned...>(owning_group<Owned...>(res, world));
+  }
+
+private:
+  template <typename C> static void register_owned(SystemAccess &access) {
+    if constexpr (std::is_const_v<C>) {
+      access.read_component<C>();
+    } else {
+      access.write_component<C>();
+    }
+  }
+};
+
+template <typename T> struct SystemParam<Removed<T>> {
+  static void access(SystemAccess &access) { access.read_changes<T>(); }
+
+  static Removed<T> fetch(Resources &res, entt::registry &, SystemMeta &meta) {
+    return Removed<T>(res.get<ComponentTracker<T>>(), meta.last_run_tick);
+  }
+};
+
+template <typename T> struct SystemParam<Res<T>> {
+  static void access(SystemAccess &access) { access.read_resource<T>(); }
+
+  static Res<T> fetch(Resources &res, entt::registry &, SystemMeta &) {
+    return Res<T>(res.get<T>());
+  }
+};
+
+template <typename T> struct SystemParam<ResMut<T>> {
+  static void access(SystemAccess &access) { access.write_resource<T>(); }
+
+  static ResMut<T> fetch(Resources &res, entt::registry &, SystemMeta &) {
+    return ResMut<T>(res.get<T>());
+  }
+};
+
+template <> struct SystemParam<MainThread> {
+  static void access(SystemAccess &access) { access.main_thread = true; }
+
+  static MainThread fetch(Resources &, entt::registry &, SystemMeta &) { return {}; }
+};
+
+template <typename T> struct SystemParam<Local<T>> {
+  static void access(SystemAccess &) {}
+
+  static Local<T> fetch(Resources &, entt::registry &, SystemMeta &meta) {
+    return Local<T>(&vivid_detail::system_local<T>(meta));
+  }
+};
+
+// =============================================================================
+// 可调用对象参数推导
+// =============================================================================
+
+namespace vivid_detail {
+
+  template <typename T, typename = void> struct callable_traits {
+    static constexpr bool valid = false;
+  };
+
+  template <typename R, typename... Args> struct callable_traits<R (*)(Args...)> {
+    static constexpr bool valid = true;
+    using args = std::tuple<Args...>;
+  };
+
+  template <typename R, typename... Args> struct callable_traits<R(Args...)>
+      : callable_traits<R (*)(Args...)> {};
+
+  template <typename C, typename R, typename... Args> struct callable_traits<R (C::*)(Args...)>
+      : callable_traits<R (*)(Args...)> {};
+
+  template <typename C, typename R, typename... Args>
+  struct callable_traits<R (C::*)(Args...) const> : callable_traits<R (*)(Args...)> {};
+
+  template <typename T>
+  struct callable_traits<T, std::void_t<decltype(&T::operator())>>
+      : callable_traits<decltype(&T::operator())> {};
+
+  template <typename T, typename = void> struct is_system_param : std::false_type {};
+
+  template <typename T>
+  struct is_system_param<T, std::void_t<decltype(SystemParam<T>::access)>> : std::true_type {};
+
+  template <typename Tuple> struct all_system_params;
+
+  template <typename... Args> struct all_system_params<std::tuple<Args...>> {
+    static constexpr bool value = (is_system_param<std::decay_t<Args>>::value && ...);
+  };
+
+  template <typename Fn, typename = void> struct is_param_system : std::false_type {};
+
+  template <typename Fn>
+  struct is_param_system<Fn, std::enable_if_t<callable_traits<std::decay_t<Fn>>::valid>>
+      : all_system_params<typename callable_traits<std::decay_t<Fn>>::args> {};
+
+  template <typename Tuple> struct param_list;
+
+  template <typename... Args> struct param_list<std::tuple<Args...>> {
+    static void access(SystemAccess &access) {
+      (SystemParam<std::decay_t<Args>>::access(access), ...);
+    }
+
+    template <typename Fn>
+    static void invoke(Fn &fn, Resources &res, entt::registry &world, SystemMeta &meta) {
+      fn(SystemParam<std::decay_t<Args>>::fetch(res, world, meta)...);
+    }
+  };
+
+  template <typename Fn> using params_of
+      = param_list<typename callable_traits<std::decay_t<Fn>>::args>;
+
+}  // namespace vivid_detail
+
+template <typename Fn> inline constexpr bool is_param_system_v
+    = vivid_detail::is_param_system<Fn>::value;
+
+// 根据系统参数列表推导访问集合
+template <typename Fn> SystemAccess deduce_system_access() {
+  SystemAccess access;
+  vivid_detail::params_of<Fn>::access(access);
+  return access;
+}
+
+// 获取参数并调用类型化系统
+template <typename Fn>
+void invoke_param_system(Fn &fn, Resources &res, entt::registry &world, SystemMeta &meta) {
+  vivid_detail::params_of<Fn>::invoke(fn, res, world, meta);
+}
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// 工作窃取线程池
+//
+// 由 App 作为资源插入（Resources::get<TaskPool>()），既被调度器用来并行执行互不冲突的系统，
+// 也供系统内部使用 parallel_for / parallel_each 拆分大循环，两者共享同一组线程，不会超额订阅。
+// 线程在第一次提交任务时才创建，未使用并行执行的应用不会产生额外线程。
+//
+// 每个工作线程有自己的双端队列：本线程从尾部取任务，空闲线程从其它队列头部窃取；
+// 非工作线程（主线程）提交的任务进入全局注入队列。
+// 等待任务完成的线程（wait / parallel_for）会一边等待一边执行队列中的任务，
+// 所以在工作线程上运行的系统嵌套调用 parallel_for 也不会死锁。
+class TaskPool {
+public:
+  using Task = std::function<void()>;
+
+private:
+  struct TaskNode {
+    Task fn;
+    std::atomic<size_t> pending{1};
+    std::mutex mutex;
+    std::vector<std::shared_ptr<TaskNode>> continuations;
+    std::exception_ptr error;
+    bool done = false;
+  };
+
+public:
+  // 可等待、可追加后续任务的任务句柄
+  class TaskHandle {
+  public:
+    TaskHandle() = default;
+
+    bool valid() const { return node_ != nullptr; }
+
+    bool is_done() const {
+      if (!node_) return true;
+      std::lock_guard<std::mutex> lock(node_->mutex);
+      return node_->done;
+    }
+
+  private:
+    friend class TaskPool;
+    explicit TaskHandle(std::shared_ptr<TaskNode> node) : node_(std::move(node)) {}
+
+    std::shared_ptr<TaskNode> node_;
+  };
+
+  // thread_count 为 0 时使用 hardware_concurrency - 1（主线程也参与执行）
+  explicit TaskPool(size_t thread_count = 0);
+  ~TaskPool();
+
+  TaskPool(const TaskPool &) = delete;
+  TaskPool &operator=(const TaskPool &) = delete;
+
+  // 提交一个任务（不可等待）
+  void submit(Task task);
+
+  // 提交一个任务，在 dependencies 全部完成后才会执行
+  TaskHandle spawn(Task task, std::initializer_list<TaskHandle> dependencies = {});
+
+  // 在 handle 完成后执行 task（续体）
+  TaskHandle then(const TaskHandle &handle, Task task) { return spawn(std::move(task), {handle}); }
+
+  // 等待任务完成，等待期间当前线程会帮忙执行其它任务；任务抛出的异常在这里重新抛出
+  void wait(const TaskHandle &handle);
+
+  // 尝试从队列中取出并执行一个任务，没有任务时返回 false
+  bool try_run_one();
+
+  // 工作线程数量（不包括主线程）
+  size_t thread_count() const { return thread_count_; }
+
+  // 将 [begin, end) 按 chunk_size 分块并行执行 fn(chunk_begin, chunk_end)，返回时全部完成
+  template <typename Fn>
+  void parallel_for_chunks(size_t begin, size_t end, size_t chunk_size, Fn &&fn) {
+    if (end <= begin) return;
+    chunk_size = std::max<size_t>(chunk_size, 1);
+    const size_t chunk_count = (end - begin + chunk_size - 1) / chunk_size;
+    if (chunk_count == 1 || thread_count_ == 0) {
+      fn(begin, end);
+      return;
+    }
+
+    std::atomic<size_t> remaining{chunk_count - 1};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    for (size_t chunk = 1; chunk < chunk_count; ++chunk) {
+      const size_t chunk_begin = begin + chunk * chunk_size;
+      const size_t chunk_end = std::min(end, chunk_begin + chunk_size);
+      submit([&, chunk_begin, chunk_end] {
+        try {
+          fn(chunk_begin, chunk_end);
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(error_mutex);
+          if (!error) error = std::current_exception();
+        }
+        remaining.fetch_sub(1, std::memory_order_acq_rel);
+      });
+    }
+
+    // 当前线程执行第一块，然后帮忙执行剩余任务直到全部完成
+    try {
+      fn(begin, std::min(end, begin + chunk_size));
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(error_mutex);
+      if (!error) error = std::current_exception();
+    }
+    while (remaining.load(std::memory_order_acquire) > 0) {
+      if (!try_run_one()) std::this_thread::yield();
+    }
+
+    if (error) std::rethrow_exception(error);
+  }
+
+  // 并行执行 fn(i)，i ∈ [begin, end)
+  template <typename Fn> void parallel_for(size_t begin, size_t end, size_t chunk_size, Fn &&fn) {
+    parallel_for_chunks(begin, end, chunk_size, [&fn](size_t chunk_begin, size_t chunk_end) {
+      for (size_t i = chunk_begin; i < chunk_end; ++i) {
+        fn(i);
+      }
+    });
+  }
+
+  // 并行遍历 entt 视图：fn(entity, components...) 或 fn(components...)
+  // 按视图的主存储（最小的那个存储）的稠密数组分块，每块在一个线程上顺序执行。
+  // 回调中不能对注册表做结构性修改（创建/销毁实体、添加/移除组件）。
+  template <typename View, typename Fn> void parallel_each(const View &view, size_t chunk_size,
+                                                           Fn &&fn) {
+    const auto *leading = view.handle();
+    if (!leading) return;
+
+    parallel_for_chunks(0, leading->size(), chunk_size, [&](size_t chunk_begin, size_t chunk_end) {
+      for (size_t pos = chunk_begin; pos < chunk_end; ++pos) {
+        const auto entity = (*leading)[pos];
+        if (!view.contains(entity)) continue;
+        std::apply(
+            [&](auto &&...components) {
+              if constexpr (std::is_invocable_v<Fn &, decltype(entity), decltype(components)...>) {
+                fn(entity, std::forward<decltype(components)>(components)...);
+              } else {
+                fn(std::forward<decltype(components)>(components)...);
+              }
+            },
+            view.get(entity));
+      }
+    });
+  }
+
+private:
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  void ensure_started();
+  void worker_loop(size_t index);
+  void push(Task task);
+  bool pop(Task &task);
+  void schedule_node(std::shared_ptr<TaskNode> node);
+  void run_node(const std::shared_ptr<TaskNode> &node);
+  size_t current_worker() const;
+
+  size_t thread_count_;
+  std::vector<std::thread> threads_;
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  WorkerQueue global_;
+  std::once_flag started_;
+
+  std::atomic<size_t> queued_{0};
+  std::mutex sleep_mutex_;
+  std::condition_variable sleep_cv_;
+  std::atomic<bool> stopping_{false};
+};
+
+using TaskHandle = TaskPool::TaskHandle;
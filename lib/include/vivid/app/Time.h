@@ -0,0 +1,133 @@
+#pragma once
+
+#include <SDL3/SDL_timer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// =============================================================================
+// 时间资源
+//
+// App 在每帧开始时用 SDL_GetPerformanceCounter 更新 Time，系统通过 Res<Time> 读取：
+//
+//   void move_system(Res<Time> time, Query<TransformComponent, const VelocityComponent> q) {
+//     q.each([&](auto, auto &transform, const auto &velocity) {
+//       transform.Position += velocity.Value * time->delta();
+//     });
+//   }
+//
+// 固定步长：每帧把 delta 累加到累加器中，累加器每攒够一个 fixed_delta 就运行一次
+// ScheduleLabel::FixedUpdate。一帧最多运行 max_substeps 次，超出的积压直接丢弃，
+// 避免模拟跟不上时越积越多（spiral of death）。FixedUpdate 中的系统应使用 fixed_delta()。
+// 渲染阶段用 alpha() = 剩余累加量 / fixed_delta 在上一步与当前步的状态之间插值。
+//
+// set_frame_delta() 之后 update() 不再读取时钟，每帧按给定的间隔前进（输入回放时使用），
+// 同一段输入因此在任何机器上都产生相同的模拟结果；clear_frame_delta() 恢复实测间隔。
+// =============================================================================
+class Time {
+private:
+  uint64_t frequency_ = SDL_GetPerformanceFrequency();
+  uint64_t start_ = SDL_GetPerformanceCounter();
+  uint64_t last_ = start_;
+
+  double delta_ = 0.0;
+  double elapsed_ = 0.0;
+  uint64_t frame_count_ = 0;
+
+  // 单帧 delta 上限：断点调试、窗口拖动等造成的长停顿不会变成一次巨大的步进
+  double max_delta_ = 0.25;
+
+  // 指定的帧间隔，has_frame_delta_ 为 false 时使用实测间隔
+  double frame_delta_ = 0.0;
+  bool has_frame_delta_ = false;
+
+  double fixed_delta_ = 1.0 / 60.0;
+  uint32_t max_substeps_ = 8;
+  double accumulator_ = 0.0;
+  double fixed_elapsed_ = 0.0;
+  uint64_t fixed_step_count_ = 0;
+  uint32_t substeps_ = 0;
+  double alpha_ = 0.0;
+
+public:
+  // 帧间隔（秒），已按 max_delta 截断
+  float delta() const { return static_cast<float>(delta_); }
+  double delta_f64() const { return delta_; }
+
+  // 自第一帧开始累计的时间（秒）
+  double elapsed() const { return elapsed_; }
+  uint64_t frame_count() const { return frame_count_; }
+
+  // 固定步长（秒）及固定步累计时间
+  float fixed_delta() const { return static_cast<float>(fixed_delta_); }
+  double fixed_delta_f64() const { return fixed_delta_; }
+  double fixed_elapsed() const { return fixed_elapsed_; }
+  uint64_t fixed_step_count() const { return fixed_step_count_; }
+
+  // 本帧运行的固定步数
+  uint32_t substeps() const { return substeps_; }
+
+  // 渲染插值系数，取值 [0, 1)
+  float alpha() const { return static_cast<float>(alpha_); }
+
+  void set_fixed_timestep(double seconds) {
+    if (seconds > 0.0) fixed_delta_ = seconds;
+  }
+  void set_fixed_hz(double hz) {
+    if (hz > 0.0) fixed_delta_ = 1.0 / hz;
+  }
+  void set_max_substeps(uint32_t count) { max_substeps_ = std::max<uint32_t>(count, 1); }
+  void set_max_delta(double seconds) {
+    if (seconds > 0.0) max_delta_ = seconds;
+  }
+
+  // 下一次 update() 起每帧前进 seconds 秒（仍按 max_delta 截断），允许为 0
+  void set_frame_delta(double seconds) {
+    frame_delta_ = std::max(seconds, 0.0);
+    has_frame_delta_ = true;
+  }
+  void clear_frame_delta() { has_frame_delta_ = false; }
+  bool has_frame_delta() const { return has_frame_delta_; }
+
+  // 读取性能计数器并开始新的一帧；第一帧的 delta 为 0，启动耗时不计入模拟。
+  // 设置了帧间隔时仍记录时钟，清除后的第一帧不会把回放期间的时间算进 delta
+  void update() {
+    const uint64_t now = SDL_GetPerformanceCounter();
+    if (has_frame_delta_) {
+      last_ = now;
+      advance(frame_delta_);
+      return;
+    }
+    const double delta
+        = frame_count_ == 0 ? 0.0 : static_cast<double>(now - last_) / static_cast<double>(frequency_);
+    last_ = now;
+    advance(delta);
+  }
+
+  // 以给定的 delta 开始新的一帧（不读取时钟）
+  void advance(double delta) {
+    delta_ = std::clamp(delta, 0.0, max_delta_);
+    elapsed_ += delta_;
+    ++frame_count_;
+    accumulator_ += delta_;
+    substeps_ = 0;
+  }
+
+  // 尝试消耗一个固定步：返回 true 时调用方运行一次 FixedUpdate。
+  // 返回 false 时本帧的固定步结束，丢弃超出上限的积压并计算插值系数。
+  bool consume_fixed_step() {
+    if (accumulator_ >= fixed_delta_ && substeps_ < max_substeps_) {
+      accumulator_ -= fixed_delta_;
+      fixed_elapsed_ += fixed_delta_;
+      ++fixed_step_count_;
+      ++substeps_;
+      return true;
+    }
+    if (accumulator_ >= fixed_delta_) {
+      accumulator_ = std::fmod(accumulator_, fixed_delta_);
+    }
+    alpha_ = accumulator_ / fixed_delta_;
+    return false;
+  }
+};
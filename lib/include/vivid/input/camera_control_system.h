@@ -0,0 +1,29 @@
+#pragma once
+
+#include <SDL3/SDL_events.h>
+
+#include "vivid/app/App.h"
+#include "vivid/input/camera_controller.h"
+#include "vivid/rendering/render_component.h"
+
+namespace VIVID::Input {
+
+  // 按住的移动键和鼠标右键，跨帧保留
+  struct CameraInputState {
+    bool forward = false;
+    bool back = false;
+    bool left = false;
+    bool right = false;
+    bool up = false;
+    bool down = false;
+    bool looking = false;
+  };
+
+  // SDL 事件驱动的相机控制（InputSystem 的 SDL 版本）：WASD 平移，Q/E 升降，
+  // 按住鼠标右键拖动转向，滚轮沿视线方向缩放。只读取 Events<SDL_Event>，
+  // 因此录制的输入回放时得到与录制时相同的相机轨迹。
+  void camera_control_system(EventReader<SDL_Event> events, Res<Time> time,
+                             Query<TransformComponent, CameraControllerComponent> cameras,
+                             Local<CameraInputState> state);
+
+}  // namespace VIVID::Input
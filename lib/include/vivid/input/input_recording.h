@@ -0,0 +1,111 @@
+#pragma once
+
+#include <SDL3/SDL_events.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "vivid/app/App.h"
+
+namespace VIVID::Input {
+
+  // ===========================================================================
+  // 输入录制与回放
+  //
+  // 录制：每帧在 Event 阶段记下 Time 的帧间隔和本帧读到的 SDL 输入事件（键盘、鼠标、手柄），
+  // 关闭时写成紧凑的二进制文件：
+  //
+  //   FileHeader | 帧 0: f64 delta, u32 事件数, 事件... | 帧 1 | ...
+  //
+  // 每个事件存为 u16 字节数 + SDL_Event 中该类事件结构体的字节，而不是整个 128 字节的联合体。
+  // 文件头记录 sizeof(SDL_Event)，SDL 版本改变了事件布局时拒绝加载。
+  //
+  // 回放：每帧结束时（Cleanup）把下一帧的事件原样写入 Events<SDL_Event>，
+  // 并用 Time::set_frame_delta 让下一帧按录制的间隔（或固定步长）前进，
+  // 事件因此与录制时一样在 Event 阶段被读到，读取者无需区分实时输入和回放。
+  // 回放期间实时的输入事件被过滤掉（窗口事件仍然保留），回放结束后可以发送 AppExit 退出。
+  //
+  //   app.add_plugin<InputRecordingPlugin>(InputRecordingConfig::record("flythrough.vinput"));
+  //   app.add_plugin<InputRecordingPlugin>(InputRecordingConfig::replay("flythrough.vinput"));
+  //
+  // 事件中的指针（文本输入、拖放文件、用户事件等）无法保存，这些事件不会被录制。
+  // ===========================================================================
+
+  struct InputRecordingHeader {
+    char magic[8] = {'V', 'I', 'V', 'I', 'D', 'I', 'N', 'P'};
+    uint32_t version = 0;
+    uint32_t event_size = 0;  // sizeof(SDL_Event)
+    uint64_t frame_count = 0;
+    uint64_t event_count = 0;
+  };
+  static_assert(sizeof(InputRecordingHeader) == 32);
+
+  class InputRecording {
+  public:
+    static constexpr uint32_t kFormatVersion = 1;
+
+    struct Frame {
+      double delta = 0.0;
+      uint32_t first_event = 0;
+      uint32_t event_count = 0;
+    };
+
+    // 只录制不含指针的输入事件
+    static bool recordable(const SDL_Event &event);
+
+    // 开始新的一帧，之后 add_event 的事件属于这一帧
+    void begin_frame(double delta);
+    void add_event(const SDL_Event &event);
+
+    size_t frame_count() const { return frames_.size(); }
+    size_t event_count() const { return events_.size(); }
+    const Frame &frame(size_t index) const { return frames_[index]; }
+    const SDL_Event *frame_events(size_t index) const {
+      return events_.data() + frames_[index].first_event;
+    }
+
+    // 录制的总时长（秒）
+    double duration() const;
+
+    void clear();
+
+    std::vector<std::byte> serialize() const;
+    bool deserialize(const std::byte *data, size_t size);
+    bool save(const std::string &path) const;
+    bool load(const std::string &path);
+
+  private:
+    std::vector<Frame> frames_;
+    std::vector<SDL_Event> events_;
+  };
+
+  // 录制资源：Shutdown 阶段写入 path
+  struct InputRecorder {
+    std::string path;
+    InputRecording recording;
+  };
+
+  // 回放资源
+  struct InputReplay {
+    InputRecording recording;
+    size_t next_frame = 0;
+    double fixed_delta = 0.0;  // > 0 时每帧按此步长前进，忽略录制的帧间隔
+    bool exit_at_end = true;
+    bool finished = false;
+  };
+
+  // Event 阶段：记录本帧的帧间隔和输入事件
+  void record_input_system(EventReader<SDL_Event> events, Res<Time> time,
+                           ResMut<InputRecorder> recorder);
+
+  // Shutdown 阶段：写入录制文件
+  void save_input_recording_system(ResMut<InputRecorder> recorder);
+
+  // Startup 和 Cleanup 阶段：写入下一帧的事件并设置其帧间隔；录制用完后恢复实测时间，
+  // exit_at_end 时发送 AppExit
+  void replay_input_system(ResMut<InputReplay> replay, ResMut<Events<SDL_Event>> events,
+                           ResMut<Time> time, EventWriter<AppExit> exit);
+
+}  // namespace VIVID::Input
@@ -11,7 +11,7 @@ class InputSystem
 {
 public:
     static void Initialize(GLFWwindow* window);
-    static void Update(entt::registry& registry);
+    static void Update(entt::registry& registry, float deltaTime);
     static void Shutdown();
     
     static void SetWindow(GLFWwindow* window) { s_Window = window; }
@@ -11,6 +11,7 @@
 #include <SDL3/SDL_error.h>
 #include <SDL3/SDL_log.h>
 
+#include <cstdarg>
 #include <functional>
 #include <memory>
 #include <string>
@@ -74,10 +75,18 @@ struct VividLogConfig {
 
 // VIVID 日志管理器类
 class VividLogger {
+public:
+  // 线程日志输出函数：message 为格式化后的一行日志
+  using ThreadSink = void (*)(void* userdata, VividLogCategory category, VividLogLevel level,
+                              const char* message);
+
 private:
   static VividLogConfig config_;
   static bool initialized_;
 
+  // 所有日志函数的出口：当前线程设置了 ThreadSink 时交给它，否则交给 SDL
+  static void write(int category, SDL_LogPriority priority, const char* format, va_list args);
+
 public:
   // 初始化日志系统
   static void initialize(const VividLogConfig& config = VividLogConfig{});
@@ -94,6 +103,10 @@ public:
   // 重置所有日志级别为默认值
   static void reset_priorities();
 
+  // 把当前线程之后的日志交给 sink（nullptr 恢复为 SDL 输出）。
+  // 用于多个世界并行运行时按世界分别收集日志（见 BatchRunner），各线程互不影响
+  static void set_thread_sink(ThreadSink sink, void* userdata = nullptr);
+
   // 通用日志输出函数
   static void log(VividLogCategory category, VividLogLevel level, const char* format, ...);
 
@@ -1,12 +1,22 @@
 #pragma once
 #include "PxPhysicsAPI.h" // PhysX header
+#include "vivid/rendering/render_component.h"
 
-// 简单的变换组件（位置）
-struct TransformComponent
+// 物理与渲染共用 render_component.h 的 TransformComponent：位置和四元数与 PxTransform 的
+// p / q 逐分量对应，两边的位姿互相复制即可，不需要欧拉角转换（缩放不参与物理）
+inline physx::PxTransform ToPxTransform(const TransformComponent &transform)
 {
-    physx::PxVec3 position{0.0f, 0.0f, 0.0f};
-    // 可扩展旋转等
-};
+    return physx::PxTransform(
+        physx::PxVec3(transform.Position.x, transform.Position.y, transform.Position.z),
+        physx::PxQuat(transform.Rotation.x, transform.Rotation.y, transform.Rotation.z,
+                      transform.Rotation.w));
+}
+
+inline void CopyPose(const physx::PxTransform &pose, TransformComponent &transform)
+{
+    transform.Position = glm::vec3(pose.p.x, pose.p.y, pose.p.z);
+    transform.Rotation = glm::quat(pose.q.w, pose.q.x, pose.q.y, pose.q.z);
+}
 
 // 代表一个刚体物理对象
 struct RigidBodyComponent
@@ -2,9 +2,12 @@
 #include "entt/entt.hpp"
 #include "physics_component.h"
 #include "PxPhysicsAPI.h"
+#include "vivid/app/TaskPool.h"
 
 // 物理系统：推进物理世界，并同步状态回ECS
-void physics_system(entt::registry &registry, physx::PxScene &scene, float deltaTime)
+// 传入 pool 时，位姿同步按块分发到线程池（fetchResults 之后只读 PhysX 场景，可以并发）
+void physics_system(entt::registry &registry, physx::PxScene &scene, float deltaTime,
+                    TaskPool *pool = nullptr)
 {
     // 1. 推进物理模拟
     scene.simulate(deltaTime);
@@ -13,19 +16,21 @@ void physics_system(entt::registry &registry, physx::PxScene &scene, float delta
     // 2. 将物理世界的状态同步回ECS组件
     //    这样渲染系统就能画出正确的位置
     auto view = registry.view<TransformComponent, const RigidBodyComponent>();
-    for (auto [entity, transform, rigidbody] : view.each())
+    auto sync_pose = [](TransformComponent &transform, const RigidBodyComponent &rigidbody)
     {
         if (rigidbody.actor && rigidbody.actor->is<physx::PxRigidDynamic>())
         {
-            physx::PxTransform physx_transform = rigidbody.actor->getGlobalPose();
-
-            // 更新我们自己的TransformComponent
-            transform.position.x = physx_transform.p.x;
-            transform.position.y = physx_transform.p.y;
-            transform.position.z = physx_transform.p.z;
-
-            // 如果需要，同样更新旋转 (Quaternion)
-            // transform.rotation = ...
+            // 位置和旋转（四元数）直接复制到TransformComponent
+            CopyPose(rigidbody.actor->getGlobalPose(), transform);
         }
+    };
+
+    if (pool)
+    {
+        pool->parallel_each(view, 512, sync_pose);
+    }
+    else
+    {
+        view.each(sync_pose);
     }
 }
@@ -14,4 +14,5 @@ class DefaultPlugin : public Plugin
 public:
     void build(App &app) override;
     std::string name() const override;
+    bool requires_window() const override { return true; }
 };
\ No newline at end of file
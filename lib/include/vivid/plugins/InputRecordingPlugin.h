@@ -0,0 +1,53 @@
+#pragma once
+
+#include <string>
+#include <utility>
+
+#include <vivid/app/App.h>
+#include <vivid/app/Plugin.h>
+
+// 输入录制 / 回放配置
+struct InputRecordingConfig
+{
+    enum class Mode
+    {
+        Off,
+        Record,
+        Replay
+    };
+
+    Mode mode = Mode::Off;
+    std::string path;
+    double fixed_delta = 0.0; // 回放时每帧前进的秒数，0 使用录制的帧间隔
+    bool exit_at_end = true;  // 回放结束后退出应用
+
+    static InputRecordingConfig record(std::string path)
+    {
+        return InputRecordingConfig{Mode::Record, std::move(path)};
+    }
+
+    static InputRecordingConfig replay(std::string path, double fixed_delta = 0.0)
+    {
+        return InputRecordingConfig{Mode::Replay, std::move(path), fixed_delta};
+    }
+
+    // 从环境变量读取（SDL3 回调模式拿不到命令行参数）：
+    // VIVID_RECORD_INPUT=<file> 录制，VIVID_REPLAY_INPUT=<file> 回放，
+    // VIVID_REPLAY_DELTA=<秒> 回放时使用固定步长
+    static InputRecordingConfig from_env();
+};
+
+// 输入录制插件：录制 SDL 输入事件与帧间隔，或回放录制文件（见 vivid/input/input_recording.h）。
+// 没有 Events<SDL_Event> 时会注册它，无窗口运行时也可以回放
+class InputRecordingPlugin : public Plugin
+{
+public:
+    explicit InputRecordingPlugin(InputRecordingConfig config = InputRecordingConfig::from_env())
+        : config_(std::move(config)) {}
+
+    void build(App &app) override;
+    std::string name() const override;
+
+private:
+    InputRecordingConfig config_;
+};
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+#include <vivid/app/App.h>
+#include <vivid/app/Plugin.h>
+
+// 内存报告插件：在 MemoryTracker 中注册 render_component.h 的场景组件，
+// log_every_frames > 0 时每隔这么多帧在 Cleanup 阶段把报告输出到标准输出（无头运行时使用）
+class MemoryReportPlugin : public Plugin
+{
+public:
+    explicit MemoryReportPlugin(uint64_t log_every_frames = 0)
+        : log_every_frames_(log_every_frames) {}
+
+    void build(App &app) override;
+    std::string name() const override;
+
+private:
+    uint64_t log_every_frames_;
+};
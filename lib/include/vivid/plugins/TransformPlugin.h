@@ -0,0 +1,19 @@
+#pragma once
+
+#include <vivid/app/App.h>
+#include <vivid/app/Plugin.h>
+
+// 变换层级插件：插入 TransformHierarchy 资源，并在 label 阶段注册 transform_propagate 系统
+// （见 vivid/scene/transform_hierarchy.h）。读取 GlobalTransformComponent 的系统应排在它之后：
+// 默认在 PostUpdate，游戏逻辑在 Update 中修改的变换当帧即可被渲染提取读到
+class TransformPlugin : public Plugin
+{
+public:
+    explicit TransformPlugin(ScheduleLabel label = ScheduleLabel::PostUpdate) : label_(label) {}
+
+    void build(App &app) override;
+    std::string name() const override;
+
+private:
+    ScheduleLabel label_;
+};
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <webgpu/webgpu.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace VIVID::Render {
+
+  // ===========================================================================
+  // 渲染管线缓存
+  //
+  // 同样的着色器、顶点布局和渲染状态只创建一条 WGPURenderPipeline，由所有实体共享：
+  //
+  //   PipelineDesc desc;
+  //   desc.shaderSource = kBlinnPhongShader;
+  //   desc.vertexLayout = layout;
+  //   desc.colorFormat = surfaceFormat;
+  //   ...
+  //   PipelineHandle handle = cache.acquire(desc);  // 命中时只增加引用计数
+  //   wgpuRenderPassEncoderSetPipeline(pass, cache.pipeline(handle));
+  //   cache.release(handle);                         // 引用计数归零时释放
+  //
+  // 管线按着色器源码、顶点布局、颜色 / 深度格式、混合和剔除状态、uniform 大小的哈希查找，
+  // 命中后再逐字段比较（着色器比较源码全文），哈希冲突不会返回别的管线。
+  // 着色器模块按源码、绑定组布局和管线布局按 uniform 大小单独缓存，
+  // 被多条管线引用计数共享（例如同一个着色器用于不同的 surface 格式）。
+  // 只在主线程上使用；渲染线程只拿到 pipeline() 返回的 WGPURenderPipeline。
+  // ===========================================================================
+
+  // 缓存中一条管线的句柄，默认构造的句柄无效
+  struct PipelineHandle {
+    static constexpr uint32_t kInvalid = UINT32_MAX;
+    uint32_t index = kInvalid;
+
+    bool valid() const { return index != kInvalid; }
+  };
+
+  // 管线描述；acquire 期间 shaderSource 和 vertexLayout.attributes 必须有效，之后不再引用
+  struct PipelineDesc {
+    std::string_view shaderSource;
+    const char *vertexEntry = "vs_main";
+    const char *fragmentEntry = "fs_main";
+    WGPUVertexBufferLayout vertexLayout = {};
+    WGPUTextureFormat colorFormat = WGPUTextureFormat_Undefined;
+    WGPUTextureFormat depthFormat = WGPUTextureFormat_Undefined;
+    WGPUBlendState blend = {};
+    WGPUCullMode cullMode = WGPUCullMode_Back;
+    WGPUPrimitiveTopology topology = WGPUPrimitiveTopology_TriangleList;
+    uint64_t uniformSize = 0;  // @group(0) @binding(0) 的 uniform 缓冲区大小
+  };
+
+  class PipelineCache {
+  public:
+    explicit PipelineCache(WGPUDevice device) : device_(device) {}
+    ~PipelineCache() { clear(); }
+
+    PipelineCache(const PipelineCache &) = delete;
+    PipelineCache &operator=(const PipelineCache &) = delete;
+
+    // 查找或创建管线，引用计数加一；创建失败时返回无效句柄
+    PipelineHandle acquire(const PipelineDesc &desc);
+
+    // 引用计数减一，归零时释放管线及不再使用的着色器模块和布局
+    void release(PipelineHandle handle);
+
+    // 无效句柄返回 nullptr
+    WGPURenderPipeline pipeline(PipelineHandle handle) const;
+
+    // 创建每个实体的绑定组时使用
+    WGPUBindGroupLayout bind_group_layout(PipelineHandle handle) const;
+
+    size_t pipeline_count() const { return pipeline_lookup_.size(); }
+    size_t shader_module_count() const { return modules_.size(); }
+
+    // 释放全部对象（关闭设备之前调用），之前的句柄全部失效
+    void clear();
+
+  private:
+    struct ShaderModule {
+      std::string source;  // 命中时比较全文
+      WGPUShaderModule module = nullptr;
+      uint32_t refs = 0;
+    };
+
+    struct Layout {
+      WGPUBindGroupLayout bindGroupLayout = nullptr;
+      WGPUPipelineLayout pipelineLayout = nullptr;
+      uint32_t refs = 0;
+    };
+
+    // 除着色器源码外描述中的全部字段，命中时逐个比较
+    struct Key {
+      std::string vertexEntry;
+      std::string fragmentEntry;
+      uint64_t arrayStride = 0;
+      WGPUVertexStepMode stepMode = {};
+      std::vector<WGPUVertexAttribute> attributes;
+      WGPUTextureFormat colorFormat = WGPUTextureFormat_Undefined;
+      WGPUTextureFormat depthFormat = WGPUTextureFormat_Undefined;
+      WGPUBlendState blend = {};
+      WGPUCullMode cullMode = WGPUCullMode_Back;
+      WGPUPrimitiveTopology topology = WGPUPrimitiveTopology_TriangleList;
+      uint64_t uniformSize = 0;
+
+      static Key of(const PipelineDesc &desc);
+      bool matches(const PipelineDesc &desc) const;
+    };
+
+    struct Pipeline {
+      Key key;
+      uint64_t hash = 0;
+      uint64_t shaderHash = 0;
+      const ShaderModule *module = nullptr;  // modules_ 的节点地址不会变化
+      WGPURenderPipeline pipeline = nullptr;
+      uint32_t refs = 0;  // 0 表示空闲槽位
+    };
+
+    static uint64_t hash_shader(std::string_view source);
+    static uint64_t hash_pipeline(uint64_t shaderHash, const PipelineDesc &desc);
+    ShaderModule *acquire_module(uint64_t hash, std::string_view source);
+    Layout *acquire_layout(uint64_t uniformSize);
+    void release_module(uint64_t hash, const ShaderModule *module);
+    void release_layout(uint64_t uniformSize);
+    const Pipeline *find(PipelineHandle handle) const;
+
+    WGPUDevice device_ = nullptr;
+    std::unordered_multimap<uint64_t, ShaderModule> modules_;  // 源码哈希 -> 模块
+    std::unordered_map<uint64_t, Layout> layouts_;
+    std::vector<Pipeline> pipelines_;
+    std::vector<uint32_t> free_slots_;
+    std::unordered_multimap<uint64_t, uint32_t> pipeline_lookup_;  // 管线哈希 -> 下标
+  };
+
+}  // namespace VIVID::Render
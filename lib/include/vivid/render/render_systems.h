@@ -42,6 +42,10 @@ void SetUniform4f(unsigned int program, const std::string &name, float v0, float
                   float v3);
 void SetUniformMat4f(unsigned int program, const std::string &name, const glm::mat4 &matrix);
 
+namespace VIVID::Scene {
+  class WorldClone;
+}  // namespace VIVID::Scene
+
 namespace VIVID::Render {
   static void ReconfigureSurface(Resources &res, entt::registry &world, uint32_t width,
                                  uint32_t height);
@@ -61,12 +65,24 @@ namespace VIVID::Render {
 
   void ConfigureSurface(Resources &res, entt::registry &world);
 
+  // 创建每帧提取所用的拥有型分组（GpuMesh + Transform + Material），在其他启动系统之前运行
+  void CreateRenderGroups(Resources &res, entt::registry &world);
+
   // Resouces Sync Stage Systems (increment)
   void SyncScene(Resources &res, entt::registry &world);
 
+  // 提取渲染数据（相机、光源、每个网格的句柄和 uniform、ImGui 绘制列表），交给渲染线程编码和提交。
+  // 放在 PostUpdate 末尾；渲染第 N 帧与模拟第 N+1 帧重叠，延迟固定为一帧。必须在主线程上运行。
+  void ExtractRender(Resources &res, entt::registry &world);
+
+  // 与 ExtractRender 相同的提取，但在当前线程上立即渲染
   void Draw(Resources &res, entt::registry &world);
 
   void CreatePipeline(Resources &res, entt::registry &world);
 
   void ReleaseWebGPUResources(Resources &res, entt::registry &world);
+
+  // 克隆时跳过每个实体的 GPU 资源组件：它们在组件移除时释放，不能与副本共享。
+  // 还原后的世界由 SyncScene 重新创建（网格缓冲区和管线仍从缓存共享）
+  void RegisterCloneComponents(Scene::WorldClone &clone);
 }  // namespace VIVID::Render
\ No newline at end of file
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include "vivid/app/Profiler.h"
+
+namespace VIVID::Render {
+
+  // ===========================================================================
+  // 渲染线程
+  //
+  // 主线程在每帧末尾把渲染所需的数据提取到 Frame 中（变换、网格/材质句柄、相机、光源），
+  // 交给渲染线程编码和提交；渲染线程处理第 N 帧的同时，主线程已经开始模拟第 N+1 帧。
+  //
+  //   Frame &frame = renderer.write_frame();  // 渲染线程不会访问这一块
+  //   ...填充 frame...
+  //   renderer.wait_idle();                   // 等第 N-1 帧提交完成，之后可以安全地修改 GPU 状态
+  //   renderer.submit();                      // 交给渲染线程，切换到另一块
+  //
+  // Frame 双缓冲，同时最多只有一帧在渲染，延迟固定为一帧。
+  // 渲染线程只读 Frame，不访问 Resources 和 registry；Frame 在两帧之间复用，保留已分配的容量。
+  // pipelined 为 false 时 submit() 直接在调用线程上渲染（例如 Emscripten 没有线程）。
+  // ===========================================================================
+  template <typename Frame> class RenderThread {
+  public:
+    using RenderFn = void (*)(Frame &frame);
+
+  private:
+    Frame frames_[2];
+    size_t write_ = 0;  // 主线程正在填充的一块
+    RenderFn render_;
+    bool pipelined_;
+    uint64_t submitted_ = 0;
+
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    Frame *pending_ = nullptr;  // 已交给渲染线程、尚未完成的一帧
+    bool stop_ = false;
+
+    void loop() {
+      Profiler::instance().set_thread_name("render");
+      std::unique_lock<std::mutex> lock(mutex_);
+      for (;;) {
+        cv_.wait(lock, [&] { return pending_ != nullptr || stop_; });
+        if (!pending_) return;
+
+        Frame *frame = pending_;
+        lock.unlock();
+        {
+          VIVID_PROFILE_SCOPE("render_frame");
+          render_(*frame);
+        }
+        lock.lock();
+        pending_ = nullptr;
+        cv_.notify_all();
+      }
+    }
+
+  public:
+    explicit RenderThread(RenderFn render, bool pipelined = true)
+        : render_(render), pipelined_(pipelined) {}
+
+    ~RenderThread() { stop(); }
+
+    RenderThread(const RenderThread &) = delete;
+    RenderThread &operator=(const RenderThread &) = delete;
+
+    bool pipelined() const { return pipelined_; }
+    uint64_t frames_submitted() const { return submitted_; }
+
+    // 本帧要填充的一块；渲染线程此时只可能在读另一块
+    Frame &write_frame() { return frames_[write_]; }
+
+    // 上一次提交的一块，只能在 wait_idle() 之后读取（例如渲染线程写回的状态）
+    Frame &previous_frame() { return frames_[write_ ^ 1]; }
+
+    // 等待正在渲染的一帧完成
+    void wait_idle() {
+      if (!thread_.joinable()) return;
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [&] { return pending_ == nullptr; });
+    }
+
+    // 提交 write_frame()，随后 write_frame() 切换到另一块
+    void submit() {
+      Frame &frame = frames_[write_];
+      write_ ^= 1;
+      ++submitted_;
+
+      if (!pipelined_) {
+        VIVID_PROFILE_SCOPE("render_frame");
+        render_(frame);
+        return;
+      }
+
+      if (!thread_.joinable()) thread_ = std::thread([this] { loop(); });
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [&] { return pending_ == nullptr; });
+      pending_ = &frame;
+      cv_.notify_all();
+    }
+
+    // 渲染完已提交的帧后结束渲染线程；释放 GPU 资源之前调用
+    void stop() {
+      if (!thread_.joinable()) return;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+      }
+      cv_.notify_all();
+      thread_.join();
+      stop_ = false;
+    }
+  };
+
+}  // namespace VIVID::Render
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <glm/glm.hpp>
+
+struct TransformComponent;
+
+namespace VIVID::Render {
+
+  // ===========================================================================
+  // 批量模型矩阵和法线矩阵
+  //
+  // 模型矩阵 T · R · S 由位置、旋转四元数和缩放得到：compute_model_matrices 把一组变换转置成
+  // SoA 寄存器，四元数转旋转矩阵、各列乘以缩放都在寄存器中完成，再转置写出。
+  // compute_model_normal_matrices 在同一遍中接着用寄存器里的三列求法线矩阵，不再读回模型矩阵。
+  //
+  // 法线矩阵原来按实体用 glm::transpose(glm::inverse(model)) 计算，每个物体每帧一次完整的
+  // 4x4 求逆。模型矩阵都是仿射的（最后一行为 0 0 0 1），法线只用到左上 3x3：
+  // 设 A 的三列为 a0 a1 a2，则 inverse(A) 的转置的三列就是
+  //
+  //   (a1 × a2, a2 × a0, a0 × a1) / det(A)，det(A) = a0 · (a1 × a2)
+  //
+  // 只需三次叉积和一次除法。compute_normal_matrices 每次取 4 个（SSE）或 8 个（AVX）矩阵，
+  // 转置成 SoA 寄存器后一起计算，再转置回来直接写入上传缓冲；
+  // 编译目标不支持时（或不足一组的尾部）使用同样公式的标量版本。
+  // 结果是 4x4 矩阵：左上 3x3 为 transpose(inverse(A))，其余为单位矩阵；着色器只用左上 3x3，
+  // 与 transpose(inverse(model)) 在 w = 0 的方向上结果相同。
+  // 行列式为 0（某个轴缩放为 0）时写出零矩阵，不产生 NaN。
+  // ===========================================================================
+
+  // 一个仿射矩阵的法线矩阵（标量版本），用于逐个实体的渲染路径
+  glm::mat4 normal_matrix(const glm::mat4 &model);
+
+  // 计算 count 个仿射模型矩阵的法线矩阵。
+  // models / normals 中相邻两个矩阵相隔 stride 字节，可以直接指向上传缓冲中结构体数组的字段；
+  // 两者可以属于同一个结构体，但不能重叠
+  void compute_normal_matrices(const glm::mat4 *models, glm::mat4 *normals, size_t count,
+                               size_t stride = sizeof(glm::mat4));
+
+  // 由 count 个变换计算模型矩阵，结果与 TransformComponent::GetTransform 相同。
+  // transforms 是变换的指针数组（组件可以来自不同的存储）；models 中相邻两个矩阵相隔 stride 字节
+  void compute_model_matrices(const TransformComponent *const *transforms, glm::mat4 *models,
+                              size_t count, size_t stride = sizeof(glm::mat4));
+
+  // 同一遍中计算模型矩阵和法线矩阵，models / normals 的要求同 compute_normal_matrices
+  void compute_model_normal_matrices(const TransformComponent *const *transforms,
+                                     glm::mat4 *models, glm::mat4 *normals, size_t count,
+                                     size_t stride = sizeof(glm::mat4));
+
+  // 编译进来的向量指令集："avx"、"sse" 或 "scalar"
+  const char *transform_kernel_isa();
+
+}  // namespace VIVID::Render
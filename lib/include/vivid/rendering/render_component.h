@@ -1,8 +1,13 @@
 #pragma once
 
+#include <cstdint>
+#include <entt/entt.hpp>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
 #include <string>
+
+#include "vivid/app/HeapSize.h"
 #include <memory>
 #include <vector>
 
@@ -11,24 +16,49 @@
 //
 
 // 变换组件，存储物体的位置、旋转、缩放
+// 旋转是单位四元数，运行时不使用欧拉角；编辑器的检查器面板显示和编辑时才与欧拉角互相转换。
+// 与 PhysX 的位姿（PxTransform 的 p / q）逐分量对应，物理同步直接复制
 struct TransformComponent
 {
     glm::vec3 Position{0.0f, 0.0f, 0.0f};
-    glm::vec3 Rotation{0.0f, 0.0f, 0.0f}; // 欧拉角
+    glm::quat Rotation{1.0f, 0.0f, 0.0f, 0.0f}; // (w, x, y, z)
     glm::vec3 Scale{1.0f, 1.0f, 1.0f};
 
-    // 辅助函数，用于计算模型矩阵
+    // 模型矩阵 T · R · S：四元数直接转为 3x3 旋转，各列乘以缩放，不调用三角函数
     glm::mat4 GetTransform() const
     {
-        glm::mat4 transform = glm::translate(glm::mat4(1.0f), Position);
-        transform = glm::rotate(transform, Rotation.x, {1, 0, 0});
-        transform = glm::rotate(transform, Rotation.y, {0, 1, 0});
-        transform = glm::rotate(transform, Rotation.z, {0, 0, 1});
-        transform = glm::scale(transform, Scale);
-        return transform;
+        const glm::mat3 rotation = glm::mat3_cast(Rotation);
+        return glm::mat4(glm::vec4(rotation[0] * Scale.x, 0.0f),
+                         glm::vec4(rotation[1] * Scale.y, 0.0f),
+                         glm::vec4(rotation[2] * Scale.z, 0.0f),
+                         glm::vec4(Position, 1.0f));
     }
 };
 
+// 父节点：TransformComponent 相对于父节点的世界变换。通过 VIVID::Scene::set_parent 修改，
+// 它会同时维护父节点的 ChildrenComponent
+struct ParentComponent
+{
+    entt::entity Parent{entt::null};
+};
+
+// 子节点列表，由 set_parent / ParentComponent 的增删自动维护
+struct ChildrenComponent
+{
+    std::vector<entt::entity> Children;
+};
+
+// 世界变换：由 transform_propagate 系统根据 TransformComponent 和父子关系计算并缓存，
+// 渲染直接读取 Matrix。存储按层级深度排序，父节点总在子节点之前
+struct GlobalTransformComponent
+{
+    glm::mat4 Matrix{1.0f};
+    uint32_t Depth = 0;       // 根节点为 0
+    bool Dirty = true;        // 父子关系改变后需要重新计算
+    bool Updated = false;     // 本帧重新计算过，子节点据此跟着更新
+    TransformComponent Local; // 上次计算时的局部变换，用于发现直接修改
+};
+
 // 标签组件，用于给实体一个可读的名称
 struct TagComponent
 {
@@ -47,6 +77,16 @@ struct MeshComponent
     size_t m_IndexCount;
 };
 
+// 网格资源句柄：指向 VIVID::Scene::MeshAssets 中去重后的网格，同一网格的实例共享顶点数据和
+// GPU 缓冲区。与 MeshComponent 同时存在时以句柄为准；只在运行时有效，不写入世界快照
+struct MeshHandle
+{
+    static constexpr uint32_t Invalid = UINT32_MAX;
+    uint32_t Index = Invalid;
+
+    bool Valid() const { return Index != Invalid; }
+};
+
 // GPU资源组件 - 只存储OpenGL ID
 struct GpuMeshComponent
 {
@@ -101,4 +141,36 @@ struct ViewportComponent
 
     bool IsFocused = false;
     bool IsHovered = false;
-};
\ No newline at end of file
+};
+
+//
+// 内存报告：组件通过容器持有的堆内存
+//
+
+template <>
+struct HeapSize<TagComponent>
+{
+    static size_t of(const TagComponent &tag) { return heap_size(tag.Tag); }
+};
+
+template <>
+struct HeapSize<ChildrenComponent>
+{
+    static size_t of(const ChildrenComponent &children) { return heap_size(children.Children); }
+};
+
+// 上传到 GPU 之后顶点和索引仍保留在每个实体上；多个实例共享的网格改用 MeshHandle
+template <>
+struct HeapSize<MeshComponent>
+{
+    static size_t of(const MeshComponent &mesh)
+    {
+        return heap_size(mesh.m_Vertices) + heap_size(mesh.m_Indices);
+    }
+};
+
+template <>
+struct HeapSize<MaterialComponent>
+{
+    static size_t of(const MaterialComponent &material) { return heap_size(material.ShaderPath); }
+};
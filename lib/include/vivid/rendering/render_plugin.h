@@ -6,4 +6,5 @@ class RenderPlugin : public Plugin
 public:
     void build(App &app) override;
     std::string name() const override;
+    bool requires_window() const override { return true; }
 };
\ No newline at end of file
@@ -34,7 +34,7 @@ namespace VIVID {
   };
 
   // 主更新函数，每帧调用
-  void Sync_system(entt::registry &world);
+  void Sync_system(Resources &res, entt::registry &world);
   void ClearColor_system(Resources &res, entt::registry &world);
   void Update_system(Resources &res, entt::registry &world);
 
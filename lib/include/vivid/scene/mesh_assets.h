@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <entt/entt.hpp>
+#include <unordered_map>
+#include <vector>
+
+#include "vivid/app/HeapSize.h"
+#include "vivid/rendering/render_component.h"
+
+class Resources;
+
+namespace VIVID::Scene {
+
+  // ===========================================================================
+  // 网格资源
+  //
+  // MeshComponent 在每个实体上按值保存顶点和索引，同一个网格的 N 个实例就有 N 份 CPU 数据、
+  // 上传 N 次 GPU 缓冲区。MeshAssets 按内容哈希去重保存网格，实体只挂一个 MeshHandle：
+  //
+  //   auto &meshes = mesh_assets(res);
+  //   MeshHandle cube = meshes.add(CreateCubeMesh());  // 相同内容返回同一个句柄
+  //   world.emplace<MeshHandle>(entity, cube);
+  //
+  // 渲染同步（WebGPU 的 SyncScene、OpenGL 的 Sync_system）按句柄为每个不同的网格只创建一次
+  // 顶点 / 索引缓冲区，所有实例共享。仍然使用 MeshComponent 的实体在同步时由 intern_meshes
+  // 放入资源并补上句柄，同样共享 GPU 缓冲区；MeshComponent 本身保留（快照和编辑器使用它）。
+  // 设置 release_after_upload 后，网格上传到 GPU 即释放 CPU 副本，只保留大小和哈希；
+  // 之后添加的网格与它比较时，大小和两个独立的 64 位哈希都相同才视为同一网格。
+  // 网格在资源的整个生命周期内有效，句柄不会失效。只在主线程（或独占系统）中使用。
+  // ===========================================================================
+
+  struct Mesh {
+    std::vector<float> Vertices;  // 位置 + 法线交错，每个顶点 6 个 float
+    std::vector<unsigned int> Indices;
+    uint64_t Hash = 0;
+    uint64_t Check = 0;      // 第二个独立的哈希，释放 CPU 副本时计算
+    size_t VertexBytes = 0;  // CPU 副本释放后仍然有效
+    size_t IndexBytes = 0;
+    uint32_t IndexCount = 0;
+
+    bool HasCpuData() const { return !Vertices.empty(); }
+  };
+
+  class MeshAssets {
+  public:
+    // 添加网格；已有相同内容的网格时不复制，返回已有的句柄。空网格返回无效句柄
+    MeshHandle add(const std::vector<float> &vertices, const std::vector<unsigned int> &indices);
+    MeshHandle add(const MeshComponent &mesh) { return add(mesh.m_Vertices, mesh.m_Indices); }
+
+    // 无效句柄返回 nullptr
+    const Mesh *get(MeshHandle handle) const;
+
+    // 释放网格的 CPU 副本（已经上传到 GPU 之后）
+    void release_cpu_data(MeshHandle handle);
+
+    void set_release_after_upload(bool release) { release_after_upload_ = release; }
+    bool release_after_upload() const { return release_after_upload_; }
+
+    size_t size() const { return meshes_.size(); }
+    size_t heap_bytes() const;
+
+  private:
+    std::vector<Mesh> meshes_;
+    std::unordered_multimap<uint64_t, uint32_t> lookup_;  // 内容哈希 -> 下标
+    bool release_after_upload_ = false;
+  };
+
+  // 取得 MeshAssets 资源，不存在时插入
+  MeshAssets &mesh_assets(Resources &res);
+
+  // 给有 MeshComponent、没有 MeshHandle 的实体补上句柄（内容相同的实体得到同一个句柄），
+  // 返回处理的实体数。渲染同步在创建 GPU 资源之前调用
+  size_t intern_meshes(entt::registry &registry, MeshAssets &meshes);
+
+}  // namespace VIVID::Scene
+
+// 内存报告：CPU 副本计入资源的堆内存
+template <> struct HeapSize<VIVID::Scene::Mesh> {
+  static size_t of(const VIVID::Scene::Mesh &mesh) {
+    return heap_size(mesh.Vertices) + heap_size(mesh.Indices);
+  }
+};
+
+template <> struct HeapSize<VIVID::Scene::MeshAssets> {
+  static size_t of(const VIVID::Scene::MeshAssets &meshes) { return meshes.heap_bytes(); }
+};
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+#include <vector>
+
+class Resources;
+struct TransformComponent;
+struct GlobalTransformComponent;
+
+namespace VIVID::Scene {
+
+  // ===========================================================================
+  // 变换层级
+  //
+  // 实体通过 ParentComponent / ChildrenComponent 组成父子关系，世界矩阵缓存在
+  // GlobalTransformComponent 中，渲染直接读取，不再每帧每个实体重新计算：
+  //
+  //   set_parent(world, wheel, car);                 // 同时维护两侧的组件
+  //   world.get<TransformComponent>(car).Position.x += 1.0f;
+  //   // 下一次传播时 car 及其整棵子树重新计算
+  //
+  // 传播按层级深度排序后的 GlobalTransformComponent 存储顺序（广度优先）连续遍历一次：
+  // 父节点总在子节点之前，只有自身局部变换改变、父子关系改变或父节点本帧重新计算过的
+  // 实体才重新计算矩阵，静止的子树只做一次比较。只有父子关系或实体增减时才重新排序。
+  // 局部变换的改变通过与上次计算时的值比较发现，直接通过引用修改 TransformComponent 也能生效。
+  // 需要重新计算的实体先全部找出，局部矩阵交给批量内核（Render::compute_model_matrices）
+  // 一次算完，再按同样的顺序乘上父节点的世界矩阵。
+  // 不在层级中的实体（没有 ParentComponent）是根节点，世界矩阵就是局部矩阵。
+  // ===========================================================================
+
+  // 把 child 挂到 parent 下；parent 为 entt::null 时变为根节点。
+  // 会形成环（parent 是 child 自身或其子孙）时不做修改并返回 false
+  bool set_parent(entt::registry &registry, entt::entity child, entt::entity parent);
+
+  // 等同于 set_parent(registry, child, entt::null)
+  void remove_parent(entt::registry &registry, entt::entity child);
+
+  // 按广度优先顺序收集 entity 的所有子孙（不含自身）
+  void collect_descendants(const entt::registry &registry, entt::entity entity,
+                           std::vector<entt::entity> &out);
+
+  // 销毁实体及其全部子孙
+  void destroy_recursive(entt::registry &registry, entt::entity entity);
+
+  // 层级状态资源：监听父子关系和 GlobalTransformComponent 的增删，记录是否需要重新排序，
+  // 并在父子关系改变时把实体标记为脏；被销毁的父节点的子节点变为根节点
+  class TransformHierarchy {
+  public:
+    explicit TransformHierarchy(entt::registry &registry);
+    ~TransformHierarchy();
+
+    TransformHierarchy(const TransformHierarchy &) = delete;
+    TransformHierarchy &operator=(const TransformHierarchy &) = delete;
+
+    // 计算所有实体的世界矩阵：给新的 TransformComponent 实体补上 GlobalTransformComponent，
+    // 需要时按深度重新排序，然后按存储顺序只重新计算脏的子树
+    void propagate(entt::registry &registry);
+
+    // 上一次 propagate 重新计算的实体数
+    size_t updated_count() const { return updated_; }
+
+  private:
+    void on_parent_changed(entt::registry &registry, entt::entity entity);
+    void on_parent_destroyed(entt::registry &registry, entt::entity entity);
+    void on_children_destroyed(entt::registry &registry, entt::entity entity);
+    void on_global_changed(entt::registry &registry, entt::entity entity);
+
+    // 从根节点广度优先计算深度，并按深度排序 GlobalTransformComponent 存储
+    void sort_by_depth(entt::registry &registry);
+
+    // 本次需要重新计算的实体，按存储顺序（父节点在前）
+    struct Pending {
+      GlobalTransformComponent *global;
+      const GlobalTransformComponent *parent;  // 没有父节点时为空
+      const TransformComponent *local;         // 没有 TransformComponent 时为空
+    };
+
+    entt::registry *registry_;
+    bool order_dirty_ = true;
+    size_t updated_ = 0;
+    std::vector<entt::entity> queue_;
+    std::vector<Pending> pending_;
+    std::vector<const TransformComponent *> locals_;  // 交给批量内核，缺少时指向单位变换
+    std::vector<glm::mat4> matrices_;                 // 批量内核算出的局部矩阵
+  };
+
+  // transform_propagate 系统：调用 TransformHierarchy 资源的 propagate
+  void transform_propagate_system(Resources &res, entt::registry &registry);
+
+}  // namespace VIVID::Scene
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <entt/entt.hpp>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace VIVID::Scene {
+
+  // ===========================================================================
+  // 世界克隆
+  //
+  // 把一个 registry 完整复制到另一个 registry：实体编号和版本原样保留（包括已释放的实体），
+  // 组件之间通过 entt::entity 的引用、编辑器中选中的实体在副本中依然有效。
+  // 用于编辑器的运行模式（进入时克隆，退出时还原）以及不阻塞主循环的后台快照
+  // （克隆只需几毫秒，再在其他线程上对副本调用 WorldSnapshot::save）：
+  //
+  //   auto cloner = WorldClone::scene();
+  //   entt::registry saved;
+  //   cloner.clone(world, saved);    // 进入运行模式
+  //   ...
+  //   cloner.restore(saved, world);  // 退出：清空 world 后从 saved 复制回来
+  //
+  // 组件按类型注册，每种组件整块复制：
+  //   - 组件按源存储的顺序一次性批量拷贝插入，或逐个调用注册的复制函数；
+  //   - GPU 句柄组件（shared）只复制句柄，副本与源世界共享同一份 GPU 对象，不重新创建。
+  //     句柄仍由拥有渲染器的世界在关闭时释放，副本本身不会释放它们；
+  //   - 移除时就释放 GPU 对象的组件（ignore）不复制，由渲染同步在目标世界中重新创建。
+  // 未注册的组件不会被复制，第一次遇到时给出警告。
+  // 写入目标 registry 时照常触发 on_construct，变更追踪与拥有型分组保持一致。
+  // ===========================================================================
+  class WorldClone {
+  public:
+    // 预先注册了 render_component.h 中的场景组件；GpuMeshComponent / GpuMaterialComponent 共享句柄
+    static WorldClone scene();
+
+    // 注册组件：按源存储的顺序批量拷贝
+    template <typename T> WorldClone &component();
+
+    // 注册组件及其复制函数（例如需要深拷贝或重新引用的资源）
+    template <typename T> WorldClone &component(T (*copy)(const T &));
+
+    // 注册 GPU 句柄组件：副本与源世界共享句柄
+    template <typename T> WorldClone &shared();
+
+    // 注册不复制的运行时组件（不给出警告）
+    template <typename T> WorldClone &ignore();
+
+    // 把 from 复制到空的 to；to 中已有实体时什么也不做并返回 false
+    bool clone(entt::registry &from, entt::registry &to) const;
+
+    // 清空 to（销毁全部组件并重置实体存储）后从 from 复制
+    void restore(entt::registry &from, entt::registry &to) const;
+
+  private:
+    struct Copier {
+      entt::id_type type_id = 0;
+      std::function<void(entt::registry &from, entt::registry &to)> copy;
+    };
+
+    std::vector<Copier> copiers_;
+    mutable std::vector<std::string> warned_;
+
+    WorldClone &add_copier(Copier copier);
+    const Copier *find_copier(entt::id_type type_id) const;
+
+    // copy 为空时整块复制
+    template <typename T> static void copy_storage(entt::registry &from, entt::registry &to,
+                                                   T (*copy)(const T &));
+  };
+
+  template <typename T>
+  void WorldClone::copy_storage(entt::registry &from, entt::registry &to, T (*copy)(const T &)) {
+    auto &source = from.storage<T>();
+    auto &target = to.storage<T>();
+    const size_t count = source.size();
+    if (count == 0) return;
+
+    // 按源存储的下标顺序（data()）复制；目标中有拥有型分组时排列可能与源不同
+    const entt::entity *entities = source.data();
+    target.reserve(count);
+
+    if constexpr (std::is_empty_v<T>) {
+      target.insert(entities, entities + count);
+    } else if (copy) {
+      for (size_t i = 0; i < count; ++i) target.emplace(entities[i], copy(source.get(entities[i])));
+    } else {
+      // 插入时值已经就位：on_construct 中拥有型分组会交换实体的位置，
+      // 先插入再按下标覆盖会把值写到别的实体上
+      target.insert(entities, entities + count, source.rbegin());
+    }
+  }
+
+  template <typename T> WorldClone &WorldClone::component() {
+    return component<T>(nullptr);
+  }
+
+  template <typename T> WorldClone &WorldClone::component(T (*copy)(const T &)) {
+    Copier copier;
+    copier.type_id = entt::type_hash<T>::value();
+    copier.copy = [copy](entt::registry &from, entt::registry &to) {
+      copy_storage<T>(from, to, copy);
+    };
+    return add_copier(std::move(copier));
+  }
+
+  template <typename T> WorldClone &WorldClone::shared() {
+    static_assert(std::is_trivially_copyable_v<T>, "shared components must be plain handles");
+    return component<T>();
+  }
+
+  template <typename T> WorldClone &WorldClone::ignore() {
+    Copier copier;
+    copier.type_id = entt::type_hash<T>::value();
+    copier.copy = [](entt::registry &, entt::registry &) {};
+    return add_copier(std::move(copier));
+  }
+
+}  // namespace VIVID::Scene
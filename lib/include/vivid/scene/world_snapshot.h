@@ -0,0 +1,386 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <entt/entt.hpp>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace VIVID::Scene {
+
+  // ===========================================================================
+  // 世界快照
+  //
+  // registry 的紧凑二进制快照。文件由定长文件头和若干块（chunk）组成，每种组件一块：
+  //
+  //   FileHeader | ChunkHeader | 实体下标 u32[count] | 组件数据 | ChunkHeader | ...
+  //
+  // 每块以及块内的数据区都按 64 字节对齐。可平凡复制的组件按内存布局原样连续存放，
+  // 加载时直接从映射（mmap）的文件内存批量插入存储，不逐字段解析；
+  // 含堆数据的组件（字符串、顶点数组）注册编解码函数，数组按原始字节块存放。
+  // 每块记录组件名的哈希和编解码版本：未注册或版本不符的块会被跳过并给出警告；
+  // 用 upgrade 注册旧版本布局的转换后，旧版本的块转换为当前组件再插入。
+  //
+  //   auto snapshot = WorldSnapshot::scene();  // render_component.h 中的场景组件
+  //   snapshot.save(world, "scene.vsnap");
+  //   snapshot.load(world, "scene.vsnap");     // 作为新实体追加到 world
+  //
+  // 只保存拥有至少一个已注册组件的实体；加载时实体总是新建的，不保留原来的实体编号。
+  // 组件中的实体引用（父子关系等）用 write_entity / read_entity 存取：保存时写成文件中的实体序号，
+  // 加载时映射到新建的实体。
+  // ===========================================================================
+
+  inline constexpr size_t kSnapshotAlignment = 64;
+
+  // 组件名的 FNV-1a 哈希，作为块的类型标识
+  constexpr uint64_t snapshot_type_id(std::string_view name) {
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : name) {
+      hash ^= static_cast<unsigned char>(c);
+      hash *= 1099511628211ull;
+    }
+    return hash;
+  }
+
+  // 编码一个组件：追加原始字节，数组整体拷贝
+  class BlobWriter {
+  private:
+    std::vector<std::byte> &out_;
+    std::function<uint32_t(entt::entity)> entity_index_;  // 实体 -> 文件中的实体序号
+
+  public:
+    explicit BlobWriter(std::vector<std::byte> &out,
+                        std::function<uint32_t(entt::entity)> entity_index = {})
+        : out_(out), entity_index_(std::move(entity_index)) {}
+
+    void write_bytes(const void *data, size_t size) {
+      const size_t offset = out_.size();
+      out_.resize(offset + size);
+      if (size > 0) std::memcpy(out_.data() + offset, data, size);
+    }
+
+    template <typename T> void write(const T &value) {
+      static_assert(std::is_trivially_copyable_v<T>, "BlobWriter::write needs a POD value");
+      write_bytes(&value, sizeof(T));
+    }
+
+    template <typename T> void write_array(const std::vector<T> &values) {
+      static_assert(std::is_trivially_copyable_v<T>, "BlobWriter::write_array needs POD elements");
+      write<uint64_t>(values.size());
+      write_bytes(values.data(), values.size() * sizeof(T));
+    }
+
+    void write_string(std::string_view text) {
+      write<uint64_t>(text.size());
+      write_bytes(text.data(), text.size());
+    }
+
+    // 实体引用写成文件中的实体序号；空引用和已销毁的实体写成 UINT32_MAX
+    void write_entity(entt::entity entity) {
+      write<uint32_t>(entity_index_ && entity != entt::null ? entity_index_(entity) : UINT32_MAX);
+    }
+  };
+
+  // 解码一个组件；越界时返回 false，不会读出编码范围之外的内存
+  class BlobReader {
+  private:
+    const std::byte *pos_;
+    const std::byte *end_;
+    const std::vector<entt::entity> *entities_;  // 按文件中的序号排列的新建实体
+
+  public:
+    BlobReader(const std::byte *data, size_t size,
+               const std::vector<entt::entity> *entities = nullptr)
+        : pos_(data), end_(data + size), entities_(entities) {}
+
+    size_t remaining() const { return static_cast<size_t>(end_ - pos_); }
+
+    bool read_bytes(void *data, size_t size) {
+      if (size > remaining()) return false;
+      if (size > 0) std::memcpy(data, pos_, size);
+      pos_ += size;
+      return true;
+    }
+
+    template <typename T> bool read(T &value) {
+      static_assert(std::is_trivially_copyable_v<T>, "BlobReader::read needs a POD value");
+      return read_bytes(&value, sizeof(T));
+    }
+
+    template <typename T> bool read_array(std::vector<T> &values) {
+      static_assert(std::is_trivially_copyable_v<T>, "BlobReader::read_array needs POD elements");
+      uint64_t count = 0;
+      if (!read(count) || count > remaining() / sizeof(T)) return false;
+      values.resize(static_cast<size_t>(count));
+      return read_bytes(values.data(), values.size() * sizeof(T));
+    }
+
+    bool read_string(std::string &text) {
+      uint64_t size = 0;
+      if (!read(size) || size > remaining()) return false;
+      text.assign(reinterpret_cast<const char *>(pos_), static_cast<size_t>(size));
+      pos_ += size;
+      return true;
+    }
+
+    // 读回 write_entity 写入的引用；序号超出快照中的实体数时返回 false
+    bool read_entity(entt::entity &entity) {
+      uint32_t index = 0;
+      if (!read(index)) return false;
+      if (index == UINT32_MAX) {
+        entity = entt::null;
+        return true;
+      }
+      if (!entities_ || index >= entities_->size()) return false;
+      entity = (*entities_)[index];
+      return true;
+    }
+  };
+
+  // 块头，紧跟其后的是实体下标和组件数据，均相对块头起始位置寻址
+  struct SnapshotChunkHeader {
+    uint64_t type_id = 0;
+    uint32_t version = 0;
+    uint32_t kind = 0;  // SnapshotChunkKind
+    uint32_t element_size = 0;
+    uint32_t element_align = 0;
+    uint64_t count = 0;
+    uint64_t index_offset = 0;  // u32[count]，文件中实体的序号
+    uint64_t data_offset = 0;
+    uint64_t data_size = 0;
+    uint64_t chunk_size = 0;  // 到下一块的距离
+  };
+  static_assert(sizeof(SnapshotChunkHeader) == 64);
+
+  enum SnapshotChunkKind : uint32_t {
+    // T[count]，可平凡复制的组件
+    kSnapshotRaw = 0,
+    // u64 offsets[count + 1]，随后是各组件编码后的字节
+    kSnapshotBlob = 1,
+  };
+
+  // 加载时某一块的只读视图（指向映射的文件内存）
+  struct SnapshotChunkView {
+    const SnapshotChunkHeader *header = nullptr;
+    const uint32_t *indices = nullptr;
+    const std::byte *data = nullptr;
+  };
+
+  class WorldSnapshot {
+  public:
+    static constexpr uint32_t kFormatVersion = 1;
+
+    // 预先注册了 render_component.h 中的场景组件（不含 GPU 运行时组件）
+    static WorldSnapshot scene();
+
+    // 注册可平凡复制的组件：内存布局原样存取。布局改变时提高 version
+    template <typename T> WorldSnapshot &component(std::string_view name, uint32_t version = 1);
+
+    // 注册需要编解码的组件。数组建议用 write_array / read_array 整块存取
+    template <typename T>
+    WorldSnapshot &component(std::string_view name, uint32_t version,
+                             void (*encode)(BlobWriter &, const T &),
+                             bool (*decode)(BlobReader &, T &));
+
+    // 读取旧版本的可平凡复制组件：块按 Old 的布局解析，再用 convert 转换为当前的 T。
+    // 只影响加载，保存总是使用 component 注册的当前版本
+    template <typename T, typename Old>
+    WorldSnapshot &upgrade(std::string_view name, uint32_t version, T (*convert)(const Old &));
+
+    std::vector<std::byte> serialize(entt::registry &registry) const;
+    bool save(entt::registry &registry, const std::string &path) const;
+
+    // 把快照中的实体追加到 registry；data 至少按 kSnapshotAlignment 对齐时直接从原内存插入
+    bool deserialize(entt::registry &registry, const std::byte *data, size_t size) const;
+    bool load(entt::registry &registry, const std::string &path) const;
+
+  private:
+    // 按文件中的实体序号查找/分配序号，保存时使用
+    struct EntityIndex {
+      std::vector<uint32_t> slots;  // 按 entt::to_entity 索引
+      uint32_t count = 0;
+
+      uint32_t operator()(entt::entity entity) {
+        const auto key = static_cast<size_t>(entt::to_entity(entity));
+        if (key >= slots.size()) slots.resize(key + 1, UINT32_MAX);
+        if (slots[key] == UINT32_MAX) slots[key] = count++;
+        return slots[key];
+      }
+    };
+
+    struct Codec {
+      uint64_t type_id = 0;
+      std::string name;
+      uint32_t version = 0;
+      uint32_t kind = kSnapshotRaw;
+      uint32_t element_size = 0;
+      uint32_t element_align = 0;
+      // 写入实体序号和组件数据，返回组件个数
+      std::function<size_t(entt::registry &, EntityIndex &, std::vector<uint32_t> &indices,
+                           std::vector<std::byte> &data)>
+          save;
+      // targets 已按块中的实体下标解析好；created 是快照中全部新建的实体，用于解析实体引用
+      std::function<bool(entt::registry &, const SnapshotChunkView &,
+                         const std::vector<entt::entity> &targets,
+                         const std::vector<entt::entity> &created)>
+          load;
+    };
+
+    // 旧版本块的加载函数，按类型、版本和元素大小匹配
+    struct Upgrade {
+      uint64_t type_id = 0;
+      uint32_t version = 0;
+      uint32_t element_size = 0;
+      std::function<bool(entt::registry &, const SnapshotChunkView &,
+                         const std::vector<entt::entity> &targets,
+                         const std::vector<entt::entity> &created)>
+          load;
+    };
+
+    std::vector<Codec> codecs_;
+    std::vector<Upgrade> upgrades_;
+
+    WorldSnapshot &add_codec(Codec codec);
+    const Codec *find_codec(uint64_t type_id) const;
+    const Upgrade *find_upgrade(const SnapshotChunkHeader &header) const;
+  };
+
+  template <typename T>
+  WorldSnapshot &WorldSnapshot::component(std::string_view name, uint32_t version) {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "register non-POD components with encode/decode functions");
+    static_assert(alignof(T) <= kSnapshotAlignment);
+    static_assert(!std::is_empty_v<T>, "empty components carry no data");
+
+    Codec codec;
+    codec.type_id = snapshot_type_id(name);
+    codec.name = std::string(name);
+    codec.version = version;
+    codec.kind = kSnapshotRaw;
+    codec.element_size = sizeof(T);
+    codec.element_align = alignof(T);
+    codec.save = [](entt::registry &registry, EntityIndex &index, std::vector<uint32_t> &indices,
+                    std::vector<std::byte> &data) {
+      auto view = registry.view<T>();
+      data.resize(registry.storage<T>().size() * sizeof(T));
+      size_t count = 0;
+      view.each([&](entt::entity entity, const T &value) {
+        indices.push_back(index(entity));
+        std::memcpy(data.data() + count * sizeof(T), &value, sizeof(T));
+        ++count;
+      });
+      return count;
+    };
+    codec.load = [](entt::registry &registry, const SnapshotChunkView &chunk,
+                    const std::vector<entt::entity> &entities, const std::vector<entt::entity> &) {
+      const auto *values = reinterpret_cast<const T *>(chunk.data);
+      if (reinterpret_cast<uintptr_t>(chunk.data) % alignof(T) == 0) {
+        registry.insert<T>(entities.begin(), entities.end(), values);
+      } else {
+        std::vector<T> copy(entities.size());
+        std::memcpy(copy.data(), chunk.data, copy.size() * sizeof(T));
+        registry.insert<T>(entities.begin(), entities.end(), copy.begin());
+      }
+      return true;
+    };
+    return add_codec(std::move(codec));
+  }
+
+  template <typename T>
+  WorldSnapshot &WorldSnapshot::component(std::string_view name, uint32_t version,
+                                          void (*encode)(BlobWriter &, const T &),
+                                          bool (*decode)(BlobReader &, T &)) {
+    Codec codec;
+    codec.type_id = snapshot_type_id(name);
+    codec.name = std::string(name);
+    codec.version = version;
+    codec.kind = kSnapshotBlob;
+    codec.save = [encode](entt::registry &registry, EntityIndex &index,
+                          std::vector<uint32_t> &indices, std::vector<std::byte> &data) {
+      auto view = registry.view<T>();
+      const size_t count = registry.storage<T>().size();
+      // 偏移表在前，编码后的字节在后；偏移相对偏移表之后的位置
+      data.resize((count + 1) * sizeof(uint64_t));
+      std::vector<uint64_t> offsets;
+      offsets.reserve(count + 1);
+      BlobWriter writer(data, [&](entt::entity entity) {
+        return registry.valid(entity) ? index(entity) : UINT32_MAX;
+      });
+      const size_t base = data.size();
+      view.each([&](entt::entity entity, const T &value) {
+        indices.push_back(index(entity));
+        offsets.push_back(data.size() - base);
+        encode(writer, value);
+      });
+      offsets.push_back(data.size() - base);
+      std::memcpy(data.data(), offsets.data(), offsets.size() * sizeof(uint64_t));
+      return offsets.size() - 1;
+    };
+    codec.load = [decode](entt::registry &registry, const SnapshotChunkView &chunk,
+                          const std::vector<entt::entity> &entities,
+                          const std::vector<entt::entity> &created) {
+      const size_t count = entities.size();
+      const size_t table = (count + 1) * sizeof(uint64_t);
+      if (chunk.header->data_size < table) return false;
+      const std::byte *bytes = chunk.data + table;
+      const size_t bytes_size = static_cast<size_t>(chunk.header->data_size) - table;
+
+      uint64_t begin = 0;
+      std::memcpy(&begin, chunk.data, sizeof(uint64_t));
+      for (size_t i = 0; i < count; ++i) {
+        uint64_t end = 0;
+        std::memcpy(&end, chunk.data + (i + 1) * sizeof(uint64_t), sizeof(uint64_t));
+        if (begin > end || end > bytes_size) return false;
+
+        T value{};
+        BlobReader reader(bytes + begin, static_cast<size_t>(end - begin), &created);
+        if (!decode(reader, value)) return false;
+        registry.emplace<T>(entities[i], std::move(value));
+        begin = end;
+      }
+      return true;
+    };
+    return add_codec(std::move(codec));
+  }
+
+  template <typename T, typename Old>
+  WorldSnapshot &WorldSnapshot::upgrade(std::string_view name, uint32_t version,
+                                        T (*convert)(const Old &)) {
+    static_assert(std::is_trivially_copyable_v<Old>, "upgrade reads raw chunks of Old");
+    static_assert(alignof(Old) <= kSnapshotAlignment);
+
+    Upgrade entry;
+    entry.type_id = snapshot_type_id(name);
+    entry.version = version;
+    entry.element_size = sizeof(Old);
+    entry.load = [convert](entt::registry &registry, const SnapshotChunkView &chunk,
+                           const std::vector<entt::entity> &entities,
+                           const std::vector<entt::entity> &) {
+      std::vector<T> values;
+      values.reserve(entities.size());
+      for (size_t i = 0; i < entities.size(); ++i) {
+        Old old;
+        std::memcpy(&old, chunk.data + i * sizeof(Old), sizeof(Old));
+        values.push_back(convert(old));
+      }
+      registry.insert<T>(entities.begin(), entities.end(), values.begin());
+      return true;
+    };
+    auto it = std::find_if(upgrades_.begin(), upgrades_.end(), [&](const Upgrade &other) {
+      return other.type_id == entry.type_id && other.version == version;
+    });
+    if (it != upgrades_.end()) {
+      *it = std::move(entry);
+    } else {
+      upgrades_.push_back(std::move(entry));
+    }
+    return *this;
+  }
+
+}  // namespace VIVID::Scene
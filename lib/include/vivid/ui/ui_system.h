@@ -1,5 +1,7 @@
 #pragma once
 
+#include <SDL3/SDL_events.h>
+
 #include "vivid/app/App.h"
 
 // 如何在SDL3窗口中显示imgui: 1.添加imgui头文件
@@ -10,9 +12,13 @@ namespace VIVID::UI {
 
   void initImGui(Resources& res, entt::registry& world);
 
-  void ProcessImGuiEvent(Resources& res, entt::registry& world);
+  // 每帧一次，处理上一帧以来的全部 SDL 事件
+  void ProcessImGuiEvent(EventReader<SDL_Event> events, MainThread);
 
   void ShowImGuiDemo(Resources& res, entt::registry& world);
 
+  // 内存报告窗口（MemoryTracker），在 ShowImGuiDemo 开始 ImGui 帧之后运行
+  void ShowMemoryPanel(Resources& res, entt::registry& world);
+
   void ShutDownImGui(Resources& res, entt::registry& world);
 }  // namespace VIVID::UI
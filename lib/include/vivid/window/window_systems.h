@@ -50,13 +50,17 @@ namespace VIVID::Window {
   // System functions - all behavior logic is here
   void window_initialization_system(Resources& resources, entt::registry& registry);
   void window_event_processing_system(Resources& resources, entt::registry& registry);
-  void window_update_system(Resources& resources, entt::registry& registry);
+  // Modify WindowComponent through registry.patch / replace so the change is detected
+  void window_update_system(
+      Query<const WindowComponent, WindowGpuComponent, Changed<WindowComponent>> windows,
+      MainThread);
   void window_cleanup_system(Resources& resources, entt::registry& registry);
 
   class WindowPlugin : public Plugin {
   public:
     void build(App& app) override;
     std::string name() const override;
+    bool requires_window() const override { return true; }
   };
 
 }  // namespace VIVID::Window
@@ -0,0 +1,158 @@
+#include "vivid/app/BatchRunner.h"
+
+#include <exception>
+#include <string_view>
+
+#include "vivid/app/Profiler.h"
+#include "vivid/log/log.h"
+
+namespace {
+  const char *level_name(VividLogLevel level) {
+    switch (level) {
+      case VividLogLevel::Trace:
+        return "trace";
+      case VividLogLevel::Verbose:
+        return "verbose";
+      case VividLogLevel::Debug:
+        return "debug";
+      case VividLogLevel::Info:
+        return "info";
+      case VividLogLevel::Warn:
+        return "warn";
+      case VividLogLevel::Error:
+        return "error";
+      case VividLogLevel::Critical:
+        return "critical";
+    }
+    return "log";
+  }
+
+  // VividLogger 的线程输出：写入当前世界的日志缓存
+  void log_to_world(void *userdata, VividLogCategory, VividLogLevel level, const char *message) {
+    auto &log = *static_cast<std::ostringstream *>(userdata);
+    log << '[' << level_name(level) << "] " << message << '\n';
+  }
+}  // namespace
+
+BatchRunner::BatchRunner(BatchConfig config, const Setup &setup)
+    : config_(config), pool_(config.threads) {
+  worlds_.reserve(config_.worlds);
+  for (size_t i = 0; i < config_.worlds; ++i) {
+    auto world = std::make_unique<World>();
+    App &app = world->app;
+    app.set_run_mode(RunMode::Headless)
+        .set_log_stream(&world->log)
+        .set_profile_frames(false);
+    // 并行来自世界之间，世界内部顺序执行
+    app.resources().remove<TaskPool>();
+
+    VividLogger::set_thread_sink(log_to_world, &world->log);
+    try {
+      if (setup) setup(app, i);
+    } catch (const std::exception &e) {
+      world->error = e.what();
+      world->done = true;
+    }
+    VividLogger::set_thread_sink(nullptr);
+    worlds_.push_back(std::move(world));
+  }
+  flush_logs();
+}
+
+BatchRunner::~BatchRunner() { shutdown(); }
+
+size_t BatchRunner::running_count() const {
+  size_t count = 0;
+  for (const auto &world : worlds_) {
+    if (!world->done) ++count;
+  }
+  return count;
+}
+
+void BatchRunner::for_each_world(bool running_only, void (*fn)(World &world, double frame_delta)) {
+  const double frame_delta = config_.frame_delta;
+  pool_.parallel_for(0, worlds_.size(), 1, [&](size_t index) {
+    World &world = *worlds_[index];
+    if (running_only && world.done) return;
+
+    VividLogger::set_thread_sink(log_to_world, &world.log);
+    try {
+      fn(world, frame_delta);
+    } catch (const std::exception &e) {
+      world.error = e.what();
+      world.done = true;
+      world.log << "[error] world stopped: " << e.what() << '\n';
+    } catch (...) {
+      world.error = "unknown exception";
+      world.done = true;
+      world.log << "[error] world stopped: unknown exception\n";
+    }
+    VividLogger::set_thread_sink(nullptr);
+  });
+  flush_logs();
+}
+
+void BatchRunner::initialize() {
+  if (initialized_) return;
+  initialized_ = true;
+  for_each_world(true, [](World &world, double) { world.app.initialize(0, nullptr); });
+}
+
+bool BatchRunner::step() {
+  if (!initialized_) initialize();
+
+  auto &profiler = Profiler::instance();
+  if (profiler.enabled()) profiler.mark_frame();
+
+  for_each_world(true, [](World &world, double frame_delta) {
+    if (world.app.is_running()) {
+      world.app.step(frame_delta);
+      ++world.frames;
+    }
+    world.done = !world.app.is_running();
+  });
+
+  profiler.flush_pending_dump();
+  return running_count() > 0;
+}
+
+uint64_t BatchRunner::run(uint64_t frames) {
+  initialize();
+  uint64_t steps = 0;
+  while (steps < frames && running_count() > 0) {
+    step();
+    ++steps;
+  }
+  shutdown();
+  return steps;
+}
+
+void BatchRunner::shutdown() {
+  if (!initialized_ || shut_down_) return;
+  shut_down_ = true;
+  // 出错的世界状态不确定，不再运行其 Shutdown 阶段
+  for_each_world(false, [](World &world, double) {
+    if (world.error.empty()) world.app.shutdown();
+  });
+}
+
+void BatchRunner::flush_logs() {
+  for (size_t i = 0; i < worlds_.size(); ++i) {
+    auto &log = worlds_[i]->log;
+    const std::string text = log.str();
+    if (text.empty()) continue;
+    log.str(std::string());
+    log.clear();
+    if (!config_.log) continue;
+
+    std::string_view rest(text);
+    while (!rest.empty()) {
+      const size_t end = rest.find('\n');
+      const std::string_view line = rest.substr(0, end);
+      *config_.log << "[world " << i << "] " << line << '\n';
+      if (end == std::string_view::npos) break;
+      rest.remove_prefix(end + 1);
+    }
+  }
+  if (config_.log) config_.log->flush();
+}
@@ -0,0 +1,151 @@
+#include "vivid/app/Profiler.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+
+namespace {
+  thread_local void *t_buffer = nullptr;
+
+  void write_json_string(std::ostream &out, const char *text) {
+    out << '"';
+    for (const char *c = text; *c; ++c) {
+      switch (*c) {
+        case '"': out << "\\\""; break;
+        case '\\': out << "\\\\"; break;
+        case '\n': out << "\\n"; break;
+        case '\t': out << "\\t"; break;
+        default:
+          if (static_cast<unsigned char>(*c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", *c);
+            out << escaped;
+          } else {
+            out << *c;
+          }
+      }
+    }
+    out << '"';
+  }
+}  // namespace
+
+Profiler &Profiler::instance() {
+  static Profiler profiler;
+  return profiler;
+}
+
+const char *Profiler::intern(std::string_view name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return names_.emplace(name).first->c_str();
+}
+
+Profiler::ThreadBuffer &Profiler::local() {
+  if (t_buffer) return *static_cast<ThreadBuffer *>(t_buffer);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto buffer = std::make_unique<ThreadBuffer>();
+  buffer->tid = static_cast<uint32_t>(threads_.size());
+  buffer->name = "thread " + std::to_string(buffer->tid);
+  t_buffer = buffer.get();
+  threads_.push_back(std::move(buffer));
+  return *threads_.back();
+}
+
+void Profiler::record(const char *name, const char *category, uint64_t start_ns,
+                      uint64_t end_ns) {
+  auto &buffer = local();
+  if (buffer.events.empty()) {
+    // 第一次记录时才分配，只设置了线程名的线程不占用缓冲区
+    std::lock_guard<std::mutex> lock(mutex_);
+    buffer.events.resize(events_per_thread_);
+  }
+  const uint64_t index = buffer.written.load(std::memory_order_relaxed);
+  buffer.events[index % buffer.events.size()] = Event{name, category, start_ns, end_ns};
+  buffer.written.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::set_thread_name(std::string name) {
+  auto &buffer = local();
+  std::lock_guard<std::mutex> lock(mutex_);
+  buffer.name = std::move(name);
+}
+
+void Profiler::set_events_per_thread(size_t events) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  events_per_thread_ = std::max<size_t>(events, 1);
+}
+
+void Profiler::mark_frame() {
+  if (frame_count_ == 0) set_thread_name("main");
+  frame_starts_[frame_count_ % kMaxFrames] = now_ns();
+  ++frame_count_;
+}
+
+void Profiler::request_dump(std::string path, uint32_t frames) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    dump_path_ = std::move(path);
+    dump_frames_ = frames;
+  }
+  dump_pending_.store(true, std::memory_order_release);
+}
+
+bool Profiler::flush_pending_dump() {
+  if (!dump_pending_.exchange(false, std::memory_order_acq_rel)) return false;
+
+  std::string path;
+  uint32_t frames = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    path = dump_path_;
+    frames = dump_frames_;
+  }
+  return write_chrome_trace(path, frames);
+}
+
+bool Profiler::write_chrome_trace(const std::string &path, uint32_t frames) const {
+  std::ofstream out(path);
+  if (!out) return false;
+
+  // 只导出最近 frames 帧内开始的事件
+  uint64_t cutoff = 0;
+  const uint64_t kept = std::min<uint64_t>({frames, frame_count_, kMaxFrames});
+  if (kept > 0) cutoff = frame_starts_[(frame_count_ - kept) % kMaxFrames];
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  out << std::fixed << std::setprecision(3);
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  auto separator = [&] {
+    if (!first) out << ",\n";
+    first = false;
+  };
+
+  for (const auto &buffer : threads_) {
+    separator();
+    out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->tid
+        << ",\"args\":{\"name\":";
+    write_json_string(out, buffer->name.c_str());
+    out << "}}";
+
+    const uint64_t written = buffer->written.load(std::memory_order_acquire);
+    const uint64_t capacity = buffer->events.size();
+    if (capacity == 0) continue;
+    const uint64_t begin = written > capacity ? written - capacity : 0;
+    for (uint64_t i = begin; i < written; ++i) {
+      const Event &event = buffer->events[i % capacity];
+      if (event.start_ns < cutoff) continue;
+      separator();
+      out << "{\"name\":";
+      write_json_string(out, event.name);
+      out << ",\"cat\":";
+      write_json_string(out, event.category);
+      out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->tid
+          << ",\"ts\":" << static_cast<double>(event.start_ns) / 1000.0
+          << ",\"dur\":" << static_cast<double>(event.end_ns - event.start_ns) / 1000.0 << "}";
+    }
+  }
+  out << "]}\n";
+  return static_cast<bool>(out);
+}
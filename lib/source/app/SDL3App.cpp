@@ -24,6 +24,7 @@ SDL_AppResult SDL_AppInit(void** appstate, int argc, char** argv) {
     state->metadata = std::move(bundle.metadata);
     state->log_config = std::move(bundle.log_config);
     state->assert_config = std::move(bundle.assert_config);
+    state->sdl_events = state->app->resources().handle<Events<SDL_Event>>();
 
     // 初始化日志系统
     VividLogger::initialize(state->log_config);
@@ -127,20 +128,12 @@ SDL_AppResult SDL_AppEvent(void* appstate, SDL_Event* event) {
       return SDL_APP_SUCCESS;
     }
 
-    // 如果没有EventQueues，则创建一个
-    auto event_queues = state->app->resources().get<EventQueues>();
-    if (!event_queues) {
-      event_queues = &state->app->resources().insert<EventQueues>();
+    // 只写入事件缓冲区，下一帧开始时由 Event 阶段统一处理，不再逐个事件运行调度
+    if (auto* events = state->sdl_events.get()) {
+      events->send(*event);
     }
 
-    event_queues->raw_sdl_events.push(*event);
-
-    // 让应用处理事件
-    if (state->app->handle_event()) {
-      return SDL_APP_CONTINUE;
-    } else {
-      return SDL_APP_SUCCESS;
-    }
+    return state->app->is_running() ? SDL_APP_CONTINUE : SDL_APP_SUCCESS;
   } catch (const std::exception& e) {
     VividLogger::app_error("Exception during SDL_AppEvent: %s", e.what());
     return SDL_APP_FAILURE;
@@ -192,6 +185,21 @@ void SDL_AppQuit(void* appstate, SDL_AppResult result) {
 
 SDL3AppBuilder create_sdl3_app() { return SDL3AppBuilder{}; }
 
+bool coalesce_sdl_event(SDL_Event& last, const SDL_Event& next) {
+  if (last.type != SDL_EVENT_MOUSE_MOTION || next.type != SDL_EVENT_MOUSE_MOTION) return false;
+  if (last.motion.windowID != next.motion.windowID || last.motion.which != next.motion.which
+      || last.motion.state != next.motion.state) {
+    return false;
+  }
+
+  const float xrel = last.motion.xrel + next.motion.xrel;
+  const float yrel = last.motion.yrel + next.motion.yrel;
+  last.motion = next.motion;
+  last.motion.xrel = xrel;
+  last.motion.yrel = yrel;
+  return true;
+}
+
 // 应用SDL3元数据的辅助函数实现
 // 完全按照SDL3官方规范设置所有支持的元数据属性
 void apply_sdl3_metadata(const SDL3AppMetadata& metadata) {
@@ -0,0 +1,192 @@
+#include "vivid/app/TaskPool.h"
+
+#include <string>
+
+#include "vivid/app/Profiler.h"
+
+namespace {
+  // 当前线程所属的线程池及其队列索引，非工作线程为 nullptr
+  struct WorkerIdentity {
+    const TaskPool *pool = nullptr;
+    size_t index = 0;
+  };
+
+  thread_local WorkerIdentity t_worker;
+
+  constexpr size_t kNotAWorker = static_cast<size_t>(-1);
+}  // namespace
+
+TaskPool::TaskPool(size_t thread_count) : thread_count_(thread_count) {
+  if (thread_count_ == 0) {
+    size_t hardware = std::thread::hardware_concurrency();
+    thread_count_ = hardware > 1 ? hardware - 1 : 1;
+  }
+  queues_.reserve(thread_count_);
+  for (size_t i = 0; i < thread_count_; ++i) {
+    queues_.push_back(std::make_unique<WorkerQueue>());
+  }
+}
+
+TaskPool::~TaskPool() {
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    stopping_ = true;
+  }
+  sleep_cv_.notify_all();
+  for (auto &thread : threads_) {
+    if (thread.joinable()) thread.join();
+  }
+}
+
+void TaskPool::ensure_started() {
+  std::call_once(started_, [this] {
+    threads_.reserve(thread_count_);
+    for (size_t i = 0; i < thread_count_; ++i) {
+      threads_.emplace_back([this, i] { worker_loop(i); });
+    }
+  });
+}
+
+size_t TaskPool::current_worker() const {
+  return t_worker.pool == this ? t_worker.index : kNotAWorker;
+}
+
+void TaskPool::push(Task task) {
+  ensure_started();
+
+  const size_t worker = current_worker();
+  WorkerQueue &queue = worker != kNotAWorker ? *queues_[worker] : global_;
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(std::move(task));
+  }
+  queued_.fetch_add(1, std::memory_order_release);
+
+  // 持锁通知，避免与正在进入睡眠的线程之间丢失唤醒
+  std::lock_guard<std::mutex> lock(sleep_mutex_);
+  sleep_cv_.notify_one();
+}
+
+bool TaskPool::pop(Task &task) {
+  if (queued_.load(std::memory_order_acquire) == 0) return false;
+
+  const size_t worker = current_worker();
+
+  // 1. 本线程队列尾部（最近提交的任务，缓存更热）
+  if (worker != kNotAWorker) {
+    WorkerQueue &own = *queues_[worker];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (!own.tasks.empty()) {
+      task = std::move(own.tasks.back());
+      own.tasks.pop_back();
+      queued_.fetch_sub(1, std::memory_order_acq_rel);
+      return true;
+    }
+  }
+
+  // 2. 全局注入队列
+  {
+    std::lock_guard<std::mutex> lock(global_.mutex);
+    if (!global_.tasks.empty()) {
+      task = std::move(global_.tasks.front());
+      global_.tasks.pop_front();
+      queued_.fetch_sub(1, std::memory_order_acq_rel);
+      return true;
+    }
+  }
+
+  // 3. 从其它工作线程队列头部窃取
+  const size_t start = worker != kNotAWorker ? worker + 1 : 0;
+  for (size_t i = 0; i < queues_.size(); ++i) {
+    const size_t victim = (start + i) % queues_.size();
+    if (victim == worker) continue;
+    WorkerQueue &queue = *queues_[victim];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      queued_.fetch_sub(1, std::memory_order_acq_rel);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool TaskPool::try_run_one() {
+  Task task;
+  if (!pop(task)) return false;
+  task();
+  return true;
+}
+
+void TaskPool::worker_loop(size_t index) {
+  t_worker = WorkerIdentity{this, index};
+  Profiler::instance().set_thread_name("worker " + std::to_string(index));
+
+  for (;;) {
+    if (try_run_one()) continue;
+
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    sleep_cv_.wait(lock, [this] {
+      return stopping_.load() || queued_.load(std::memory_order_acquire) > 0;
+    });
+    if (stopping_.load() && queued_.load(std::memory_order_acquire) == 0) return;
+  }
+}
+
+void TaskPool::submit(Task task) { push(std::move(task)); }
+
+TaskPool::TaskHandle TaskPool::spawn(Task task, std::initializer_list<TaskHandle> dependencies) {
+  auto node = std::make_shared<TaskNode>();
+  node->fn = std::move(task);
+
+  // pending 初始为 1，防止依赖在注册过程中完成时提前调度
+  for (const auto &dependency : dependencies) {
+    if (!dependency.node_) continue;
+    std::lock_guard<std::mutex> lock(dependency.node_->mutex);
+    if (!dependency.node_->done) {
+      node->pending.fetch_add(1, std::memory_order_relaxed);
+      dependency.node_->continuations.push_back(node);
+    }
+  }
+
+  if (node->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    schedule_node(node);
+  }
+  return TaskHandle(node);
+}
+
+void TaskPool::schedule_node(std::shared_ptr<TaskNode> node) {
+  push([this, node = std::move(node)] { run_node(node); });
+}
+
+void TaskPool::run_node(const std::shared_ptr<TaskNode> &node) {
+  std::exception_ptr error;
+  try {
+    if (node->fn) node->fn();
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  std::vector<std::shared_ptr<TaskNode>> continuations;
+  {
+    std::lock_guard<std::mutex> lock(node->mutex);
+    node->error = error;
+    node->done = true;
+    continuations.swap(node->continuations);
+  }
+  for (auto &continuation : continuations) {
+    if (continuation->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      schedule_node(std::move(continuation));
+    }
+  }
+}
+
+void TaskPool::wait(const TaskHandle &handle) {
+  if (!handle.node_) return;
+  while (!handle.is_done()) {
+    if (!try_run_one()) std::this_thread::yield();
+  }
+  if (handle.node_->error) std::rethrow_exception(handle.node_->error);
+}
@@ -0,0 +1,74 @@
+#include "vivid/input/camera_control_system.h"
+
+#include <algorithm>
+
+namespace VIVID::Input {
+
+  void camera_control_system(EventReader<SDL_Event> events, Res<Time> time,
+                             Query<TransformComponent, CameraControllerComponent> cameras,
+                             Local<CameraInputState> state) {
+    float yaw = 0.0f;
+    float pitch = 0.0f;
+    float zoom = 0.0f;
+
+    events.each([&](const SDL_Event &event) {
+      switch (event.type) {
+        case SDL_EVENT_KEY_DOWN:
+        case SDL_EVENT_KEY_UP: {
+          // 按扫描码判断，与键盘布局无关
+          const bool down = event.type == SDL_EVENT_KEY_DOWN;
+          switch (event.key.scancode) {
+            case SDL_SCANCODE_W: state->forward = down; break;
+            case SDL_SCANCODE_S: state->back = down; break;
+            case SDL_SCANCODE_A: state->left = down; break;
+            case SDL_SCANCODE_D: state->right = down; break;
+            case SDL_SCANCODE_Q: state->up = down; break;
+            case SDL_SCANCODE_E: state->down = down; break;
+            default: break;
+          }
+          break;
+        }
+        case SDL_EVENT_MOUSE_BUTTON_DOWN:
+        case SDL_EVENT_MOUSE_BUTTON_UP:
+          if (event.button.button == SDL_BUTTON_RIGHT) {
+            state->looking = event.type == SDL_EVENT_MOUSE_BUTTON_DOWN;
+          }
+          break;
+        case SDL_EVENT_MOUSE_MOTION:
+          if (state->looking) {
+            yaw += event.motion.xrel;
+            pitch -= event.motion.yrel;  // 屏幕 y 轴向下
+          }
+          break;
+        case SDL_EVENT_MOUSE_WHEEL:
+          zoom += event.wheel.y;
+          break;
+        default:
+          break;
+      }
+    });
+
+    const float dt = time ? time->delta() : 0.0f;
+    cameras.each([&](auto, TransformComponent &transform, CameraControllerComponent &controller) {
+      controller.MousePressed = state->looking;
+      if (!controller.IsActive) return;
+
+      controller.Yaw += yaw * controller.MouseSensitivity;
+      controller.Pitch
+          = std::clamp(controller.Pitch + pitch * controller.MouseSensitivity, -89.0f, 89.0f);
+      controller.UpdateVectors();
+
+      const float step = controller.MovementSpeed * dt;
+      if (state->forward) transform.Position += controller.Front * step;
+      if (state->back) transform.Position -= controller.Front * step;
+      if (state->left) transform.Position -= controller.Right * step;
+      if (state->right) transform.Position += controller.Right * step;
+      if (state->up) transform.Position += controller.Up * step;
+      if (state->down) transform.Position -= controller.Up * step;
+      transform.Position += controller.Front * (zoom * controller.ZoomSpeed);
+
+      transform.Rotation = glm::quatLookAt(controller.Front, controller.Up);
+    });
+  }
+
+}  // namespace VIVID::Input
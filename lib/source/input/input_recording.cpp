@@ -0,0 +1,213 @@
+#include "vivid/input/input_recording.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "vivid/log/log.h"
+#include "vivid/scene/world_snapshot.h"
+
+namespace VIVID::Input {
+
+  namespace {
+
+    // SDL_Event 中该类事件实际使用的字节数；0 表示不录制
+    size_t event_bytes(uint32_t type) {
+      switch (type) {
+        case SDL_EVENT_KEY_DOWN:
+        case SDL_EVENT_KEY_UP:
+          return sizeof(SDL_KeyboardEvent);
+        case SDL_EVENT_MOUSE_MOTION:
+          return sizeof(SDL_MouseMotionEvent);
+        case SDL_EVENT_MOUSE_BUTTON_DOWN:
+        case SDL_EVENT_MOUSE_BUTTON_UP:
+          return sizeof(SDL_MouseButtonEvent);
+        case SDL_EVENT_MOUSE_WHEEL:
+          return sizeof(SDL_MouseWheelEvent);
+        case SDL_EVENT_GAMEPAD_AXIS_MOTION:
+          return sizeof(SDL_GamepadAxisEvent);
+        case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
+        case SDL_EVENT_GAMEPAD_BUTTON_UP:
+          return sizeof(SDL_GamepadButtonEvent);
+        default:
+          return 0;
+      }
+    }
+
+    // 事件过滤器：返回 true 的事件保留。回放期间只保留非输入事件，实时输入由回放写入的事件代替
+    bool keep_non_input(const SDL_Event &event) { return !InputRecording::recordable(event); }
+
+  }  // namespace
+
+  bool InputRecording::recordable(const SDL_Event &event) { return event_bytes(event.type) > 0; }
+
+  void InputRecording::begin_frame(double delta) {
+    frames_.push_back(Frame{delta, static_cast<uint32_t>(events_.size()), 0});
+  }
+
+  void InputRecording::add_event(const SDL_Event &event) {
+    if (frames_.empty() || !recordable(event)) return;
+    events_.push_back(event);
+    ++frames_.back().event_count;
+  }
+
+  double InputRecording::duration() const {
+    double total = 0.0;
+    for (const auto &frame : frames_) total += frame.delta;
+    return total;
+  }
+
+  void InputRecording::clear() {
+    frames_.clear();
+    events_.clear();
+  }
+
+  std::vector<std::byte> InputRecording::serialize() const {
+    InputRecordingHeader header;
+    header.version = kFormatVersion;
+    header.event_size = sizeof(SDL_Event);
+    header.frame_count = frames_.size();
+    header.event_count = events_.size();
+
+    std::vector<std::byte> out;
+    out.reserve(sizeof(header) + frames_.size() * 12 + events_.size() * 48);
+    Scene::BlobWriter writer(out);
+    writer.write(header);
+    for (const auto &frame : frames_) {
+      writer.write(frame.delta);
+      writer.write(frame.event_count);
+      for (uint32_t i = 0; i < frame.event_count; ++i) {
+        const SDL_Event &event = events_[frame.first_event + i];
+        const auto size = static_cast<uint16_t>(event_bytes(event.type));
+        writer.write(size);
+        writer.write_bytes(&event, size);
+      }
+    }
+    return out;
+  }
+
+  bool InputRecording::deserialize(const std::byte *data, size_t size) {
+    clear();
+    Scene::BlobReader reader(data, size);
+    InputRecordingHeader header;
+    const InputRecordingHeader expected;
+    if (!reader.read(header)
+        || std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0) {
+      VividLogger::app_error("InputRecording: not an input recording");
+      return false;
+    }
+    if (header.version != kFormatVersion || header.event_size != sizeof(SDL_Event)) {
+      VividLogger::app_error("InputRecording: unsupported version %u (event size %u, expected %u)",
+                             header.version, header.event_size,
+                             static_cast<uint32_t>(sizeof(SDL_Event)));
+      return false;
+    }
+    // 每帧至少 12 字节，每个事件至少 2 字节；先校验再预留，损坏的计数不会导致巨大的分配
+    if (header.frame_count > reader.remaining() / 12
+        || header.event_count > reader.remaining() / 2) {
+      VividLogger::app_error("InputRecording: truncated file");
+      return false;
+    }
+    frames_.reserve(static_cast<size_t>(header.frame_count));
+    events_.reserve(static_cast<size_t>(header.event_count));
+
+    for (uint64_t f = 0; f < header.frame_count; ++f) {
+      double delta = 0.0;
+      uint32_t count = 0;
+      if (!reader.read(delta) || !reader.read(count)) break;
+      begin_frame(delta);
+      for (uint32_t i = 0; i < count; ++i) {
+        uint16_t bytes = 0;
+        SDL_Event event;
+        std::memset(&event, 0, sizeof(event));
+        if (!reader.read(bytes) || bytes < sizeof(event.type) || bytes > sizeof(event)
+            || !reader.read_bytes(&event, bytes) || event_bytes(event.type) != bytes) {
+          VividLogger::app_error("InputRecording: corrupt event in frame %llu",
+                                 static_cast<unsigned long long>(f));
+          clear();
+          return false;
+        }
+        add_event(event);
+      }
+    }
+    if (frames_.size() != header.frame_count || events_.size() != header.event_count) {
+      VividLogger::app_error("InputRecording: truncated file");
+      clear();
+      return false;
+    }
+    return true;
+  }
+
+  bool InputRecording::save(const std::string &path) const {
+    const auto bytes = serialize();
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      VividLogger::app_error("InputRecording: cannot open %s for writing", path.c_str());
+      return false;
+    }
+    out.write(reinterpret_cast<const char *>(bytes.data()),
+              static_cast<std::streamsize>(bytes.size()));
+    if (!out) {
+      VividLogger::app_error("InputRecording: failed writing %s", path.c_str());
+      return false;
+    }
+    return true;
+  }
+
+  bool InputRecording::load(const std::string &path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+      VividLogger::app_error("InputRecording: cannot open %s", path.c_str());
+      return false;
+    }
+    std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    return deserialize(reinterpret_cast<const std::byte *>(bytes.data()), bytes.size());
+  }
+
+  void record_input_system(EventReader<SDL_Event> events, Res<Time> time,
+                           ResMut<InputRecorder> recorder) {
+    if (!recorder) return;
+    auto &recording = recorder->recording;
+    recording.begin_frame(time ? time->delta_f64() : 0.0);
+    events.each([&](const SDL_Event &event) { recording.add_event(event); });
+  }
+
+  void save_input_recording_system(ResMut<InputRecorder> recorder) {
+    if (!recorder || recorder->path.empty()) return;
+    const auto &recording = recorder->recording;
+    if (recording.save(recorder->path)) {
+      VividLogger::app_info("Input recording saved to %s: %zu frames, %zu events, %.2f s",
+                            recorder->path.c_str(), recording.frame_count(),
+                            recording.event_count(), recording.duration());
+    }
+  }
+
+  void replay_input_system(ResMut<InputReplay> replay, ResMut<Events<SDL_Event>> events,
+                           ResMut<Time> time, EventWriter<AppExit> exit) {
+    if (!replay || replay->finished || !events || !time) return;
+    const auto &recording = replay->recording;
+
+    if (replay->next_frame >= recording.frame_count()) {
+      replay->finished = true;
+      events->set_filter(nullptr);
+      time->clear_frame_delta();
+      VividLogger::app_info("Input replay finished: %zu frames, %.2f s simulated",
+                            recording.frame_count(),
+                            replay->fixed_delta > 0.0
+                                ? replay->fixed_delta * static_cast<double>(recording.frame_count())
+                                : recording.duration());
+      if (replay->exit_at_end) exit.send(AppExit{});
+      return;
+    }
+
+    // 第一次运行（Startup）时开始屏蔽实时输入
+    if (replay->next_frame == 0) events->set_filter(keep_non_input);
+
+    const size_t index = replay->next_frame++;
+    const auto &frame = recording.frame(index);
+    const SDL_Event *frame_events = recording.frame_events(index);
+    for (uint32_t i = 0; i < frame.event_count; ++i) events->inject(frame_events[i]);
+    time->set_frame_delta(replay->fixed_delta > 0.0 ? replay->fixed_delta : frame.delta);
+  }
+
+}  // namespace VIVID::Input
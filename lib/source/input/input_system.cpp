@@ -22,7 +22,7 @@ void InputSystem::Initialize(GLFWwindow *window)
     glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
 }
 
-void InputSystem::Update(entt::registry &registry)
+void InputSystem::Update(entt::registry &registry, float deltaTime)
 {
     if (!s_Window)
         return;
@@ -38,25 +38,23 @@ void InputSystem::Update(entt::registry &registry)
 
     // Handle keyboard movement
     if (glfwGetKey(s_Window, GLFW_KEY_W) == GLFW_PRESS)
-        transform.Position += cameraController.Front * cameraController.MovementSpeed * 0.016f; // Assuming 60 FPS
+        transform.Position += cameraController.Front * cameraController.MovementSpeed * deltaTime;
     if (glfwGetKey(s_Window, GLFW_KEY_S) == GLFW_PRESS)
-        transform.Position -= cameraController.Front * cameraController.MovementSpeed * 0.016f;
+        transform.Position -= cameraController.Front * cameraController.MovementSpeed * deltaTime;
     if (glfwGetKey(s_Window, GLFW_KEY_A) == GLFW_PRESS)
-        transform.Position -= cameraController.Right * cameraController.MovementSpeed * 0.016f;
+        transform.Position -= cameraController.Right * cameraController.MovementSpeed * deltaTime;
     if (glfwGetKey(s_Window, GLFW_KEY_D) == GLFW_PRESS)
-        transform.Position += cameraController.Right * cameraController.MovementSpeed * 0.016f;
+        transform.Position += cameraController.Right * cameraController.MovementSpeed * deltaTime;
     if (glfwGetKey(s_Window, GLFW_KEY_Q) == GLFW_PRESS)
-        transform.Position += cameraController.Up * cameraController.MovementSpeed * 0.016f;
+        transform.Position += cameraController.Up * cameraController.MovementSpeed * deltaTime;
     if (glfwGetKey(s_Window, GLFW_KEY_E) == GLFW_PRESS)
-        transform.Position -= cameraController.Up * cameraController.MovementSpeed * 0.016f;
+        transform.Position -= cameraController.Up * cameraController.MovementSpeed * deltaTime;
 
     // Update camera vectors based on current yaw and pitch
     cameraController.UpdateVectors();
 
-    // Update rotation from camera controller
-    transform.Rotation.x = cameraController.Pitch;
-    transform.Rotation.y = cameraController.Yaw;
-    transform.Rotation.z = 0.0f;
+    // Update rotation from camera controller: orientation looking along Front
+    transform.Rotation = glm::quatLookAt(cameraController.Front, cameraController.Up);
 }
 
 void InputSystem::Shutdown()
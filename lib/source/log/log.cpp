@@ -1,6 +1,7 @@
 #include "vivid/log/log.h"
 
 #include <cstdarg>
+#include <cstdio>
 
 // =============================================================================
 // VividLogger 静态成员定义和实现
@@ -9,6 +10,34 @@
 VividLogConfig VividLogger::config_;
 bool VividLogger::initialized_ = false;
 
+namespace {
+  struct ThreadSinkState {
+    VividLogger::ThreadSink sink = nullptr;
+    void* userdata = nullptr;
+  };
+
+  thread_local ThreadSinkState t_sink;
+}  // namespace
+
+void VividLogger::set_thread_sink(ThreadSink sink, void* userdata) {
+  t_sink = ThreadSinkState{sink, userdata};
+}
+
+void VividLogger::write(int category, SDL_LogPriority priority, const char* format,
+                        va_list args) {
+  if (!t_sink.sink) {
+    SDL_LogMessageV(category, priority, format, args);
+    return;
+  }
+  // 与 SDL 一致：低于该分类日志级别的消息直接丢弃
+  if (priority < SDL_GetLogPriority(category)) return;
+
+  char buffer[1024];
+  std::vsnprintf(buffer, sizeof(buffer), format, args);
+  t_sink.sink(t_sink.userdata, static_cast<VividLogCategory>(category),
+              static_cast<VividLogLevel>(priority), buffer);
+}
+
 void VividLogger::initialize(const VividLogConfig& config) {
   config_ = config;
 
@@ -59,7 +88,7 @@ void VividLogger::reset_priorities() {
 void VividLogger::log(VividLogCategory category, VividLogLevel level, const char* format, ...) {
   va_list args;
   va_start(args, format);
-  SDL_LogMessageV(static_cast<int>(category), static_cast<SDL_LogPriority>(level), format, args);
+  write(static_cast<int>(category), static_cast<SDL_LogPriority>(level), format, args);
   va_end(args);
 }
 
@@ -67,49 +96,49 @@ void VividLogger::log(VividLogCategory category, VividLogLevel level, const char
 void VividLogger::trace(const char* format, ...) {
   va_list args;
   va_start(args, format);
-  SDL_LogMessageV(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_TRACE, format, args);
+  write(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_TRACE, format, args);
   va_end(args);
 }
 
 void VividLogger::verbose(const char* format, ...) {
   va_list args;
   va_start(args, format);
-  SDL_LogMessageV(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_VERBOSE, format, args);
+  write(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_VERBOSE, format, args);
   va_end(args);
 }
 
 void VividLogger::debug(const char* format, ...) {
   va_list args;
   va_start(args, format);
-  SDL_LogMessageV(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_DEBUG, format, args);
+  write(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_DEBUG, format, args);
   va_end(args);
 }
 
 void VividLogger::info(const char* format, ...) {
   va_list args;
   va_start(args, format);
-  SDL_LogMessageV(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, format, args);
+  write(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, format, args);
   va_end(args);
 }
 
 void VividLogger::warn(const char* format, ...) {
   va_list args;
   va_start(args, format);
-  SDL_LogMessageV(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_WARN, format, args);
+  write(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_WARN, format, args);
   va_end(args);
 }
 
 void VividLogger::error(const char* format, ...) {
   va_list args;
   va_start(args, format);
-  SDL_LogMessageV(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, format, args);
+  write(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, format, args);
   va_end(args);
 }
 
 void VividLogger::critical(const char* format, ...) {
   va_list args;
   va_start(args, format);
-  SDL_LogMessageV(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_CRITICAL, format, args);
+  write(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_CRITICAL, format, args);
   va_end(args);
 }
 
@@ -117,42 +146,42 @@ void VividLogger::critical(const char* format, ...) {
 void VividLogger::app_trace(const char* format, ...) {
   va_list args;
   va_start(args, format);
-  SDL_LogMessageV(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_TRACE, format, args);
+  write(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_TRACE, format, args);
   va_end(args);
 }
 
 void VividLogger::app_debug(const char* format, ...) {
   va_list args;
   va_start(args, format);
-  SDL_LogMessageV(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_DEBUG, format, args);
+  write(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_DEBUG, format, args);
   va_end(args);
 }
 
 void VividLogger::app_info(const char* format, ...) {
   va_list args;
   va_start(args, format);
-  SDL_LogMessageV(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, format, args);
+  write(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, format, args);
   va_end(args);
 }
 
 void VividLogger::app_warn(const char* format, ...) {
   va_list args;
   va_start(args, format);
-  SDL_LogMessageV(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_WARN, format, args);
+  write(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_WARN, format, args);
   va_end(args);
 }
 
 void VividLogger::app_error(const char* format, ...) {
   va_list args;
   va_start(args, format);
-  SDL_LogMessageV(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, format, args);
+  write(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, format, args);
   va_end(args);
 }
 
 void VividLogger::app_critical(const char* format, ...) {
   va_list args;
   va_start(args, format);
-  SDL_LogMessageV(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_CRITICAL, format, args);
+  write(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_CRITICAL, format, args);
   va_end(args);
 }
 
@@ -160,14 +189,14 @@ void VividLogger::app_critical(const char* format, ...) {
 void VividLogger::system_info(const char* format, ...) {
   va_list args;
   va_start(args, format);
-  SDL_LogMessageV(SDL_LOG_CATEGORY_SYSTEM, SDL_LOG_PRIORITY_INFO, format, args);
+  write(SDL_LOG_CATEGORY_SYSTEM, SDL_LOG_PRIORITY_INFO, format, args);
   va_end(args);
 }
 
 void VividLogger::system_error(const char* format, ...) {
   va_list args;
   va_start(args, format);
-  SDL_LogMessageV(SDL_LOG_CATEGORY_SYSTEM, SDL_LOG_PRIORITY_ERROR, format, args);
+  write(SDL_LOG_CATEGORY_SYSTEM, SDL_LOG_PRIORITY_ERROR, format, args);
   va_end(args);
 }
 
@@ -175,14 +204,14 @@ void VividLogger::system_error(const char* format, ...) {
 void VividLogger::render_debug(const char* format, ...) {
   va_list args;
   va_start(args, format);
-  SDL_LogMessageV(SDL_LOG_CATEGORY_RENDER, SDL_LOG_PRIORITY_DEBUG, format, args);
+  write(SDL_LOG_CATEGORY_RENDER, SDL_LOG_PRIORITY_DEBUG, format, args);
   va_end(args);
 }
 
 void VividLogger::render_error(const char* format, ...) {
   va_list args;
   va_start(args, format);
-  SDL_LogMessageV(SDL_LOG_CATEGORY_RENDER, SDL_LOG_PRIORITY_ERROR, format, args);
+  write(SDL_LOG_CATEGORY_RENDER, SDL_LOG_PRIORITY_ERROR, format, args);
   va_end(args);
 }
 
@@ -190,14 +219,14 @@ void VividLogger::render_error(const char* format, ...) {
 void VividLogger::gpu_debug(const char* format, ...) {
   va_list args;
   va_start(args, format);
-  SDL_LogMessageV(SDL_LOG_CATEGORY_GPU, SDL_LOG_PRIORITY_DEBUG, format, args);
+  write(SDL_LOG_CATEGORY_GPU, SDL_LOG_PRIORITY_DEBUG, format, args);
   va_end(args);
 }
 
 void VividLogger::gpu_error(const char* format, ...) {
   va_list args;
   va_start(args, format);
-  SDL_LogMessageV(SDL_LOG_CATEGORY_GPU, SDL_LOG_PRIORITY_ERROR, format, args);
+  write(SDL_LOG_CATEGORY_GPU, SDL_LOG_PRIORITY_ERROR, format, args);
   va_end(args);
 }
 
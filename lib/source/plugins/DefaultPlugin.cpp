@@ -65,8 +65,9 @@ namespace
             // Set registry for input system callbacks
             glfwSetWindowUserPointer(windowRes->window, &registry);
             
-            // Update input system
-            InputSystem::Update(registry);
+            // Update input system with the measured frame time
+            auto *time = res.get<Time>();
+            InputSystem::Update(registry, time ? time->delta() : 0.0f);
             
             glfwSwapBuffers(windowRes->window);
             glfwPollEvents();
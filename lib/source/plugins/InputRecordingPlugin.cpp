@@ -0,0 +1,47 @@
+#include <vivid/plugins/InputRecordingPlugin.h>
+
+#include <cstdlib>
+
+#include "vivid/input/input_recording.h"
+#include "vivid/log/log.h"
+
+InputRecordingConfig InputRecordingConfig::from_env() {
+  if (const char *path = std::getenv("VIVID_REPLAY_INPUT"); path && *path) {
+    const char *delta = std::getenv("VIVID_REPLAY_DELTA");
+    return replay(path, delta ? std::strtod(delta, nullptr) : 0.0);
+  }
+  if (const char *path = std::getenv("VIVID_RECORD_INPUT"); path && *path) {
+    return record(path);
+  }
+  return InputRecordingConfig{};
+}
+
+void InputRecordingPlugin::build(App &app) {
+  using namespace VIVID::Input;
+  if (config_.mode == InputRecordingConfig::Mode::Off) return;
+  app.add_event<SDL_Event>();
+
+  if (config_.mode == InputRecordingConfig::Mode::Record) {
+    app.insert_resource<InputRecorder>(InputRecorder{config_.path, {}});
+    app.add_system(ScheduleLabel::Event, VIVID_SYSTEM(record_input_system));
+    app.add_system(ScheduleLabel::Shutdown, VIVID_SYSTEM(save_input_recording_system));
+    VividLogger::app_info("Recording input to %s", config_.path.c_str());
+    return;
+  }
+
+  InputReplay replay;
+  if (!replay.recording.load(config_.path)) {
+    VividLogger::app_error("Input replay disabled: cannot load %s", config_.path.c_str());
+    return;
+  }
+  replay.fixed_delta = config_.fixed_delta;
+  replay.exit_at_end = config_.exit_at_end;
+  VividLogger::app_info("Replaying input from %s: %zu frames", config_.path.c_str(),
+                        replay.recording.frame_count());
+  app.insert_resource<InputReplay>(std::move(replay));
+  // Startup 写入第 0 帧；之后每帧结束时写入下一帧
+  app.add_system(ScheduleLabel::Startup, replay_input_system, SystemConfig("replay_input_start"));
+  app.add_system(ScheduleLabel::Cleanup, VIVID_SYSTEM(replay_input_system));
+}
+
+std::string InputRecordingPlugin::name() const { return "InputRecordingPlugin"; }
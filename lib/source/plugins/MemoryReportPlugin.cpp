@@ -0,0 +1,37 @@
+#include <vivid/plugins/MemoryReportPlugin.h>
+
+#include <ostream>
+
+#include "vivid/app/App.h"
+#include "vivid/rendering/render_component.h"
+
+namespace {
+
+  // 写入 App 的输出流（App::log），批量运行时各世界的报告互不交错
+  void memory_report(Resources &res, entt::registry &world, std::ostream &out) {
+    auto *tracker = res.get<MemoryTracker>();
+    auto *time = res.get<Time>();
+    if (!tracker || !time || tracker->log_interval() == 0) return;
+    if (time->frame_count() % tracker->log_interval() != 0) return;
+
+    out << "Frame " << time->frame_count() << ' ';
+    tracker->build(res, world).report(out);
+  }
+
+}  // namespace
+
+void MemoryReportPlugin::build(App &app) {
+  app.track_memory<TagComponent, TransformComponent, MeshComponent, MeshHandle,
+                   MaterialComponent, GpuMeshComponent, GpuMaterialComponent, LightComponent,
+                   CameraComponent, ViewportComponent, ParentComponent, ChildrenComponent,
+                   GlobalTransformComponent>();
+  if (log_every_frames_ == 0) return;
+
+  app.resources().get<MemoryTracker>()->set_log_interval(log_every_frames_);
+  app.add_system(
+      ScheduleLabel::Cleanup,
+      [&app](Resources &res, entt::registry &world) { memory_report(res, world, app.log()); },
+      SystemConfig("memory_report"));
+}
+
+std::string MemoryReportPlugin::name() const { return "MemoryReportPlugin"; }
@@ -0,0 +1,12 @@
+#include <vivid/plugins/TransformPlugin.h>
+
+#include "vivid/scene/transform_hierarchy.h"
+
+void TransformPlugin::build(App &app) {
+  app.insert_resource<VIVID::Scene::TransformHierarchy>(app.world());
+  // 传播会补充组件并对存储排序，作为独占系统在主线程上运行
+  app.add_system(label_, VIVID::Scene::transform_propagate_system,
+                 SystemConfig("transform_propagate"));
+}
+
+std::string TransformPlugin::name() const { return "TransformPlugin"; }
@@ -0,0 +1,316 @@
+#include "vivid/render/pipeline_cache.h"
+
+#include <algorithm>
+
+namespace VIVID::Render {
+
+  namespace {
+
+    constexpr uint64_t kFnvOffset = 14695981039346656037ull;
+    constexpr uint64_t kFnvPrime = 1099511628211ull;
+
+    // FNV-1a，按字段逐个累加，不对结构体做整体哈希（填充字节的值不确定）
+    uint64_t fnv1a(uint64_t hash, const void *data, size_t size) {
+      const auto *bytes = static_cast<const unsigned char *>(data);
+      for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= kFnvPrime;
+      }
+      return hash;
+    }
+
+    template <typename T> uint64_t fnv1a(uint64_t hash, const T &value) {
+      return fnv1a(hash, &value, sizeof(T));
+    }
+
+    uint64_t hash_vertex_layout(const WGPUVertexBufferLayout &layout) {
+      uint64_t hash = kFnvOffset;
+      hash = fnv1a(hash, static_cast<uint64_t>(layout.arrayStride));
+      hash = fnv1a(hash, static_cast<uint32_t>(layout.stepMode));
+      hash = fnv1a(hash, static_cast<uint32_t>(layout.attributeCount));
+      for (size_t i = 0; i < layout.attributeCount; ++i) {
+        const WGPUVertexAttribute &attribute = layout.attributes[i];
+        hash = fnv1a(hash, static_cast<uint32_t>(attribute.format));
+        hash = fnv1a(hash, static_cast<uint64_t>(attribute.offset));
+        hash = fnv1a(hash, static_cast<uint32_t>(attribute.shaderLocation));
+      }
+      return hash;
+    }
+
+    uint64_t hash_blend_component(uint64_t hash, const WGPUBlendComponent &component) {
+      hash = fnv1a(hash, static_cast<uint32_t>(component.operation));
+      hash = fnv1a(hash, static_cast<uint32_t>(component.srcFactor));
+      return fnv1a(hash, static_cast<uint32_t>(component.dstFactor));
+    }
+
+    bool same_blend(const WGPUBlendComponent &a, const WGPUBlendComponent &b) {
+      return a.operation == b.operation && a.srcFactor == b.srcFactor
+             && a.dstFactor == b.dstFactor;
+    }
+
+    WGPUStringView string_view_of(std::string_view text) { return {text.data(), text.size()}; }
+
+    WGPUStringView string_view_of(const char *text) { return {text, WGPU_STRLEN}; }
+
+  }  // namespace
+
+  uint64_t PipelineCache::hash_shader(std::string_view source) {
+    return fnv1a(kFnvOffset, source.data(), source.size());
+  }
+
+  uint64_t PipelineCache::hash_pipeline(uint64_t shaderHash, const PipelineDesc &desc) {
+    uint64_t hash = fnv1a(kFnvOffset, shaderHash);
+    hash = fnv1a(hash, hash_vertex_layout(desc.vertexLayout));
+
+    // 入口函数名影响管线但不影响着色器模块，计入管线哈希
+    const std::string_view vertexEntry = desc.vertexEntry;
+    const std::string_view fragmentEntry = desc.fragmentEntry;
+    hash = fnv1a(hash, vertexEntry.data(), vertexEntry.size() + 1);
+    hash = fnv1a(hash, fragmentEntry.data(), fragmentEntry.size() + 1);
+    hash = fnv1a(hash, static_cast<uint32_t>(desc.colorFormat));
+    hash = fnv1a(hash, static_cast<uint32_t>(desc.depthFormat));
+    hash = hash_blend_component(hash, desc.blend.color);
+    hash = hash_blend_component(hash, desc.blend.alpha);
+    hash = fnv1a(hash, static_cast<uint32_t>(desc.cullMode));
+    hash = fnv1a(hash, static_cast<uint32_t>(desc.topology));
+    return fnv1a(hash, desc.uniformSize);
+  }
+
+  PipelineCache::Key PipelineCache::Key::of(const PipelineDesc &desc) {
+    Key key;
+    key.vertexEntry = desc.vertexEntry;
+    key.fragmentEntry = desc.fragmentEntry;
+    key.arrayStride = desc.vertexLayout.arrayStride;
+    key.stepMode = desc.vertexLayout.stepMode;
+    key.attributes.assign(desc.vertexLayout.attributes,
+                          desc.vertexLayout.attributes + desc.vertexLayout.attributeCount);
+    key.colorFormat = desc.colorFormat;
+    key.depthFormat = desc.depthFormat;
+    key.blend = desc.blend;
+    key.cullMode = desc.cullMode;
+    key.topology = desc.topology;
+    key.uniformSize = desc.uniformSize;
+    return key;
+  }
+
+  bool PipelineCache::Key::matches(const PipelineDesc &desc) const {
+    const WGPUVertexBufferLayout &layout = desc.vertexLayout;
+    if (vertexEntry != desc.vertexEntry || fragmentEntry != desc.fragmentEntry
+        || arrayStride != layout.arrayStride || stepMode != layout.stepMode
+        || attributes.size() != layout.attributeCount || colorFormat != desc.colorFormat
+        || depthFormat != desc.depthFormat || !same_blend(blend.color, desc.blend.color)
+        || !same_blend(blend.alpha, desc.blend.alpha) || cullMode != desc.cullMode
+        || topology != desc.topology || uniformSize != desc.uniformSize) {
+      return false;
+    }
+    for (size_t i = 0; i < attributes.size(); ++i) {
+      const WGPUVertexAttribute &attribute = layout.attributes[i];
+      if (attributes[i].format != attribute.format || attributes[i].offset != attribute.offset
+          || attributes[i].shaderLocation != attribute.shaderLocation) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  PipelineCache::ShaderModule *PipelineCache::acquire_module(uint64_t hash,
+                                                             std::string_view source) {
+    auto [first, last] = modules_.equal_range(hash);
+    auto it = std::find_if(first, last, [&](const auto &entry) {
+      return entry.second.source == source;
+    });
+    if (it == last) {
+      WGPUShaderSourceWGSL wgslDesc = {};
+      wgslDesc.chain.next = nullptr;
+      wgslDesc.chain.sType = WGPUSType_ShaderSourceWGSL;
+      wgslDesc.code = string_view_of(source);
+      WGPUShaderModuleDescriptor shaderDesc = {};
+      shaderDesc.nextInChain = &wgslDesc.chain;
+      shaderDesc.label = string_view_of("Cached shader module");
+      WGPUShaderModule module = wgpuDeviceCreateShaderModule(device_, &shaderDesc);
+      if (!module) return nullptr;
+      it = modules_.emplace(hash, ShaderModule{std::string(source), module, 0});
+    }
+    ++it->second.refs;
+    return &it->second;
+  }
+
+  PipelineCache::Layout *PipelineCache::acquire_layout(uint64_t uniformSize) {
+    auto it = layouts_.find(uniformSize);
+    if (it == layouts_.end()) {
+      WGPUBindGroupLayoutEntry bindingLayout = {};
+      bindingLayout.binding = 0;  // shader @binding(0)
+      bindingLayout.visibility = WGPUShaderStage_Vertex | WGPUShaderStage_Fragment;
+      bindingLayout.buffer.type = WGPUBufferBindingType_Uniform;
+      bindingLayout.buffer.hasDynamicOffset = false;
+      bindingLayout.buffer.minBindingSize = uniformSize;
+
+      WGPUBindGroupLayoutDescriptor bindGroupLayoutDesc = {};
+      bindGroupLayoutDesc.entryCount = 1;
+      bindGroupLayoutDesc.entries = &bindingLayout;
+      Layout layout;
+      layout.bindGroupLayout = wgpuDeviceCreateBindGroupLayout(device_, &bindGroupLayoutDesc);
+      if (!layout.bindGroupLayout) return nullptr;
+
+      WGPUPipelineLayoutDescriptor layoutDesc = {};
+      layoutDesc.bindGroupLayoutCount = 1;
+      layoutDesc.bindGroupLayouts = &layout.bindGroupLayout;
+      layout.pipelineLayout = wgpuDeviceCreatePipelineLayout(device_, &layoutDesc);
+      if (!layout.pipelineLayout) {
+        wgpuBindGroupLayoutRelease(layout.bindGroupLayout);
+        return nullptr;
+      }
+      it = layouts_.emplace(uniformSize, layout).first;
+    }
+    ++it->second.refs;
+    return &it->second;
+  }
+
+  void PipelineCache::release_module(uint64_t hash, const ShaderModule *module) {
+    auto [first, last] = modules_.equal_range(hash);
+    auto it = std::find_if(first, last, [&](const auto &entry) { return &entry.second == module; });
+    if (it == last || --it->second.refs > 0) return;
+    wgpuShaderModuleRelease(it->second.module);
+    modules_.erase(it);
+  }
+
+  void PipelineCache::release_layout(uint64_t uniformSize) {
+    auto it = layouts_.find(uniformSize);
+    if (it == layouts_.end() || --it->second.refs > 0) return;
+    wgpuPipelineLayoutRelease(it->second.pipelineLayout);
+    wgpuBindGroupLayoutRelease(it->second.bindGroupLayout);
+    layouts_.erase(it);
+  }
+
+  PipelineHandle PipelineCache::acquire(const PipelineDesc &desc) {
+    const uint64_t shaderHash = hash_shader(desc.shaderSource);
+    const uint64_t hash = hash_pipeline(shaderHash, desc);
+    auto [first, last] = pipeline_lookup_.equal_range(hash);
+    for (auto it = first; it != last; ++it) {
+      Pipeline &entry = pipelines_[it->second];
+      if (entry.module->source == desc.shaderSource && entry.key.matches(desc)) {
+        ++entry.refs;
+        return PipelineHandle{it->second};
+      }
+    }
+
+    ShaderModule *module = acquire_module(shaderHash, desc.shaderSource);
+    if (!module) return {};
+    Layout *layout = acquire_layout(desc.uniformSize);
+    if (!layout) {
+      release_module(shaderHash, module);
+      return {};
+    }
+
+    WGPURenderPipelineDescriptor pipelineDesc = {};
+    pipelineDesc.layout = layout->pipelineLayout;
+    pipelineDesc.vertex.bufferCount = 1;
+    pipelineDesc.vertex.buffers = &desc.vertexLayout;
+    pipelineDesc.vertex.module = module->module;
+    pipelineDesc.vertex.entryPoint = string_view_of(desc.vertexEntry);
+
+    WGPUBlendState blend = desc.blend;
+    WGPUColorTargetState colorTarget = {};
+    colorTarget.format = desc.colorFormat;
+    colorTarget.blend = &blend;
+    colorTarget.writeMask = WGPUColorWriteMask_All;
+    WGPUFragmentState fragmentState = {};
+    fragmentState.module = module->module;
+    fragmentState.entryPoint = string_view_of(desc.fragmentEntry);
+    fragmentState.targetCount = 1;
+    fragmentState.targets = &colorTarget;
+    pipelineDesc.fragment = &fragmentState;
+
+    pipelineDesc.primitive.topology = desc.topology;
+    pipelineDesc.primitive.stripIndexFormat = WGPUIndexFormat_Undefined;
+    pipelineDesc.primitive.frontFace = WGPUFrontFace_CCW;
+    pipelineDesc.primitive.cullMode = desc.cullMode;
+
+    pipelineDesc.multisample.count = 1;
+    pipelineDesc.multisample.mask = 0xFFFFFFFF;
+    pipelineDesc.multisample.alphaToCoverageEnabled = false;
+
+    WGPUDepthStencilState depthStencil = {};
+    if (desc.depthFormat != WGPUTextureFormat_Undefined) {
+      depthStencil.format = desc.depthFormat;
+      depthStencil.depthWriteEnabled = WGPUOptionalBool_True;
+      depthStencil.depthCompare = WGPUCompareFunction_Less;
+      depthStencil.stencilReadMask = 0xFFFFFFFF;
+      depthStencil.stencilWriteMask = 0xFFFFFFFF;
+      pipelineDesc.depthStencil = &depthStencil;
+    }
+
+    WGPURenderPipeline pipeline = wgpuDeviceCreateRenderPipeline(device_, &pipelineDesc);
+    if (!pipeline) {
+      release_layout(desc.uniformSize);
+      release_module(shaderHash, module);
+      return {};
+    }
+
+    uint32_t index;
+    if (!free_slots_.empty()) {
+      index = free_slots_.back();
+      free_slots_.pop_back();
+    } else {
+      index = static_cast<uint32_t>(pipelines_.size());
+      pipelines_.emplace_back();
+    }
+    pipelines_[index] = Pipeline{Key::of(desc), hash, shaderHash, module, pipeline, 1};
+    pipeline_lookup_.emplace(hash, index);
+    return PipelineHandle{index};
+  }
+
+  void PipelineCache::release(PipelineHandle handle) {
+    if (!find(handle)) return;
+    Pipeline &entry = pipelines_[handle.index];
+    if (--entry.refs > 0) return;
+
+    wgpuRenderPipelineRelease(entry.pipeline);
+    release_layout(entry.key.uniformSize);
+    release_module(entry.shaderHash, entry.module);
+    auto [first, last] = pipeline_lookup_.equal_range(entry.hash);
+    for (auto it = first; it != last; ++it) {
+      if (it->second == handle.index) {
+        pipeline_lookup_.erase(it);
+        break;
+      }
+    }
+    entry = Pipeline{};
+    free_slots_.push_back(handle.index);
+  }
+
+  const PipelineCache::Pipeline *PipelineCache::find(PipelineHandle handle) const {
+    if (!handle.valid() || handle.index >= pipelines_.size()) return nullptr;
+    const Pipeline &entry = pipelines_[handle.index];
+    return entry.refs > 0 ? &entry : nullptr;
+  }
+
+  WGPURenderPipeline PipelineCache::pipeline(PipelineHandle handle) const {
+    const Pipeline *entry = find(handle);
+    return entry ? entry->pipeline : nullptr;
+  }
+
+  WGPUBindGroupLayout PipelineCache::bind_group_layout(PipelineHandle handle) const {
+    const Pipeline *entry = find(handle);
+    if (!entry) return nullptr;
+    auto it = layouts_.find(entry->key.uniformSize);
+    return it != layouts_.end() ? it->second.bindGroupLayout : nullptr;
+  }
+
+  void PipelineCache::clear() {
+    for (Pipeline &entry : pipelines_) {
+      if (entry.pipeline) wgpuRenderPipelineRelease(entry.pipeline);
+    }
+    for (auto &[hash, module] : modules_) wgpuShaderModuleRelease(module.module);
+    for (auto &[size, layout] : layouts_) {
+      wgpuPipelineLayoutRelease(layout.pipelineLayout);
+      wgpuBindGroupLayoutRelease(layout.bindGroupLayout);
+    }
+    pipelines_.clear();
+    free_slots_.clear();
+    pipeline_lookup_.clear();
+    modules_.clear();
+    layouts_.clear();
+  }
+
+}  // namespace VIVID::Render
@@ -2,13 +2,22 @@
 
 #include <SDL3/SDL.h>
 
+#include <cstring>
 #include <fstream>
+#include <memory>
+#include <memory_resource>
 #include <sstream>
 #include <thread>
 
 #include "sdl3webgpu.h"
+#include "vivid/app/FrameArena.h"
 #include "vivid/log/log.h"
+#include "vivid/render/pipeline_cache.h"
+#include "vivid/render/render_thread.h"
+#include "vivid/render/transform_kernel.h"
 #include "vivid/rendering/render_component.h"
+#include "vivid/scene/mesh_assets.h"
+#include "vivid/scene/world_clone.h"
 #include "vivid/window/window_systems.h"
 // ImGui rendering backend
 #include <imgui.h>
@@ -116,15 +125,66 @@ void fetchBufferDataSync(WGPUInstance instance, WGPUBuffer buffer, size_t buffer
 namespace VIVID::Render {
 
   struct GpuMeshComponent {
-    WGPUBuffer vertexBuffer = nullptr;
+    WGPUBuffer vertexBuffer = nullptr;  // 与同一网格的其他实例共享，由 GpuMeshBuffers 持有
     WGPUBuffer indexBuffer = nullptr;
     uint32_t indexCount = 0;
     WGPUBuffer uniformBuffer = nullptr;
     WGPUBindGroup bindGroup = nullptr;
-    WGPUVertexBufferLayout vertexBufferLayout = {};
-    WGPUPipelineLayout layout = nullptr;
-    WGPUBindGroupLayout bindGroupLayout = nullptr;
-    WGPURenderPipeline pipeline = nullptr;
+    PipelineHandle pipeline;  // PipelineCache 中共享的管线，相同配置的实体使用同一条
+    uint64_t bufferBytes = 0;  // 实体自己的 uniform 缓冲区大小，用于内存报告
+  };
+
+  // 每个网格资源的顶点和索引缓冲区，按 MeshHandle::Index 索引，同一网格的实体共享
+  struct GpuMeshBuffers {
+    struct Entry {
+      WGPUBuffer vertexBuffer = nullptr;
+      WGPUBuffer indexBuffer = nullptr;
+      uint32_t indexCount = 0;
+      uint64_t bytes = 0;
+    };
+    std::vector<Entry> meshes;
+  };
+
+  // GpuMeshComponent 被移除（实体销毁、世界还原）时，实体自己的 uniform 缓冲区、绑定组和管线引用
+  // 先排队，等渲染线程处理完上一帧（wait_idle）后再释放：上一帧可能仍在绘制这个实体
+  class GpuReleaseQueue {
+  public:
+    struct Entry {
+      WGPUBuffer uniformBuffer = nullptr;
+      WGPUBindGroup bindGroup = nullptr;
+      PipelineHandle pipeline;
+    };
+
+    explicit GpuReleaseQueue(entt::registry &world) : world_(&world) {
+      world.on_destroy<GpuMeshComponent>().connect<&GpuReleaseQueue::on_destroy>(*this);
+    }
+
+    ~GpuReleaseQueue() {
+      world_->on_destroy<GpuMeshComponent>().disconnect<&GpuReleaseQueue::on_destroy>(*this);
+    }
+
+    GpuReleaseQueue(const GpuReleaseQueue &) = delete;
+    GpuReleaseQueue &operator=(const GpuReleaseQueue &) = delete;
+
+    // 释放排队的对象；只在渲染线程空闲时调用
+    void flush(PipelineCache *pipelines) {
+      for (const Entry &entry : pending_) {
+        if (entry.bindGroup) wgpuBindGroupRelease(entry.bindGroup);
+        if (entry.uniformBuffer) wgpuBufferRelease(entry.uniformBuffer);
+        if (pipelines) pipelines->release(entry.pipeline);
+      }
+      pending_.clear();
+    }
+
+  private:
+    entt::registry *world_;
+    std::vector<Entry> pending_;
+
+    void on_destroy(entt::registry &registry, entt::entity entity) {
+      // 顶点和索引缓冲区属于 GpuMeshBuffers，随网格资源一起释放
+      const GpuMeshComponent &gpu = registry.get<GpuMeshComponent>(entity);
+      pending_.push_back(Entry{gpu.uniformBuffer, gpu.bindGroup, gpu.pipeline});
+    }
   };
 
   static void ReconfigureSurface(Resources &res, entt::registry &world, uint32_t width,
@@ -738,67 +798,8 @@ namespace VIVID::Render {
     VividLogger::app_debug("WebGPU surface configured");
   }
 
-  void SyncScene(Resources &res, entt::registry &world) {
-    // We only want to process entities that have the CPU-side data (Mesh, Material)
-    // but DO NOT have the GPU-side data (GpuMeshComponent) yet.
-    // Using entt::exclude prevents us from re-processing entities and leaking resources.
-    auto webgpuRes = res.get<WebGPUResources>();
-    if (!webgpuRes) {
-      VividLogger::app_error("Could not get WebGPU resources!");
-      return;
-    }
-    auto view = world.view<MeshComponent, MaterialComponent>(entt::exclude<GpuMeshComponent>);
-    view.each([&](auto entity, auto &mesh, auto &material) {
-      if (mesh.m_Vertices.empty() || mesh.m_Indices.empty() || material.ShaderPath.empty()) return;
-
-      // 创建和绑定VBO
-      // Create vertex buffer
-      WGPUBufferDescriptor bufferDesc = {};
-      bufferDesc.nextInChain = nullptr;
-      bufferDesc.label = toWgpuStringView("Vertex buffer");
-      bufferDesc.size = mesh.m_Vertices.size() * sizeof(float);
-      bufferDesc.usage = WGPUBufferUsage_CopyDst | WGPUBufferUsage_Vertex;
-      WGPUBuffer vertexBuffer = wgpuDeviceCreateBuffer(webgpuRes->device, &bufferDesc);
-
-      // Upload geometry data to the buffer
-      wgpuQueueWriteBuffer(webgpuRes->queue, vertexBuffer, 0, mesh.m_Vertices.data(),
-                           bufferDesc.size);
-
-      // 创建IBO
-      // Create index buffer (use 32-bit indices to match MeshComponent definition)
-      // (we reuse the bufferDesc initialized for the vertexBuffer)
-      bufferDesc.size = mesh.m_Indices.size() * sizeof(uint32_t);
-
-      // only need when using uint16_t, uint32_t is 4 bytes aligned
-      // bufferDesc.size = (bufferDesc.size + 3) & ~3;  // round up to the next multiple of 4
-      // mesh.m_Indices.resize((mesh.m_Indices.size() + 1)
-      //                       & ~1);  // round up to the next multiple of 2
-      bufferDesc.usage = WGPUBufferUsage_CopyDst | WGPUBufferUsage_Index;
-      WGPUBuffer indexBuffer = wgpuDeviceCreateBuffer(webgpuRes->device, &bufferDesc);
-
-      wgpuQueueWriteBuffer(webgpuRes->queue, indexBuffer, 0, mesh.m_Indices.data(),
-                           bufferDesc.size);
-
-      // 创建和绑定VAO
-      WGPUVertexBufferLayout vertexBufferLayout = {};
-      std::vector<WGPUVertexAttribute> vertexAttribs(2);
-      // Describe the position attribute
-      vertexAttribs[0].shaderLocation = 0;  // @location(0)
-      vertexAttribs[0].format = WGPUVertexFormat_Float32x3;
-      vertexAttribs[0].offset = 0;
-      // Describe the color attribute
-      vertexAttribs[1].shaderLocation = 1;                   // @location(1)
-      vertexAttribs[1].format = WGPUVertexFormat_Float32x3;  // different type!
-      vertexAttribs[1].offset = 3 * sizeof(float);           // non null offset!
-
-      vertexBufferLayout.attributeCount = static_cast<uint32_t>(vertexAttribs.size());
-      vertexBufferLayout.attributes = vertexAttribs.data();
-
-      vertexBufferLayout.arrayStride = 6 * sizeof(float);
-      vertexBufferLayout.stepMode = WGPUVertexStepMode_Vertex;
-
-      // shader (WGSL Blinn-Phong equivalent of standalone/res/shaders/BlinnPhong.shader)
-      const char *shaderSource = R"(
+  // WGSL Blinn-Phong，等价于 standalone/res/shaders/BlinnPhong.shader
+  static const char *const kBlinnPhongShader = R"(
 struct VertexInput {
   @location(0) position: vec3f,
   @location(1) normal: vec3f,
@@ -857,95 +858,147 @@ fn fs_main(in: VertexOutput) -> @location(0) vec4f {
 
   return vec4f(ambient + diffuse + specular, 1.0);
 }
-      )";
-
-      // create the shader module
-      WGPUShaderSourceWGSL wgslDesc = {};
-      wgslDesc.chain.next = nullptr;
-      wgslDesc.chain.sType = WGPUSType_ShaderSourceWGSL;
-      wgslDesc.code = toWgpuStringView(shaderSource);
-      WGPUShaderModuleDescriptor shaderDesc = {};
-      shaderDesc.nextInChain = &wgslDesc.chain;  // connect the chained extension
-      shaderDesc.label = toWgpuStringView("Shader source");
-      WGPUShaderModule shaderModule = wgpuDeviceCreateShaderModule(webgpuRes->device, &shaderDesc);
-
-      // When describing the render pipeline:
-      WGPURenderPipelineDescriptor pipelineDesc = {};
-      pipelineDesc.vertex.bufferCount = 1;
-      pipelineDesc.vertex.buffers = &vertexBufferLayout;
-      pipelineDesc.vertex.module = shaderModule;
-      pipelineDesc.vertex.entryPoint = toWgpuStringView("vs_main");
-
-      WGPUFragmentState fragmentState = {};
-      fragmentState.module = shaderModule;
-      fragmentState.entryPoint = toWgpuStringView("fs_main");
-      WGPUColorTargetState colorTarget = {};
-      colorTarget.format = webgpuRes->surfaceFormat;
-      WGPUBlendState blendState = {};
-      colorTarget.blend = &blendState;
-      colorTarget.writeMask = WGPUColorWriteMask_All;
-      fragmentState.targetCount = 1;
-      fragmentState.targets = &colorTarget;
-      pipelineDesc.fragment = &fragmentState;
-
-      // Primitive state
-      WGPUPrimitiveState primitive = {};
-      primitive.topology = WGPUPrimitiveTopology_TriangleList;
-      primitive.stripIndexFormat = WGPUIndexFormat_Undefined;
-      primitive.frontFace = WGPUFrontFace_CCW;
-      primitive.cullMode = WGPUCullMode_Back;  // cull back faces
-      pipelineDesc.primitive = primitive;
-
-      // Multisample state
-      WGPUMultisampleState multisample = {};
-      multisample.count = 1;
-      multisample.mask = 0xFFFFFFFF;
-      multisample.alphaToCoverageEnabled = false;
-      pipelineDesc.multisample = multisample;
-
-      // Depth-stencil state
-      WGPUDepthStencilState depthStencil = {};
-      depthStencil.format = webgpuRes->depthFormat;
-      depthStencil.depthWriteEnabled = WGPUOptionalBool_True;
-      depthStencil.depthCompare = WGPUCompareFunction_Less;
-      depthStencil.stencilReadMask = 0xFFFFFFFF;
-      depthStencil.stencilWriteMask = 0xFFFFFFFF;
-      pipelineDesc.depthStencil = &depthStencil;
-      // Define binding layout for a uniform buffer used in VS/FS
-      WGPUBindGroupLayoutEntry bindingLayout = {};
-      bindingLayout.binding = 0;  // shader @binding(0)
-      bindingLayout.visibility = WGPUShaderStage_Vertex | WGPUShaderStage_Fragment;
-      bindingLayout.buffer.type = WGPUBufferBindingType_Uniform;
-      bindingLayout.buffer.hasDynamicOffset = false;
-      bindingLayout.buffer.minBindingSize = sizeof(BPUniforms);
-
-      // Create a bind group layout
-      WGPUBindGroupLayoutDescriptor bindGroupLayoutDesc = {};
-      bindGroupLayoutDesc.entryCount = 1;
-      bindGroupLayoutDesc.entries = &bindingLayout;
-      WGPUBindGroupLayout bindGroupLayout
-          = wgpuDeviceCreateBindGroupLayout(webgpuRes->device, &bindGroupLayoutDesc);
-
-      // Create the pipeline layout
-      WGPUPipelineLayoutDescriptor layoutDesc = {};
-      layoutDesc.bindGroupLayoutCount = 1;
-      layoutDesc.bindGroupLayouts = (const WGPUBindGroupLayout *)&bindGroupLayout;
-      WGPUPipelineLayout layout = wgpuDeviceCreatePipelineLayout(webgpuRes->device, &layoutDesc);
-
-      // Assign the PipelineLayout to the RenderPipelineDescriptor's layout field
-      pipelineDesc.layout = layout;
-      WGPURenderPipeline pipeline
-          = wgpuDeviceCreateRenderPipeline(webgpuRes->device, &pipelineDesc);
-      wgpuShaderModuleRelease(shaderModule);
+)";
+
+  // 管线缓存资源，第一次使用时用当前设备创建
+  static PipelineCache &GetPipelineCache(Resources &res, WGPUDevice device) {
+    if (auto *cache = res.get<PipelineCache>()) return *cache;
+    return res.insert<PipelineCache>(device);
+  }
+
+  static GpuMeshBuffers &GetMeshBuffers(Resources &res) {
+    if (auto *buffers = res.get<GpuMeshBuffers>()) return *buffers;
+    return res.insert<GpuMeshBuffers>();
+  }
+
+  // 第一次创建 GpuMeshComponent 之前调用，开始监听它的移除
+  static GpuReleaseQueue &GetReleaseQueue(Resources &res, entt::registry &world) {
+    if (auto *queue = res.get<GpuReleaseQueue>()) return *queue;
+    return res.insert<GpuReleaseQueue>(world);
+  }
+
+  // 上传一个网格资源的顶点和索引缓冲区，已经上传过时直接返回
+  static const GpuMeshBuffers::Entry &UploadMesh(GpuMeshBuffers &buffers,
+                                                 Scene::MeshAssets &meshes, MeshHandle handle,
+                                                 const Scene::Mesh &mesh, WGPUDevice device,
+                                                 WGPUQueue queue) {
+    if (handle.Index >= buffers.meshes.size()) buffers.meshes.resize(handle.Index + 1);
+    GpuMeshBuffers::Entry &entry = buffers.meshes[handle.Index];
+    if (entry.vertexBuffer || !mesh.HasCpuData()) return entry;
+
+    // 创建和绑定VBO
+    // Create vertex buffer
+    WGPUBufferDescriptor bufferDesc = {};
+    bufferDesc.nextInChain = nullptr;
+    bufferDesc.label = toWgpuStringView("Vertex buffer");
+    bufferDesc.size = mesh.VertexBytes;
+    bufferDesc.usage = WGPUBufferUsage_CopyDst | WGPUBufferUsage_Vertex;
+    entry.vertexBuffer = wgpuDeviceCreateBuffer(device, &bufferDesc);
+
+    // Upload geometry data to the buffer
+    wgpuQueueWriteBuffer(queue, entry.vertexBuffer, 0, mesh.Vertices.data(), bufferDesc.size);
+
+    // 创建IBO
+    // Create index buffer (use 32-bit indices to match MeshComponent definition)
+    // (we reuse the bufferDesc initialized for the vertexBuffer)
+    bufferDesc.label = toWgpuStringView("Index buffer");
+    bufferDesc.size = mesh.IndexBytes;
+    bufferDesc.usage = WGPUBufferUsage_CopyDst | WGPUBufferUsage_Index;
+    entry.indexBuffer = wgpuDeviceCreateBuffer(device, &bufferDesc);
+
+    wgpuQueueWriteBuffer(queue, entry.indexBuffer, 0, mesh.Indices.data(), bufferDesc.size);
+
+    entry.indexCount = mesh.IndexCount;
+    entry.bytes = mesh.VertexBytes + mesh.IndexBytes;
+    // 写入队列时数据已经复制，之后可以释放 CPU 副本
+    if (meshes.release_after_upload()) meshes.release_cpu_data(handle);
+    return entry;
+  }
+
+  static void WaitRenderIdle(Resources &res);
+
+  void SyncScene(Resources &res, entt::registry &world) {
+    // We only want to process entities that have the CPU-side data (Mesh, Material)
+    // but DO NOT have the GPU-side data (GpuMeshComponent) yet.
+    // Using entt::exclude prevents us from re-processing entities and leaking resources.
+    auto webgpuRes = res.get<WebGPUResources>();
+    if (!webgpuRes) {
+      VividLogger::app_error("Could not get WebGPU resources!");
+      return;
+    }
+    // SyncScene 创建的缓冲区计入内存报告；同名来源重复注册时只替换
+    if (auto *tracker = res.get<MemoryTracker>()) {
+      tracker->track_external(
+          "WebGPU buffers (SyncScene)", [](Resources &resources, entt::registry &reg) {
+            MemoryReport::External buffers;
+            reg.view<GpuMeshComponent>().each([&](const GpuMeshComponent &gpu) {
+              ++buffers.count;
+              buffers.bytes += gpu.bufferBytes;
+            });
+            // 网格共享的顶点和索引缓冲区，每个网格只计一次
+            if (const auto *shared = resources.get<GpuMeshBuffers>()) {
+              for (const auto &mesh : shared->meshes) {
+                if (!mesh.vertexBuffer) continue;
+                buffers.count += 2;
+                buffers.bytes += mesh.bytes;
+              }
+            }
+            return buffers;
+          });
+    }
+
+    // GpuMeshComponent 通过延迟命令添加，避免在遍历 view 时修改其排除的存储
+    Commands commands(res);
+    PipelineCache &pipelines = GetPipelineCache(res, webgpuRes->device);
+    GetReleaseQueue(res, world);
+    // 顶点数据来自网格资源：仍然使用 MeshComponent 的实体先补上句柄，内容相同的网格只上传一次
+    auto &meshes = Scene::mesh_assets(res);
+    Scene::intern_meshes(world, meshes);
+    auto &meshBuffers = GetMeshBuffers(res);
+    auto view = world.view<MeshHandle, MaterialComponent>(entt::exclude<GpuMeshComponent>);
+    // 以下创建缓冲区和管线，等渲染线程处理完上一帧
+    WaitRenderIdle(res);
+    view.each([&](auto entity, const MeshHandle &handle, auto &material) {
+      const Scene::Mesh *mesh = meshes.get(handle);
+      if (!mesh || mesh->IndexCount == 0 || material.ShaderPath.empty()) return;
+
+      const GpuMeshBuffers::Entry &buffers
+          = UploadMesh(meshBuffers, meshes, handle, *mesh, webgpuRes->device, webgpuRes->queue);
+      if (!buffers.vertexBuffer || !buffers.indexBuffer) return;
+
+      // 创建和绑定VAO
+      WGPUVertexBufferLayout vertexBufferLayout = {};
+      std::pmr::vector<WGPUVertexAttribute> vertexAttribs(2, frame_scratch(res));
+      // Describe the position attribute
+      vertexAttribs[0].shaderLocation = 0;  // @location(0)
+      vertexAttribs[0].format = WGPUVertexFormat_Float32x3;
+      vertexAttribs[0].offset = 0;
+      // Describe the color attribute
+      vertexAttribs[1].shaderLocation = 1;                   // @location(1)
+      vertexAttribs[1].format = WGPUVertexFormat_Float32x3;  // different type!
+      vertexAttribs[1].offset = 3 * sizeof(float);           // non null offset!
+
+      vertexBufferLayout.attributeCount = static_cast<uint32_t>(vertexAttribs.size());
+      vertexBufferLayout.attributes = vertexAttribs.data();
+
+      vertexBufferLayout.arrayStride = 6 * sizeof(float);
+      vertexBufferLayout.stepMode = WGPUVertexStepMode_Vertex;
+
+      // 着色器模块、布局和管线从缓存取得，同样配置的实体共享同一条管线
+      PipelineDesc pipelineDesc;
+      pipelineDesc.shaderSource = kBlinnPhongShader;
+      pipelineDesc.vertexLayout = vertexBufferLayout;
+      pipelineDesc.colorFormat = webgpuRes->surfaceFormat;
+      pipelineDesc.depthFormat = webgpuRes->depthFormat;
+      pipelineDesc.uniformSize = sizeof(BPUniforms);
+      const PipelineHandle pipeline = pipelines.acquire(pipelineDesc);
+      if (!pipeline.valid()) VividLogger::app_error("Could not create render pipeline!");
 
       // Now we use emplace, because we know the component doesn't exist yet.
       GpuMeshComponent gpuMeshComponent;
-      gpuMeshComponent.vertexBuffer = vertexBuffer;
-      gpuMeshComponent.indexBuffer = indexBuffer;
-      gpuMeshComponent.indexCount = (unsigned int)mesh.m_Indices.size();
-      gpuMeshComponent.vertexBufferLayout = vertexBufferLayout;
-      gpuMeshComponent.layout = layout;
-      gpuMeshComponent.bindGroupLayout = bindGroupLayout;
+      gpuMeshComponent.vertexBuffer = buffers.vertexBuffer;
+      gpuMeshComponent.indexBuffer = buffers.indexBuffer;
+      gpuMeshComponent.indexCount = buffers.indexCount;
       gpuMeshComponent.pipeline = pipeline;
 
       // Create per-entity uniform buffer and bind group (persist across frames)
@@ -964,65 +1017,244 @@ fn fs_main(in: VertexOutput) -> @location(0) vec4f {
 
       WGPUBindGroupDescriptor bgDesc = {};
       bgDesc.nextInChain = nullptr;
-      bgDesc.layout = bindGroupLayout;
+      bgDesc.layout = pipelines.bind_group_layout(pipeline);
       bgDesc.entryCount = 1;
       bgDesc.entries = &bgEntry;
-      gpuMeshComponent.bindGroup = wgpuDeviceCreateBindGroup(webgpuRes->device, &bgDesc);
+      // 管线创建失败时不创建绑定组，提取时跳过这个实体
+      if (bgDesc.layout) {
+        gpuMeshComponent.bindGroup = wgpuDeviceCreateBindGroup(webgpuRes->device, &bgDesc);
+      }
+      gpuMeshComponent.bufferBytes = sizeof(BPUniforms);
 
-      world.emplace<GpuMeshComponent>(entity, gpuMeshComponent);
+      commands.insert<GpuMeshComponent>(entity, gpuMeshComponent);
     });
   }
 
-  void Draw(Resources &res, entt::registry &world) {
-    auto webgpuRes = res.get<WebGPUResources>();
-    if (!webgpuRes) {
-      VividLogger::app_error("Could not get WebGPU resources!");
-      return;
+  // ---------------------------------------------------------------------------
+  // 渲染提取
+  //
+  // 主线程在 PostUpdate 末尾把渲染需要的数据复制到 RenderFrame，渲染线程只读 RenderFrame：
+  // 每个可绘制实体的 GPU 句柄和已经算好的 uniform、ImGui 绘制列表的副本、当帧的 surface 信息。
+  // 修改 GPU 状态的操作（surface 重新配置、ImGui 纹理更新）在主线程上、渲染线程空闲时进行；
+  // SyncScene 创建缓冲区和管线之前同样等待渲染线程空闲：Dawn 等后端的设备和队列不保证线程安全。
+  // ---------------------------------------------------------------------------
+  struct RenderItem {
+    WGPURenderPipeline pipeline = nullptr;
+    WGPUBuffer vertexBuffer = nullptr;
+    WGPUBuffer indexBuffer = nullptr;
+    WGPUBuffer uniformBuffer = nullptr;
+    WGPUBindGroup bindGroup = nullptr;
+    uint32_t indexCount = 0;
+  };
+
+  struct RenderFrame {
+    bool valid = false;  // false 表示本帧跳过（最小化、surface 刚重新配置等）
+    WGPUDevice device = nullptr;
+    WGPUQueue queue = nullptr;
+    WGPUSurface surface = nullptr;
+    WGPUTextureView depthView = nullptr;
+
+    std::vector<RenderItem> items;
+    std::vector<BPUniforms> uniforms;  // 与 items 一一对应
+
+    // ImGui 绘制数据的副本；列表对象跨帧复用
+    ImDrawData imguiDrawData;
+    std::vector<std::unique_ptr<ImDrawList>> imguiLists;
+
+    // 由渲染线程写回：surface 过期或丢失，主线程下一帧重新配置
+    bool surfaceLost = false;
+  };
+
+  using FrameRenderer = RenderThread<RenderFrame>;
+
+  template <typename T> static void CopyImVector(ImVector<T> &dst, const ImVector<T> &src) {
+    dst.resize(src.Size);  // 缩小时不释放内存
+    if (src.Size > 0) memcpy(dst.Data, src.Data, src.size_in_bytes());
+  }
+
+  // ImGui 的绘制列表在下一次 NewFrame 时会被覆盖，渲染线程使用的是这里的副本
+  static void CopyImGuiDrawData(const ImDrawData *source, RenderFrame &frame) {
+    ImDrawData &target = frame.imguiDrawData;
+    target.Clear();
+    if (!source || !source->Valid) return;
+
+    while (frame.imguiLists.size() < static_cast<size_t>(source->CmdLists.Size)) {
+      frame.imguiLists.push_back(std::make_unique<ImDrawList>(ImGui::GetDrawListSharedData()));
     }
-    // Check current window pixel size and reconfigure if changed or zero
-    int pixel_width = 0;
-    int pixel_height = 0;
+    for (int i = 0; i < source->CmdLists.Size; ++i) {
+      const ImDrawList &from = *source->CmdLists[i];
+      ImDrawList &list = *frame.imguiLists[i];
+      CopyImVector(list.CmdBuffer, from.CmdBuffer);
+      CopyImVector(list.IdxBuffer, from.IdxBuffer);
+      CopyImVector(list.VtxBuffer, from.VtxBuffer);
+      list.Flags = from.Flags;
+      target.CmdLists.push_back(&list);
+    }
+    target.Valid = true;
+    target.CmdListsCount = source->CmdListsCount;
+    target.TotalIdxCount = source->TotalIdxCount;
+    target.TotalVtxCount = source->TotalVtxCount;
+    target.DisplayPos = source->DisplayPos;
+    target.DisplaySize = source->DisplaySize;
+    target.FramebufferScale = source->FramebufferScale;
+    // 纹理更新已在主线程上完成（见 ExtractAndSubmit）
+    target.Textures = nullptr;
+  }
+
+  // 相机、光源和每个实体的 uniform；只做矩阵运算，不调用 WebGPU
+  static void ExtractScene(Resources &res, entt::registry &world, RenderFrame &frame,
+                           int pixelWidth, int pixelHeight) {
+    // Build camera matrices and positions
+    glm::mat4 viewMatrix(1.0f);
+    glm::mat4 projectionMatrix(1.0f);
+    glm::vec3 viewPos(0.0f);
     {
-      auto view = world.view<VIVID::Window::WindowGpuComponent>();
-      view.each([&](auto entity, auto &gpu_comp) {
-        if (gpu_comp.window_handle) {
-          SDL_GetWindowSizeInPixels(gpu_comp.window_handle, &pixel_width, &pixel_height);
+      entt::entity mainCameraEntity = entt::null;
+      TransformComponent *mainCameraTransform = nullptr;
+      CameraComponent *mainCameraComponent = nullptr;
+      auto cameraView = world.view<TransformComponent, CameraComponent, ViewportComponent>();
+      if (cameraView.size_hint() > 0) {
+        mainCameraEntity = cameraView.front();
+        mainCameraTransform = &cameraView.get<TransformComponent>(mainCameraEntity);
+        mainCameraComponent = &cameraView.get<CameraComponent>(mainCameraEntity);
+      }
+      if (mainCameraEntity != entt::null && mainCameraTransform && mainCameraComponent) {
+        viewPos = mainCameraTransform->Position;
+        if (world.any_of<CameraControllerComponent>(mainCameraEntity)) {
+          auto &controller = world.get<CameraControllerComponent>(mainCameraEntity);
+          glm::vec3 target = mainCameraTransform->Position + controller.Front;
+          viewMatrix = glm::lookAt(mainCameraTransform->Position, target, controller.Up);
+        } else {
+          viewMatrix = glm::lookAt(mainCameraTransform->Position,
+                                   mainCameraTransform->Position + glm::vec3(0, 0, -1),
+                                   glm::vec3(0, 1, 0));
         }
-      });
+        projectionMatrix = mainCameraComponent->ProjectionMatrix;
+        if (projectionMatrix == glm::mat4(1.0f) && pixelHeight > 0) {
+          float aspect = static_cast<float>(pixelWidth) / static_cast<float>(pixelHeight);
+          projectionMatrix = glm::perspective(glm::radians(45.0f), aspect, 0.1f, 100.0f);
+        }
+      }
     }
 
-    if (pixel_width <= 0 || pixel_height <= 0) {
-      // Minimized or not ready; skip this frame
-      ImGui::EndFrame();
-      return;
+    // Query first light
+    glm::vec3 lightPos(5.0f, 5.0f, 5.0f);
+    glm::vec3 lightColor(1.0f);
+    glm::vec3 ambientColor(0.2f);
+    float constant = 1.0f, linear = 0.09f, quadratic = 0.032f;
+    if (auto lightView = world.view<TransformComponent, LightComponent>();
+        lightView.size_hint() > 0) {
+      auto lightEntity = lightView.front();
+      auto &lightTransform = lightView.get<TransformComponent>(lightEntity);
+      auto &lightComponent = lightView.get<LightComponent>(lightEntity);
+      lightPos = lightTransform.Position;
+      lightColor = lightComponent.LightColor;
+      ambientColor = lightComponent.AmbientColor;
+      constant = lightComponent.Constant;
+      linear = lightComponent.Linear;
+      quadratic = lightComponent.Quadratic;
     }
 
-    if (webgpuRes->configuredWidth != static_cast<uint32_t>(pixel_width)
-        || webgpuRes->configuredHeight != static_cast<uint32_t>(pixel_height)) {
-      ReconfigureSurface(res, world, static_cast<uint32_t>(pixel_width),
-                         static_cast<uint32_t>(pixel_height));
-      // Skip this frame after reconfiguration
-      ImGui::EndFrame();
-      return;
+    // Collect drawable meshes
+    struct Source {
+      const MaterialComponent *material;
+      const glm::mat4 *worldMatrix;  // transform_propagate 缓存的世界矩阵，没有时用局部变换
+    };
+    // 临时数组用帧内存池，不跨帧保留；frame.items 交给渲染线程，仍用 RenderFrame 自己的容量
+    std::pmr::vector<Source> sources(frame_scratch(res));
+    sources.reserve(world.storage<GpuMeshComponent>().size());
+    // 与 sources 一一对应，交给批量内核由局部变换计算模型矩阵
+    std::pmr::vector<const TransformComponent *> transforms(frame_scratch(res));
+    transforms.reserve(sources.capacity());
+    frame.items.clear();
+    // 拥有型分组（CreateRenderGroups 创建），遍历紧密排列的组件数组
+    auto drawGroup
+        = owning_group<GpuMeshComponent, TransformComponent, MaterialComponent>(res, world);
+    const auto &globals = world.storage<GlobalTransformComponent>();
+    const auto *pipelines = res.get<PipelineCache>();
+    drawGroup.each([&](entt::entity entity, const GpuMeshComponent &gpu,
+                       const TransformComponent &transform, const MaterialComponent &material) {
+      WGPURenderPipeline pipeline = pipelines ? pipelines->pipeline(gpu.pipeline) : nullptr;
+      if (pipeline == nullptr || gpu.bindGroup == nullptr || gpu.vertexBuffer == nullptr
+          || gpu.indexBuffer == nullptr || gpu.indexCount == 0) {
+        return;
+      }
+      frame.items.push_back(RenderItem{pipeline, gpu.vertexBuffer, gpu.indexBuffer,
+                                       gpu.uniformBuffer, gpu.bindGroup, gpu.indexCount});
+      const glm::mat4 *worldMatrix
+          = globals.contains(entity) ? &globals.get(entity).Matrix : nullptr;
+      sources.push_back(Source{&material, worldMatrix});
+      transforms.push_back(&transform);
+    });
+
+    // Prepare per-entity uniforms in parallel; each chunk fills its uniforms, then computes the
+    // model and normal matrices for the whole chunk with the batched kernel, straight into
+    // frame.uniforms
+    frame.uniforms.resize(frame.items.size());
+    auto computeUniform = [&](size_t i) {
+      const auto &item = sources[i];
+      BPUniforms &uniforms = frame.uniforms[i];
+      uniforms.view = viewMatrix;
+      uniforms.projection = projectionMatrix;
+      uniforms.viewPos = {viewPos.x, viewPos.y, viewPos.z, 0.0f};
+      uniforms.lightPos = {lightPos.x, lightPos.y, lightPos.z, 0.0f};
+      uniforms.objectColor = {item.material->ObjectColor.r, item.material->ObjectColor.g,
+                              item.material->ObjectColor.b, 0.0f};
+      uniforms.lightColor = {lightColor.r, lightColor.g, lightColor.b, 0.0f};
+      uniforms.ambientColor = {ambientColor.r, ambientColor.g, ambientColor.b, 0.0f};
+      uniforms.specularColor = {item.material->SpecularColor.r, item.material->SpecularColor.g,
+                                item.material->SpecularColor.b, 0.0f};
+      uniforms.params = {constant, linear, quadratic, item.material->Shininess};
+    };
+    auto computeUniforms = [&](size_t begin, size_t end) {
+      if (begin == end) return;
+      size_t cached = 0;
+      for (size_t i = begin; i < end; ++i) {
+        computeUniform(i);
+        if (sources[i].worldMatrix) ++cached;
+      }
+      BPUniforms *first = &frame.uniforms[begin];
+      if (cached == end - begin) {
+        // 都有世界矩阵缓存：直接拷贝，只批量计算法线矩阵
+        for (size_t i = begin; i < end; ++i) frame.uniforms[i].model = *sources[i].worldMatrix;
+        compute_normal_matrices(&first->model, &first->normalMatrix, end - begin,
+                                sizeof(BPUniforms));
+        return;
+      }
+      // 由局部变换在同一遍中计算模型矩阵和法线矩阵，有缓存的实体再改用世界矩阵
+      compute_model_normal_matrices(&transforms[begin], &first->model, &first->normalMatrix,
+                                    end - begin, sizeof(BPUniforms));
+      for (size_t i = begin; i < end; ++i) {
+        if (sources[i].worldMatrix == nullptr) continue;
+        frame.uniforms[i].model = *sources[i].worldMatrix;
+        frame.uniforms[i].normalMatrix = normal_matrix(*sources[i].worldMatrix);
+      }
+    };
+    if (auto *pool = res.get<TaskPool>()) {
+      pool->parallel_for_chunks(0, frame.items.size(), 256, computeUniforms);
+    } else {
+      computeUniforms(0, frame.items.size());
     }
+  }
+
+  // 在渲染线程上运行（非流水线模式下在主线程上）：上传 uniform，编码并提交，呈现
+  static void RenderExtractedFrame(RenderFrame &frame) {
+    frame.surfaceLost = false;
+    if (!frame.valid) return;
 
     // [...] Get the next target texture view
     WGPUSurfaceTexture surfaceTexture;
-    wgpuSurfaceGetCurrentTexture(webgpuRes->surface, &surfaceTexture);
+    wgpuSurfaceGetCurrentTexture(frame.surface, &surfaceTexture);
     if (surfaceTexture.status != WGPUSurfaceGetCurrentTextureStatus_SuccessOptimal
         && surfaceTexture.status != WGPUSurfaceGetCurrentTextureStatus_SuccessSuboptimal
 #ifdef __EMSCRIPTEN__
         && surfaceTexture.status != WGPUSurfaceGetCurrentTextureStatus_Success
 #endif
     ) {
-      if (surfaceTexture.status == WGPUSurfaceGetCurrentTextureStatus_Outdated
-          || surfaceTexture.status == WGPUSurfaceGetCurrentTextureStatus_Lost) {
-        // Reconfigure on outdated/lost
-        ReconfigureSurface(res, world, static_cast<uint32_t>(pixel_width),
-                           static_cast<uint32_t>(pixel_height));
-      }
+      // Reconfigure on outdated/lost (done by the main thread on the next frame)
+      frame.surfaceLost = surfaceTexture.status == WGPUSurfaceGetCurrentTextureStatus_Outdated
+                          || surfaceTexture.status == WGPUSurfaceGetCurrentTextureStatus_Lost;
       // Skip this frame for any non-success status
-      ImGui::EndFrame();
       return;
     }
 
@@ -1045,7 +1277,7 @@ fn fs_main(in: VertexOutput) -> @location(0) vec4f {
     WGPUCommandEncoderDescriptor encoderDesc = {};
     encoderDesc.nextInChain = nullptr;
     encoderDesc.label = toWgpuStringView("begin render pass encoder");
-    WGPUCommandEncoder encoder = wgpuDeviceCreateCommandEncoder(webgpuRes->device, &encoderDesc);
+    WGPUCommandEncoder encoder = wgpuDeviceCreateCommandEncoder(frame.device, &encoderDesc);
 
     // [...] Encode Render Pass
     // Describe the attachment
@@ -1063,7 +1295,7 @@ fn fs_main(in: VertexOutput) -> @location(0) vec4f {
     renderPassDesc.colorAttachmentCount = 1;
     renderPassDesc.colorAttachments = &renderPassColorAttachment;
     WGPURenderPassDepthStencilAttachment depthAttach = {};
-    depthAttach.view = webgpuRes->depthView;
+    depthAttach.view = frame.depthView;
     depthAttach.depthClearValue = 1.0f;
     depthAttach.depthLoadOp = WGPULoadOp_Clear;
     depthAttach.depthStoreOp = WGPUStoreOp_Store;
@@ -1077,105 +1309,29 @@ fn fs_main(in: VertexOutput) -> @location(0) vec4f {
 
     WGPURenderPassEncoder renderPass = wgpuCommandEncoderBeginRenderPass(encoder, &renderPassDesc);
 
-    // Use Render Pass
-    // Build camera matrices and positions
-    glm::mat4 viewMatrix(1.0f);
-    glm::mat4 projectionMatrix(1.0f);
-    glm::vec3 viewPos(0.0f);
-    {
-      entt::entity mainCameraEntity = entt::null;
-      TransformComponent *mainCameraTransform = nullptr;
-      CameraComponent *mainCameraComponent = nullptr;
-      ViewportComponent *viewportComponent = nullptr;
-      auto cameraView = world.view<TransformComponent, CameraComponent, ViewportComponent>();
-      if (cameraView.size_hint() > 0) {
-        mainCameraEntity = cameraView.front();
-        mainCameraTransform = &cameraView.get<TransformComponent>(mainCameraEntity);
-        mainCameraComponent = &cameraView.get<CameraComponent>(mainCameraEntity);
-        viewportComponent = &cameraView.get<ViewportComponent>(mainCameraEntity);
-      }
-      if (mainCameraEntity != entt::null && mainCameraTransform && mainCameraComponent) {
-        viewPos = mainCameraTransform->Position;
-        if (world.any_of<CameraControllerComponent>(mainCameraEntity)) {
-          auto &controller = world.get<CameraControllerComponent>(mainCameraEntity);
-          glm::vec3 target = mainCameraTransform->Position + controller.Front;
-          viewMatrix = glm::lookAt(mainCameraTransform->Position, target, controller.Up);
-        } else {
-          viewMatrix = glm::lookAt(mainCameraTransform->Position,
-                                   mainCameraTransform->Position + glm::vec3(0, 0, -1),
-                                   glm::vec3(0, 1, 0));
-        }
-        projectionMatrix = mainCameraComponent->ProjectionMatrix;
-        if (projectionMatrix == glm::mat4(1.0f) && webgpuRes->configuredHeight > 0) {
-          float aspect = static_cast<float>(webgpuRes->configuredWidth)
-                         / static_cast<float>(webgpuRes->configuredHeight);
-          projectionMatrix = glm::perspective(glm::radians(45.0f), aspect, 0.1f, 100.0f);
-        }
-      }
-    }
-
-    // Query first light
-    glm::vec3 lightPos(5.0f, 5.0f, 5.0f);
-    glm::vec3 lightColor(1.0f);
-    glm::vec3 ambientColor(0.2f);
-    float constant = 1.0f, linear = 0.09f, quadratic = 0.032f;
-    if (auto lightView = world.view<TransformComponent, LightComponent>();
-        lightView.size_hint() > 0) {
-      auto lightEntity = lightView.front();
-      auto &lightTransform = lightView.get<TransformComponent>(lightEntity);
-      auto &lightComponent = lightView.get<LightComponent>(lightEntity);
-      lightPos = lightTransform.Position;
-      lightColor = lightComponent.LightColor;
-      ambientColor = lightComponent.AmbientColor;
-      constant = lightComponent.Constant;
-      linear = lightComponent.Linear;
-      quadratic = lightComponent.Quadratic;
-    }
-
-    // Iterate over all GPU meshes and draw
-    auto drawView = world.view<GpuMeshComponent, TransformComponent, MaterialComponent>();
-    drawView.each([&](auto entity, const GpuMeshComponent &gpu, const TransformComponent &transform,
-                      const MaterialComponent &material) {
-      if (gpu.pipeline == nullptr || gpu.vertexBuffer == nullptr || gpu.indexBuffer == nullptr
-          || gpu.indexCount == 0) {
-        return;
-      }
-
-      // Prepare per-entity uniforms
-      BPUniforms uniforms = {};
-      const glm::mat4 model = transform.GetTransform();
-      const glm::mat4 normalMat = glm::transpose(glm::inverse(model));
-      uniforms.model = model;
-      uniforms.view = viewMatrix;
-      uniforms.projection = projectionMatrix;
-      uniforms.normalMatrix = normalMat;
-      uniforms.viewPos = {viewPos.x, viewPos.y, viewPos.z, 0.0f};
-      uniforms.lightPos = {lightPos.x, lightPos.y, lightPos.z, 0.0f};
-      uniforms.objectColor
-          = {material.ObjectColor.r, material.ObjectColor.g, material.ObjectColor.b, 0.0f};
-      uniforms.lightColor = {lightColor.r, lightColor.g, lightColor.b, 0.0f};
-      uniforms.ambientColor = {ambientColor.r, ambientColor.g, ambientColor.b, 0.0f};
-      uniforms.specularColor
-          = {material.SpecularColor.r, material.SpecularColor.g, material.SpecularColor.b, 0.0f};
-      uniforms.params = {constant, linear, quadratic, material.Shininess};
+    // Upload uniforms and encode draws
+    for (size_t i = 0; i < frame.items.size(); ++i) {
+      const RenderItem &item = frame.items[i];
 
       // Update per-entity uniform buffer content
-      if (gpu.uniformBuffer != nullptr) {
-        wgpuQueueWriteBuffer(webgpuRes->queue, gpu.uniformBuffer, 0, &uniforms, sizeof(uniforms));
+      if (item.uniformBuffer != nullptr) {
+        wgpuQueueWriteBuffer(frame.queue, item.uniformBuffer, 0, &frame.uniforms[i],
+                             sizeof(BPUniforms));
       }
 
       // Bind pipeline and buffers, then draw
-      wgpuRenderPassEncoderSetPipeline(renderPass, gpu.pipeline);
-      wgpuRenderPassEncoderSetVertexBuffer(renderPass, 0, gpu.vertexBuffer, 0, WGPU_WHOLE_SIZE);
-      wgpuRenderPassEncoderSetIndexBuffer(renderPass, gpu.indexBuffer, WGPUIndexFormat_Uint32, 0,
+      wgpuRenderPassEncoderSetPipeline(renderPass, item.pipeline);
+      wgpuRenderPassEncoderSetVertexBuffer(renderPass, 0, item.vertexBuffer, 0, WGPU_WHOLE_SIZE);
+      wgpuRenderPassEncoderSetIndexBuffer(renderPass, item.indexBuffer, WGPUIndexFormat_Uint32, 0,
                                           WGPU_WHOLE_SIZE);
-      wgpuRenderPassEncoderSetBindGroup(renderPass, 0, gpu.bindGroup, 0, nullptr);
-      wgpuRenderPassEncoderDrawIndexed(renderPass, gpu.indexCount, 1, 0, 0, 0);
-    });
+      wgpuRenderPassEncoderSetBindGroup(renderPass, 0, item.bindGroup, 0, nullptr);
+      wgpuRenderPassEncoderDrawIndexed(renderPass, item.indexCount, 1, 0, 0, 0);
+    }
 
-    // Render ImGui draw data within the same render pass (UI built earlier in Update stage)
-    ImGui::Render();
-    ImGui_ImplWGPU_RenderDrawData(ImGui::GetDrawData(), renderPass);
+    // Render ImGui draw data within the same render pass (copied during extraction)
+    if (frame.imguiDrawData.Valid) {
+      ImGui_ImplWGPU_RenderDrawData(&frame.imguiDrawData, renderPass);
+    }
 
     wgpuRenderPassEncoderEnd(renderPass);
     wgpuRenderPassEncoderRelease(renderPass);
@@ -1188,10 +1344,8 @@ fn fs_main(in: VertexOutput) -> @location(0) vec4f {
     wgpuCommandEncoderRelease(encoder);  // release encoder after it's finished
 
     // Finally submit the command queue
-    // std::cout << "Submitting command..." << std::endl;
-    wgpuQueueSubmit(webgpuRes->queue, 1, &command);
+    wgpuQueueSubmit(frame.queue, 1, &command);
     wgpuCommandBufferRelease(command);
-    // std::cout << "Command submitted." << std::endl;
 
     // [...] Present the surface onto the window
     wgpuTextureViewRelease(targetView);
@@ -1205,7 +1359,7 @@ fn fs_main(in: VertexOutput) -> @location(0) vec4f {
 // on emscripten_set_main_loop_arg (a.k.a. requestAnimationFrame in JavaScript) to call our
 // MainLoop() function right before presenting.
 #ifndef __EMSCRIPTEN__
-    wgpuSurfacePresent(webgpuRes->surface);
+    wgpuSurfacePresent(frame.surface);
 #endif
 
 #ifdef WEBGPU_BACKEND_WGPU
@@ -1213,6 +1367,94 @@ fn fs_main(in: VertexOutput) -> @location(0) vec4f {
 #endif
   }
 
+  void CreateRenderGroups(Resources &res, entt::registry &world) {
+    owning_group<GpuMeshComponent, TransformComponent, MaterialComponent>(res, world);
+  }
+
+  static FrameRenderer &GetFrameRenderer(Resources &res, bool pipelined) {
+    if (auto *renderer = res.get<FrameRenderer>()) return *renderer;
+#ifdef __EMSCRIPTEN__
+    pipelined = false;  // 浏览器在主循环返回后呈现，不能在其他线程上渲染
+#endif
+    return res.insert<FrameRenderer>(RenderExtractedFrame, pipelined);
+  }
+
+  // 还没有渲染器时没有在渲染的帧，不创建渲染器
+  static void WaitRenderIdle(Resources &res) {
+    if (auto *renderer = res.get<FrameRenderer>()) renderer->wait_idle();
+  }
+
+  static void ExtractAndSubmit(Resources &res, entt::registry &world, FrameRenderer &renderer) {
+    auto webgpuRes = res.get<WebGPUResources>();
+    if (!webgpuRes) {
+      VividLogger::app_error("Could not get WebGPU resources!");
+      return;
+    }
+    // Check current window pixel size (SDL window queries stay on the main thread)
+    int pixel_width = 0;
+    int pixel_height = 0;
+    {
+      auto view = world.view<VIVID::Window::WindowGpuComponent>();
+      view.each([&](auto entity, auto &gpu_comp) {
+        if (gpu_comp.window_handle) {
+          SDL_GetWindowSizeInPixels(gpu_comp.window_handle, &pixel_width, &pixel_height);
+        }
+      });
+    }
+
+    // 填充本帧数据，与渲染线程处理上一帧并行
+    RenderFrame &frame = renderer.write_frame();
+    frame.valid = false;
+    ImDrawData *imguiDrawData = nullptr;
+    if (ImGui::GetCurrentContext()) {
+      // UI built earlier in Update stage
+      ImGui::Render();
+      imguiDrawData = ImGui::GetDrawData();
+      CopyImGuiDrawData(imguiDrawData, frame);
+    }
+    const bool minimized = pixel_width <= 0 || pixel_height <= 0;
+    if (!minimized) ExtractScene(res, world, frame, pixel_width, pixel_height);
+
+    // 以下修改 GPU 状态，等渲染线程处理完上一帧
+    renderer.wait_idle();
+    // 本帧提取时已经不包含被移除的实体，上一帧处理完后它们的 GPU 对象不再被使用
+    if (auto *releases = res.get<GpuReleaseQueue>()) releases->flush(res.get<PipelineCache>());
+    if (imguiDrawData && imguiDrawData->Textures) {
+      for (ImTextureData *texture : *imguiDrawData->Textures) {
+        if (texture->Status != ImTextureStatus_OK) ImGui_ImplWGPU_UpdateTexture(texture);
+      }
+    }
+
+    if (minimized) {
+      // Minimized or not ready; skip this frame
+      return;
+    }
+    if (renderer.previous_frame().surfaceLost
+        || webgpuRes->configuredWidth != static_cast<uint32_t>(pixel_width)
+        || webgpuRes->configuredHeight != static_cast<uint32_t>(pixel_height)) {
+      renderer.previous_frame().surfaceLost = false;
+      ReconfigureSurface(res, world, static_cast<uint32_t>(pixel_width),
+                         static_cast<uint32_t>(pixel_height));
+      // Skip this frame after reconfiguration
+      return;
+    }
+
+    frame.valid = true;
+    frame.device = webgpuRes->device;
+    frame.queue = webgpuRes->queue;
+    frame.surface = webgpuRes->surface;
+    frame.depthView = webgpuRes->depthView;
+    renderer.submit();
+  }
+
+  void ExtractRender(Resources &res, entt::registry &world) {
+    ExtractAndSubmit(res, world, GetFrameRenderer(res, true));
+  }
+
+  void Draw(Resources &res, entt::registry &world) {
+    ExtractAndSubmit(res, world, GetFrameRenderer(res, false));
+  }
+
   void CreatePipeline(Resources &res, entt::registry &world) {
     VividLogger::app_debug("Creating WebGPU pipeline...");
     auto webgpuRes = res.get<WebGPUResources>();
@@ -1306,40 +1548,26 @@ fn fs_main(in: VertexOutput) -> @location(0) vec4f {
   void ReleaseWebGPUResources(Resources &res, entt::registry &world) {
     VividLogger::app_debug("Releasing WebGPU instance...");
 
+    // 先让渲染线程提交完最后一帧并退出，之后不再有其他线程使用 GPU 对象
+    if (auto *renderer = res.get<FrameRenderer>()) renderer->stop();
+
     // Release all per-entity GPU resources first
     {
-      auto view = world.view<GpuMeshComponent>();
-      view.each([&](auto entity, GpuMeshComponent &gpu) {
-        if (gpu.bindGroup) {
-          wgpuBindGroupRelease(gpu.bindGroup);
-          gpu.bindGroup = nullptr;
-        }
-        if (gpu.uniformBuffer) {
-          wgpuBufferRelease(gpu.uniformBuffer);
-          gpu.uniformBuffer = nullptr;
-        }
-        if (gpu.vertexBuffer) {
-          wgpuBufferRelease(gpu.vertexBuffer);
-          gpu.vertexBuffer = nullptr;
-        }
-        if (gpu.indexBuffer) {
-          wgpuBufferRelease(gpu.indexBuffer);
-          gpu.indexBuffer = nullptr;
-        }
-        if (gpu.pipeline) {
-          wgpuRenderPipelineRelease(gpu.pipeline);
-          gpu.pipeline = nullptr;
-        }
-        if (gpu.layout) {
-          wgpuPipelineLayoutRelease(gpu.layout);
-          gpu.layout = nullptr;
-        }
-        if (gpu.bindGroupLayout) {
-          wgpuBindGroupLayoutRelease(gpu.bindGroupLayout);
-          gpu.bindGroupLayout = nullptr;
-        }
-      });
+      // 移除组件时 GpuReleaseQueue 收集每个实体的对象，渲染线程已经停止，直接释放
+      auto *pipelines = res.get<PipelineCache>();
       world.clear<GpuMeshComponent>();
+      if (auto *releases = res.get<GpuReleaseQueue>()) releases->flush(pipelines);
+      res.remove<GpuReleaseQueue>();
+      if (auto *meshBuffers = res.get<GpuMeshBuffers>()) {
+        for (auto &mesh : meshBuffers->meshes) {
+          if (mesh.vertexBuffer) wgpuBufferRelease(mesh.vertexBuffer);
+          if (mesh.indexBuffer) wgpuBufferRelease(mesh.indexBuffer);
+        }
+        res.remove<GpuMeshBuffers>();
+      }
+      // 共享的管线、布局和着色器模块在设备之前释放
+      if (pipelines) pipelines->clear();
+      res.remove<PipelineCache>();
     }
 
     auto webgpuRes = res.get<WebGPUResources>();
@@ -1371,6 +1599,8 @@ fn fs_main(in: VertexOutput) -> @location(0) vec4f {
     }
   }
 
+  void RegisterCloneComponents(Scene::WorldClone &clone) { clone.ignore<GpuMeshComponent>(); }
+
 }  // namespace VIVID::Render
 
 ShaderProgramSource ParseShader(const std::string &filepath) {
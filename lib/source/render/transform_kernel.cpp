@@ -0,0 +1,308 @@
+#include "vivid/render/transform_kernel.h"
+
+#include "vivid/rendering/render_component.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define VIVID_TRANSFORM_SSE 1
+#  include <xmmintrin.h>
+#endif
+#if defined(VIVID_TRANSFORM_SSE) && defined(__AVX__)
+#  define VIVID_TRANSFORM_AVX 1
+#  include <immintrin.h>
+#endif
+
+namespace VIVID::Render {
+
+  namespace {
+
+#if defined(VIVID_TRANSFORM_SSE)
+    inline const float *matrix_at(const unsigned char *base, size_t stride, size_t index) {
+      return reinterpret_cast<const float *>(base + index * stride);
+    }
+
+    inline float *matrix_at(unsigned char *base, size_t stride, size_t index) {
+      return reinterpret_cast<float *>(base + index * stride);
+    }
+
+    // 4 个矩阵一组
+    struct Sse {
+      using V = __m128;
+      static constexpr size_t kWidth = 4;
+
+      static V mul(V a, V b) { return _mm_mul_ps(a, b); }
+      static V sub(V a, V b) { return _mm_sub_ps(a, b); }
+      static V add(V a, V b) { return _mm_add_ps(a, b); }
+      static V set1(float value) { return _mm_set1_ps(value); }
+      static V load(const float *lanes) { return _mm_loadu_ps(lanes); }
+
+      // 1 / d，d 为 0 的通道为 0
+      static V safe_rcp(V d) {
+        const V nonzero = _mm_cmpneq_ps(d, _mm_setzero_ps());
+        return _mm_and_ps(_mm_div_ps(_mm_set1_ps(1.0f), d), nonzero);
+      }
+
+      // 第 first 个起的 4 个矩阵第 column 列的 xyz，转置为 SoA
+      static void gather(const unsigned char *base, size_t stride, size_t first, int column,
+                         V out[3]) {
+        V r0 = _mm_loadu_ps(matrix_at(base, stride, first + 0) + column * 4);
+        V r1 = _mm_loadu_ps(matrix_at(base, stride, first + 1) + column * 4);
+        V r2 = _mm_loadu_ps(matrix_at(base, stride, first + 2) + column * 4);
+        V r3 = _mm_loadu_ps(matrix_at(base, stride, first + 3) + column * 4);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        out[0] = r0;
+        out[1] = r1;
+        out[2] = r2;
+      }
+
+      // gather 的逆操作，w 分量取自 w
+      static void scatter(unsigned char *base, size_t stride, size_t first, int column,
+                          const V in[3], V w) {
+        V r0 = in[0], r1 = in[1], r2 = in[2], r3 = w;
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _mm_storeu_ps(matrix_at(base, stride, first + 0) + column * 4, r0);
+        _mm_storeu_ps(matrix_at(base, stride, first + 1) + column * 4, r1);
+        _mm_storeu_ps(matrix_at(base, stride, first + 2) + column * 4, r2);
+        _mm_storeu_ps(matrix_at(base, stride, first + 3) + column * 4, r3);
+      }
+    };
+
+#  if defined(VIVID_TRANSFORM_AVX)
+    // 8 个矩阵一组：分两半用 SSE 转置，拼成 256 位寄存器计算
+    struct Avx {
+      using V = __m256;
+      static constexpr size_t kWidth = 8;
+
+      static V mul(V a, V b) { return _mm256_mul_ps(a, b); }
+      static V sub(V a, V b) { return _mm256_sub_ps(a, b); }
+      static V add(V a, V b) { return _mm256_add_ps(a, b); }
+      static V set1(float value) { return _mm256_set1_ps(value); }
+      static V load(const float *lanes) { return _mm256_loadu_ps(lanes); }
+
+      static V safe_rcp(V d) {
+        const V nonzero = _mm256_cmp_ps(d, _mm256_setzero_ps(), _CMP_NEQ_UQ);
+        return _mm256_and_ps(_mm256_div_ps(_mm256_set1_ps(1.0f), d), nonzero);
+      }
+
+      static void gather(const unsigned char *base, size_t stride, size_t first, int column,
+                         V out[3]) {
+        __m128 lo[3], hi[3];
+        Sse::gather(base, stride, first, column, lo);
+        Sse::gather(base, stride, first + 4, column, hi);
+        for (int k = 0; k < 3; ++k) {
+          out[k] = _mm256_insertf128_ps(_mm256_castps128_ps256(lo[k]), hi[k], 1);
+        }
+      }
+
+      static void scatter(unsigned char *base, size_t stride, size_t first, int column,
+                          const V in[3], V w) {
+        __m128 lo[3], hi[3];
+        for (int k = 0; k < 3; ++k) {
+          lo[k] = _mm256_castps256_ps128(in[k]);
+          hi[k] = _mm256_extractf128_ps(in[k], 1);
+        }
+        Sse::scatter(base, stride, first, column, lo, _mm256_castps256_ps128(w));
+        Sse::scatter(base, stride, first + 4, column, hi, _mm256_extractf128_ps(w, 1));
+      }
+    };
+#  endif
+
+    // 由 SoA 的三列 a[列][分量] 写出一组法线矩阵：三次叉积 + 一次除法
+    template <typename Ops>
+    void store_normals(const typename Ops::V a[3][3], unsigned char *normals, size_t stride,
+                       size_t first) {
+      using V = typename Ops::V;
+      auto cross = [](const V u[3], const V v[3], V out[3]) {
+        out[0] = Ops::sub(Ops::mul(u[1], v[2]), Ops::mul(u[2], v[1]));
+        out[1] = Ops::sub(Ops::mul(u[2], v[0]), Ops::mul(u[0], v[2]));
+        out[2] = Ops::sub(Ops::mul(u[0], v[1]), Ops::mul(u[1], v[0]));
+      };
+      V n[3][3];
+      cross(a[1], a[2], n[0]);
+      cross(a[2], a[0], n[1]);
+      cross(a[0], a[1], n[2]);
+
+      const V det = Ops::add(Ops::add(Ops::mul(a[0][0], n[0][0]), Ops::mul(a[0][1], n[0][1])),
+                             Ops::mul(a[0][2], n[0][2]));
+      const V inv = Ops::safe_rcp(det);
+      for (int column = 0; column < 3; ++column) {
+        for (int k = 0; k < 3; ++k) n[column][k] = Ops::mul(n[column][k], inv);
+        Ops::scatter(normals, stride, first, column, n[column], Ops::set1(0.0f));
+      }
+
+      const __m128 last = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+      for (size_t i = 0; i < Ops::kWidth; ++i) {
+        _mm_storeu_ps(matrix_at(normals, stride, first + i) + 12, last);
+      }
+    }
+
+    // 一组 Ops::kWidth 个模型矩阵的法线矩阵
+    template <typename Ops>
+    void normal_block(const unsigned char *models, unsigned char *normals, size_t stride,
+                      size_t first) {
+      typename Ops::V a[3][3];  // a[列][分量]
+      for (int column = 0; column < 3; ++column) {
+        Ops::gather(models, stride, first, column, a[column]);
+      }
+      store_normals<Ops>(a, normals, stride, first);
+    }
+
+    // 一组 Ops::kWidth 个变换转为 SoA：旋转缩放后的三列 a[列][分量]（R · S）和位置 p
+    template <typename Ops>
+    void transform_columns(const TransformComponent *const *transforms, size_t first,
+                           typename Ops::V a[3][3], typename Ops::V p[3]) {
+      using V = typename Ops::V;
+      // 每个分量一行，逐个变换填入后整行载入
+      float lanes[10][Ops::kWidth];
+      for (size_t i = 0; i < Ops::kWidth; ++i) {
+        const TransformComponent &transform = *transforms[first + i];
+        lanes[0][i] = transform.Position.x;
+        lanes[1][i] = transform.Position.y;
+        lanes[2][i] = transform.Position.z;
+        lanes[3][i] = transform.Rotation.w;
+        lanes[4][i] = transform.Rotation.x;
+        lanes[5][i] = transform.Rotation.y;
+        lanes[6][i] = transform.Rotation.z;
+        lanes[7][i] = transform.Scale.x;
+        lanes[8][i] = transform.Scale.y;
+        lanes[9][i] = transform.Scale.z;
+      }
+      for (int k = 0; k < 3; ++k) p[k] = Ops::load(lanes[k]);
+      const V w = Ops::load(lanes[3]);
+      const V x = Ops::load(lanes[4]);
+      const V y = Ops::load(lanes[5]);
+      const V z = Ops::load(lanes[6]);
+
+      // 单位四元数转旋转矩阵，与 glm::mat3_cast 相同
+      const V one = Ops::set1(1.0f);
+      const V two = Ops::set1(2.0f);
+      const V xx = Ops::mul(x, x), yy = Ops::mul(y, y), zz = Ops::mul(z, z);
+      const V xy = Ops::mul(x, y), xz = Ops::mul(x, z), yz = Ops::mul(y, z);
+      const V wx = Ops::mul(w, x), wy = Ops::mul(w, y), wz = Ops::mul(w, z);
+      a[0][0] = Ops::sub(one, Ops::mul(two, Ops::add(yy, zz)));
+      a[0][1] = Ops::mul(two, Ops::add(xy, wz));
+      a[0][2] = Ops::mul(two, Ops::sub(xz, wy));
+      a[1][0] = Ops::mul(two, Ops::sub(xy, wz));
+      a[1][1] = Ops::sub(one, Ops::mul(two, Ops::add(xx, zz)));
+      a[1][2] = Ops::mul(two, Ops::add(yz, wx));
+      a[2][0] = Ops::mul(two, Ops::add(xz, wy));
+      a[2][1] = Ops::mul(two, Ops::sub(yz, wx));
+      a[2][2] = Ops::sub(one, Ops::mul(two, Ops::add(xx, yy)));
+
+      for (int column = 0; column < 3; ++column) {
+        const V scale = Ops::load(lanes[7 + column]);
+        for (int k = 0; k < 3; ++k) a[column][k] = Ops::mul(a[column][k], scale);
+      }
+    }
+
+    // 写出一组模型矩阵 T · R · S：前三列 w 为 0，第四列为 (p, 1)
+    template <typename Ops>
+    void store_models(const typename Ops::V a[3][3], const typename Ops::V p[3],
+                      unsigned char *models, size_t stride, size_t first) {
+      for (int column = 0; column < 3; ++column) {
+        Ops::scatter(models, stride, first, column, a[column], Ops::set1(0.0f));
+      }
+      Ops::scatter(models, stride, first, 3, p, Ops::set1(1.0f));
+    }
+
+    template <typename Ops>
+    void model_block(const TransformComponent *const *transforms, unsigned char *models,
+                     size_t stride, size_t first) {
+      typename Ops::V a[3][3], p[3];
+      transform_columns<Ops>(transforms, first, a, p);
+      store_models<Ops>(a, p, models, stride, first);
+    }
+
+    // 模型矩阵和法线矩阵一起：R · S 的三列留在寄存器中直接求法线矩阵
+    template <typename Ops>
+    void model_normal_block(const TransformComponent *const *transforms, unsigned char *models,
+                            unsigned char *normals, size_t stride, size_t first) {
+      typename Ops::V a[3][3], p[3];
+      transform_columns<Ops>(transforms, first, a, p);
+      store_models<Ops>(a, p, models, stride, first);
+      store_normals<Ops>(a, normals, stride, first);
+    }
+#endif
+
+  }  // namespace
+
+  glm::mat4 normal_matrix(const glm::mat4 &model) {
+    const glm::vec3 a0(model[0]), a1(model[1]), a2(model[2]);
+    const glm::vec3 n0 = glm::cross(a1, a2);
+    const glm::vec3 n1 = glm::cross(a2, a0);
+    const glm::vec3 n2 = glm::cross(a0, a1);
+    const float det = glm::dot(a0, n0);
+    const float inv = det != 0.0f ? 1.0f / det : 0.0f;
+
+    glm::mat4 normal(1.0f);
+    normal[0] = glm::vec4(n0 * inv, 0.0f);
+    normal[1] = glm::vec4(n1 * inv, 0.0f);
+    normal[2] = glm::vec4(n2 * inv, 0.0f);
+    return normal;
+  }
+
+  void compute_normal_matrices(const glm::mat4 *models, glm::mat4 *normals, size_t count,
+                               size_t stride) {
+    const auto *src = reinterpret_cast<const unsigned char *>(models);
+    auto *dst = reinterpret_cast<unsigned char *>(normals);
+    size_t i = 0;
+#if defined(VIVID_TRANSFORM_AVX)
+    for (; i + Avx::kWidth <= count; i += Avx::kWidth) normal_block<Avx>(src, dst, stride, i);
+#endif
+#if defined(VIVID_TRANSFORM_SSE)
+    for (; i + Sse::kWidth <= count; i += Sse::kWidth) normal_block<Sse>(src, dst, stride, i);
+#endif
+    for (; i < count; ++i) {
+      const auto &model = *reinterpret_cast<const glm::mat4 *>(src + i * stride);
+      *reinterpret_cast<glm::mat4 *>(dst + i * stride) = normal_matrix(model);
+    }
+  }
+
+  void compute_model_matrices(const TransformComponent *const *transforms, glm::mat4 *models,
+                              size_t count, size_t stride) {
+    auto *dst = reinterpret_cast<unsigned char *>(models);
+    size_t i = 0;
+#if defined(VIVID_TRANSFORM_AVX)
+    for (; i + Avx::kWidth <= count; i += Avx::kWidth) model_block<Avx>(transforms, dst, stride, i);
+#endif
+#if defined(VIVID_TRANSFORM_SSE)
+    for (; i + Sse::kWidth <= count; i += Sse::kWidth) model_block<Sse>(transforms, dst, stride, i);
+#endif
+    for (; i < count; ++i) {
+      *reinterpret_cast<glm::mat4 *>(dst + i * stride) = transforms[i]->GetTransform();
+    }
+  }
+
+  void compute_model_normal_matrices(const TransformComponent *const *transforms,
+                                     glm::mat4 *models, glm::mat4 *normals, size_t count,
+                                     size_t stride) {
+    auto *model_dst = reinterpret_cast<unsigned char *>(models);
+    auto *normal_dst = reinterpret_cast<unsigned char *>(normals);
+    size_t i = 0;
+#if defined(VIVID_TRANSFORM_AVX)
+    for (; i + Avx::kWidth <= count; i += Avx::kWidth) {
+      model_normal_block<Avx>(transforms, model_dst, normal_dst, stride, i);
+    }
+#endif
+#if defined(VIVID_TRANSFORM_SSE)
+    for (; i + Sse::kWidth <= count; i += Sse::kWidth) {
+      model_normal_block<Sse>(transforms, model_dst, normal_dst, stride, i);
+    }
+#endif
+    for (; i < count; ++i) {
+      const glm::mat4 model = transforms[i]->GetTransform();
+      *reinterpret_cast<glm::mat4 *>(model_dst + i * stride) = model;
+      *reinterpret_cast<glm::mat4 *>(normal_dst + i * stride) = normal_matrix(model);
+    }
+  }
+
+  const char *transform_kernel_isa() {
+#if defined(VIVID_TRANSFORM_AVX)
+    return "avx";
+#elif defined(VIVID_TRANSFORM_SSE)
+    return "sse";
+#else
+    return "scalar";
+#endif
+  }
+
+}  // namespace VIVID::Render
@@ -1,49 +1,23 @@
 #include <vivid/rendering/render_plugin.h>
 
 #include <entt/entity/registry.hpp>
-#include <iostream>
 
 #include "vivid/app/App.h"
 #include "vivid/rendering/render_component.h"
 #include "vivid/rendering/render_system.h"
 
-namespace {
-  // Helper function to keep renderer in sync with component changes
-  void OnComponentChange(entt::registry &registry, entt::entity entity) {
-    // This function is triggered whenever a MeshComponent or MaterialComponent
-    // is added or updated. It calls the RendererSystem's Sync function
-    // to ensure GPU resources are created or updated accordingly.
-    // if (auto *res_ptr = registry.ctx().find<Resources *>()) {
-    VIVID::Sync_system(registry);
-    // }
-    std::cout << "Component changed" << std::endl;
-  }
-
-  void ListenComponentChange_system(Resources &res, entt::registry &world) {
-    // --- Register Components ---
-    // VIVID::ComponentRegistry::RegisterAllComponents();
-    // world.ctx().emplace<Resources *>(&res);
-    // --- ECS Listeners ---
-    world.on_construct<MeshComponent>().connect<&OnComponentChange>();
-    world.on_update<MeshComponent>().connect<&OnComponentChange>();
-    world.on_construct<MaterialComponent>().connect<&OnComponentChange>();
-    world.on_update<MaterialComponent>().connect<&OnComponentChange>();
-  }
-
-  // void render_update_system(Resources &, entt::registry &world) {
-  //   VIVID::RendererSystem::Update(world);
-  // }
-
-  // void render_shutdown_system(Resources &, entt::registry &) { VIVID::RendererSystem::Shutdown();
-  // }
-
-}  // anonymous namespace
-
 void RenderPlugin::build(App &app) {
+  // 每帧绘制的组件组合：由拥有型分组保持紧密排列
+  app.add_group<TransformComponent, GpuMeshComponent, GpuMaterialComponent, MaterialComponent>();
   app.add_system(ScheduleLabel::Startup, VIVID::Init_system);
-  app.add_system(ScheduleLabel::Startup, ListenComponentChange_system);
   app.add_system(ScheduleLabel::Startup, VIVID::Sync_system);
-  app.add_system(ScheduleLabel::Update, VIVID::Update_system);
+  // 只有新增了网格或材质时才需要创建 GPU 资源，静态场景下整帧跳过
+  app.add_system(ScheduleLabel::Update, VIVID::Sync_system,
+                 SystemConfig("render_sync")
+                     .run_if(any_added<MeshComponent>() || any_added<MeshHandle>()
+                             || any_added<MaterialComponent>())
+                     .before("render_update"));
+  app.add_system(ScheduleLabel::Update, VIVID::Update_system, SystemConfig("render_update"));
   app.add_system(ScheduleLabel::Shutdown, VIVID::Shutdown_system);
 }
 
@@ -8,7 +8,9 @@
 
 #include "vivid/input/camera_controller.h"
 #include "vivid/opengl/GLErrorHandler.h"
+#include "vivid/render/transform_kernel.h"
 #include "vivid/rendering/render_component.h"
+#include "vivid/scene/mesh_assets.h"
 
 namespace VIVID {
   // helper functions
@@ -162,43 +164,86 @@ namespace VIVID {
     res.insert<FrameBuffer>(1280, 720);
   }
 
-  void Shutdown_system(Resources &res, entt::registry &world) { res.remove<FrameBuffer>(); }
+  // 每个网格资源的 VAO / VBO / IBO，按 MeshHandle::Index 索引，同一网格的实体共享
+  struct GlMeshBuffers {
+    std::vector<GpuMeshComponent> meshes;
+  };
+
+  void Shutdown_system(Resources &res, entt::registry &world) {
+    if (auto *buffers = res.get<GlMeshBuffers>()) {
+      for (auto &mesh : buffers->meshes) {
+        if (mesh.VAO_ID == 0) continue;
+        GLCall(glDeleteVertexArrays(1, &mesh.VAO_ID));
+        GLCall(glDeleteBuffers(1, &mesh.VBO_ID));
+        GLCall(glDeleteBuffers(1, &mesh.IBO_ID));
+      }
+      res.remove<GlMeshBuffers>();
+    }
+    res.remove<FrameBuffer>();
+  }
+
+  // 上传一个网格资源，已经上传过时直接返回
+  static const GpuMeshComponent &UploadMesh(GlMeshBuffers &buffers, Scene::MeshAssets &meshes,
+                                            MeshHandle handle, const Scene::Mesh &mesh) {
+    if (handle.Index >= buffers.meshes.size()) buffers.meshes.resize(handle.Index + 1);
+    GpuMeshComponent &gpu = buffers.meshes[handle.Index];
+    if (gpu.VAO_ID != 0 || !mesh.HasCpuData()) return gpu;
+
+    // 创建和绑定VBO
+    unsigned int vboID;
+    GLCall(glGenBuffers(1, &vboID));
+    GLCall(glBindBuffer(GL_ARRAY_BUFFER, vboID));
+    GLCall(glBufferData(GL_ARRAY_BUFFER, mesh.VertexBytes, mesh.Vertices.data(), GL_STATIC_DRAW));
+
+    // 创建IBO
+    unsigned int iboID;
+    GLCall(glGenBuffers(1, &iboID));
+    GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, iboID));
+    GLCall(glBufferData(GL_ELEMENT_ARRAY_BUFFER, mesh.IndexBytes, mesh.Indices.data(),
+                        GL_STATIC_DRAW));
+
+    // 创建和绑定VAO
+    unsigned int vaoID;
+    GLCall(glGenVertexArrays(1, &vaoID));
+    GLCall(glBindVertexArray(vaoID));
+    GLCall(glBindBuffer(GL_ARRAY_BUFFER, vboID));
+
+    // 设置顶点属性指针
+    GLCall(glEnableVertexAttribArray(0));
+    GLCall(glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float),
+                                 (void *)0));  // position 0
+    GLCall(glEnableVertexAttribArray(1));
+    GLCall(glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float),
+                                 (void *)(3 * sizeof(float))));  // normal 1
+
+    gpu = GpuMeshComponent{vaoID, vboID, iboID, mesh.IndexCount};
+    if (meshes.release_after_upload()) meshes.release_cpu_data(handle);
+    return gpu;
+  }
 
-  void Sync_system(entt::registry &registry) {
+  void Sync_system(Resources &res, entt::registry &registry) {
     // We only want to process entities that have the CPU-side data (Mesh, Material)
     // but DO NOT have the GPU-side data (GpuMeshComponent) yet.
     // Using entt::exclude prevents us from re-processing entities and leaking resources.
-    auto view = registry.view<MeshComponent, MaterialComponent>(entt::exclude<GpuMeshComponent>);
-    view.each([&](auto entity, auto &mesh, auto &material) {
-      if (mesh.m_Vertices.empty() || mesh.m_Indices.empty() || material.ShaderPath.empty()) return;
-
-      // 创建和绑定VBO
-      unsigned int vboID;
-      GLCall(glGenBuffers(1, &vboID));
-      GLCall(glBindBuffer(GL_ARRAY_BUFFER, vboID));
-      GLCall(glBufferData(GL_ARRAY_BUFFER, mesh.m_Vertices.size() * sizeof(float),
-                          mesh.m_Vertices.data(), GL_STATIC_DRAW));
-
-      // 创建IBO
-      unsigned int iboID;
-      GLCall(glGenBuffers(1, &iboID));
-      GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, iboID));
-      GLCall(glBufferData(GL_ELEMENT_ARRAY_BUFFER, mesh.m_Indices.size() * sizeof(unsigned int),
-                          mesh.m_Indices.data(), GL_STATIC_DRAW));
-
-      // 创建和绑定VAO
-      unsigned int vaoID;
-      GLCall(glGenVertexArrays(1, &vaoID));
-      GLCall(glBindVertexArray(vaoID));
-      GLCall(glBindBuffer(GL_ARRAY_BUFFER, vboID));
-
-      // 设置顶点属性指针
-      GLCall(glEnableVertexAttribArray(0));
-      GLCall(glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float),
-                                   (void *)0));  // position 0
-      GLCall(glEnableVertexAttribArray(1));
-      GLCall(glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float),
-                                   (void *)(3 * sizeof(float))));  // normal 1
+    // GPU 组件在遍历结束后再添加：它们属于渲染的拥有型分组，添加时会重排 MaterialComponent 的存储
+    struct PendingGpu {
+      entt::entity entity;
+      GpuMeshComponent mesh;
+      GpuMaterialComponent material;
+    };
+    std::vector<PendingGpu> pending;
+    // 顶点数据来自网格资源：仍然使用 MeshComponent 的实体先补上句柄，内容相同的网格只上传一次
+    auto &meshes = Scene::mesh_assets(res);
+    Scene::intern_meshes(registry, meshes);
+    auto *buffers = res.get<GlMeshBuffers>();
+    if (!buffers) buffers = &res.insert<GlMeshBuffers>();
+    auto view = registry.view<MeshHandle, MaterialComponent>(entt::exclude<GpuMeshComponent>);
+    view.each([&](auto entity, const MeshHandle &handle, auto &material) {
+      const Scene::Mesh *mesh = meshes.get(handle);
+      if (!mesh || mesh->IndexCount == 0 || material.ShaderPath.empty()) return;
+
+      const GpuMeshComponent &gpuMesh = UploadMesh(*buffers, meshes, handle, *mesh);
+      if (gpuMesh.VAO_ID == 0) return;
 
       // shader
       unsigned int shaderProgramID;
@@ -207,22 +252,20 @@ namespace VIVID {
 
       // Check if shader creation failed
       if (shaderProgramID == 0) {
+        // 网格缓冲区由其他实例共享，保留在 GlMeshBuffers 中
         std::cerr << "Failed to create shader program for entity. Skipping GPU component creation."
                   << std::endl;
-        // Clean up already created OpenGL resources
-        GLCall(glDeleteVertexArrays(1, &vaoID));
-        GLCall(glDeleteBuffers(1, &vboID));
-        GLCall(glDeleteBuffers(1, &iboID));
         return;  // Skip this entity
       }
 
-      // Now we use emplace, because we know the component doesn't exist yet.
-      registry.emplace<GpuMeshComponent>(
-          entity, GpuMeshComponent{vaoID, vboID, iboID, (unsigned int)mesh.m_Indices.size()});
-
-      // GpuMaterialComponent 同理
-      registry.emplace<GpuMaterialComponent>(entity, shaderProgramID);
+      pending.push_back(PendingGpu{entity, gpuMesh, GpuMaterialComponent{shaderProgramID}});
     });
+
+    // Now we use emplace, because we know the components don't exist yet.
+    for (const auto &gpu : pending) {
+      registry.emplace<GpuMeshComponent>(gpu.entity, gpu.mesh);
+      registry.emplace<GpuMaterialComponent>(gpu.entity, gpu.material);
+    }
   }
 
   void ClearColor_system(Resources &res, entt::registry &registry) {
@@ -297,16 +340,19 @@ namespace VIVID {
     auto &lightComponent = lightView.get<LightComponent>(lightEntity);
 
     // Render all entities with GPU data
-    auto renderableView = registry.view<TransformComponent, GpuMeshComponent, GpuMaterialComponent,
-                                        MaterialComponent>();
-    renderableView.each([&](auto entity, auto &transform, auto &gpuMesh, auto &gpuMaterial,
-                            auto &material) {
+    // 拥有型分组（RenderPlugin 构建时创建），遍历紧密排列的组件数组
+    auto renderables = owning_group<TransformComponent, GpuMeshComponent, GpuMaterialComponent,
+                                    MaterialComponent>(res, registry);
+    renderables.each([&](auto entity, auto &transform, auto &gpuMesh, auto &gpuMaterial,
+                         auto &material) {
       GLCall(glUseProgram(gpuMaterial.ShaderProgram_ID));
       GLCall(glBindVertexArray(gpuMesh.VAO_ID));
       GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gpuMesh.IBO_ID));
 
-      glm::mat4 modelMatrix = transform.GetTransform();
-      glm::mat4 normalMatrix = glm::transpose(glm::inverse(modelMatrix));
+      // 有层级时使用 transform_propagate 缓存的世界矩阵
+      const auto *global = registry.try_get<GlobalTransformComponent>(entity);
+      glm::mat4 modelMatrix = global ? global->Matrix : transform.GetTransform();
+      glm::mat4 normalMatrix = Render::normal_matrix(modelMatrix);
 
       // --- 设置所有Uniforms ---
 
@@ -0,0 +1,121 @@
+#include "vivid/scene/mesh_assets.h"
+
+#include <cstring>
+#include <utility>
+
+#include "vivid/app/Resources.h"
+
+namespace VIVID::Scene {
+
+  namespace {
+
+    // FNV-1a，依次累加顶点和索引的字节
+    uint64_t fnv1a(uint64_t hash, const void *data, size_t size) {
+      const auto *bytes = static_cast<const unsigned char *>(data);
+      for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+      }
+      return hash;
+    }
+
+    uint64_t hash_mesh(const std::vector<float> &vertices,
+                       const std::vector<unsigned int> &indices) {
+      uint64_t hash = 14695981039346656037ull;
+      const uint64_t sizes[2] = {vertices.size(), indices.size()};
+      hash = fnv1a(hash, sizes, sizeof(sizes));
+      hash = fnv1a(hash, vertices.data(), vertices.size() * sizeof(float));
+      return fnv1a(hash, indices.data(), indices.size() * sizeof(unsigned int));
+    }
+
+    // 与 hash_mesh 独立的第二个哈希：按 32 位字乘法混合，CPU 副本释放后与 hash_mesh 一起比较
+    uint64_t check_mesh(const std::vector<float> &vertices,
+                        const std::vector<unsigned int> &indices) {
+      auto mix = [](uint64_t hash, uint32_t word) {
+        hash = (hash ^ word) * 0x9E3779B97F4A7C15ull;
+        return hash ^ (hash >> 29);
+      };
+      uint64_t hash = mix(mix(0x2545F4914F6CDD1Dull, static_cast<uint32_t>(vertices.size())),
+                          static_cast<uint32_t>(indices.size()));
+      for (float vertex : vertices) {
+        uint32_t word;
+        std::memcpy(&word, &vertex, sizeof(word));
+        hash = mix(hash, word);
+      }
+      for (unsigned int index : indices) hash = mix(hash, index);
+      hash ^= hash >> 32;
+      return hash * 0xD6E8FEB86659FD93ull;
+    }
+
+  }  // namespace
+
+  MeshHandle MeshAssets::add(const std::vector<float> &vertices,
+                             const std::vector<unsigned int> &indices) {
+    if (vertices.empty() || indices.empty()) return {};
+
+    const uint64_t hash = hash_mesh(vertices, indices);
+    uint64_t check = 0;  // 遇到已释放 CPU 副本的网格时才计算
+    auto [first, last] = lookup_.equal_range(hash);
+    for (auto it = first; it != last; ++it) {
+      const Mesh &mesh = meshes_[it->second];
+      bool same;
+      if (mesh.HasCpuData()) {
+        same = mesh.Vertices == vertices && mesh.Indices == indices;
+      } else {
+        // CPU 副本已释放：大小和两个独立的 64 位哈希都相同才视为同一网格
+        if (check == 0) check = check_mesh(vertices, indices);
+        same = mesh.VertexBytes == vertices.size() * sizeof(float)
+               && mesh.IndexCount == indices.size() && mesh.Check == check;
+      }
+      if (same) return MeshHandle{it->second};
+    }
+
+    Mesh mesh;
+    mesh.Vertices = vertices;
+    mesh.Indices = indices;
+    mesh.Hash = hash;
+    mesh.VertexBytes = vertices.size() * sizeof(float);
+    mesh.IndexBytes = indices.size() * sizeof(unsigned int);
+    mesh.IndexCount = static_cast<uint32_t>(indices.size());
+
+    const auto index = static_cast<uint32_t>(meshes_.size());
+    meshes_.push_back(std::move(mesh));
+    lookup_.emplace(hash, index);
+    return MeshHandle{index};
+  }
+
+  const Mesh *MeshAssets::get(MeshHandle handle) const {
+    return handle.Index < meshes_.size() ? &meshes_[handle.Index] : nullptr;
+  }
+
+  void MeshAssets::release_cpu_data(MeshHandle handle) {
+    if (handle.Index >= meshes_.size()) return;
+    Mesh &mesh = meshes_[handle.Index];
+    if (!mesh.HasCpuData()) return;
+    mesh.Check = check_mesh(mesh.Vertices, mesh.Indices);
+    std::vector<float>().swap(mesh.Vertices);
+    std::vector<unsigned int>().swap(mesh.Indices);
+  }
+
+  size_t MeshAssets::heap_bytes() const {
+    return heap_size(meshes_) + lookup_.size() * (sizeof(uint64_t) + sizeof(uint32_t));
+  }
+
+  MeshAssets &mesh_assets(Resources &res) {
+    if (auto *meshes = res.get<MeshAssets>()) return *meshes;
+    return res.insert<MeshAssets>();
+  }
+
+  size_t intern_meshes(entt::registry &registry, MeshAssets &meshes) {
+    // 先收集再添加句柄，不在遍历视图时修改它排除的存储
+    std::vector<std::pair<entt::entity, MeshHandle>> interned;
+    auto view = registry.view<MeshComponent>(entt::exclude<MeshHandle>);
+    view.each([&](entt::entity entity, const MeshComponent &mesh) {
+      const MeshHandle handle = meshes.add(mesh);
+      if (handle.Valid()) interned.emplace_back(entity, handle);
+    });
+    for (const auto &[entity, handle] : interned) registry.emplace<MeshHandle>(entity, handle);
+    return interned.size();
+  }
+
+}  // namespace VIVID::Scene
@@ -0,0 +1,228 @@
+#include "vivid/scene/transform_hierarchy.h"
+
+#include <algorithm>
+
+#include "vivid/app/Resources.h"
+#include "vivid/render/transform_kernel.h"
+#include "vivid/rendering/render_component.h"
+
+namespace VIVID::Scene {
+
+  namespace {
+
+    bool same_local(const TransformComponent &a, const TransformComponent &b) {
+      return a.Position == b.Position && a.Rotation == b.Rotation && a.Scale == b.Scale;
+    }
+
+    // 从 parent 的子节点列表中移除 child
+    void unlink(entt::registry &registry, entt::entity parent, entt::entity child) {
+      if (parent == entt::null || !registry.valid(parent)) return;
+      if (auto *children = registry.try_get<ChildrenComponent>(parent)) {
+        auto &list = children->Children;
+        list.erase(std::remove(list.begin(), list.end(), child), list.end());
+      }
+    }
+
+  }  // namespace
+
+  bool set_parent(entt::registry &registry, entt::entity child, entt::entity parent) {
+    if (!registry.valid(child)) return false;
+    if (parent != entt::null) {
+      if (parent == child || !registry.valid(parent)) return false;
+      // 沿 parent 向上走，遇到 child 说明 parent 是 child 的子孙
+      for (entt::entity ancestor = parent; registry.valid(ancestor);) {
+        const auto *link = registry.try_get<ParentComponent>(ancestor);
+        if (!link) break;
+        if (link->Parent == child) return false;
+        ancestor = link->Parent;
+      }
+    }
+
+    auto *link = registry.try_get<ParentComponent>(child);
+    const entt::entity old_parent = link ? link->Parent : entt::null;
+    if (old_parent == parent) return true;
+
+    unlink(registry, old_parent, child);
+    if (parent == entt::null) {
+      registry.remove<ParentComponent>(child);
+      return true;
+    }
+
+    registry.get_or_emplace<ChildrenComponent>(parent).Children.push_back(child);
+    if (link) {
+      registry.patch<ParentComponent>(child, [parent](auto &p) { p.Parent = parent; });
+    } else {
+      registry.emplace<ParentComponent>(child, parent);
+    }
+    return true;
+  }
+
+  void remove_parent(entt::registry &registry, entt::entity child) {
+    set_parent(registry, child, entt::null);
+  }
+
+  void collect_descendants(const entt::registry &registry, entt::entity entity,
+                           std::vector<entt::entity> &out) {
+    size_t next = out.size();
+    for (entt::entity current = entity;;) {
+      if (const auto *children = registry.try_get<ChildrenComponent>(current)) {
+        out.insert(out.end(), children->Children.begin(), children->Children.end());
+      }
+      if (next == out.size()) break;
+      current = out[next++];
+    }
+  }
+
+  void destroy_recursive(entt::registry &registry, entt::entity entity) {
+    if (!registry.valid(entity)) return;
+    std::vector<entt::entity> subtree;
+    collect_descendants(registry, entity, subtree);
+    // 先销毁最深的节点，父节点的子节点列表不会指向已销毁的实体
+    for (auto it = subtree.rbegin(); it != subtree.rend(); ++it) {
+      if (registry.valid(*it)) registry.destroy(*it);
+    }
+    registry.destroy(entity);
+  }
+
+  // ---------------------------------------------------------------------------
+
+  TransformHierarchy::TransformHierarchy(entt::registry &registry) : registry_(&registry) {
+    registry.on_construct<ParentComponent>()
+        .connect<&TransformHierarchy::on_parent_changed>(*this);
+    registry.on_update<ParentComponent>().connect<&TransformHierarchy::on_parent_changed>(*this);
+    registry.on_destroy<ParentComponent>()
+        .connect<&TransformHierarchy::on_parent_destroyed>(*this);
+    registry.on_destroy<ChildrenComponent>()
+        .connect<&TransformHierarchy::on_children_destroyed>(*this);
+    registry.on_construct<GlobalTransformComponent>()
+        .connect<&TransformHierarchy::on_global_changed>(*this);
+    registry.on_destroy<GlobalTransformComponent>()
+        .connect<&TransformHierarchy::on_global_changed>(*this);
+  }
+
+  TransformHierarchy::~TransformHierarchy() {
+    registry_->on_construct<ParentComponent>()
+        .disconnect<&TransformHierarchy::on_parent_changed>(*this);
+    registry_->on_update<ParentComponent>()
+        .disconnect<&TransformHierarchy::on_parent_changed>(*this);
+    registry_->on_destroy<ParentComponent>()
+        .disconnect<&TransformHierarchy::on_parent_destroyed>(*this);
+    registry_->on_destroy<ChildrenComponent>()
+        .disconnect<&TransformHierarchy::on_children_destroyed>(*this);
+    registry_->on_construct<GlobalTransformComponent>()
+        .disconnect<&TransformHierarchy::on_global_changed>(*this);
+    registry_->on_destroy<GlobalTransformComponent>()
+        .disconnect<&TransformHierarchy::on_global_changed>(*this);
+  }
+
+  void TransformHierarchy::on_parent_changed(entt::registry &registry, entt::entity entity) {
+    order_dirty_ = true;
+    if (auto *global = registry.try_get<GlobalTransformComponent>(entity)) global->Dirty = true;
+  }
+
+  void TransformHierarchy::on_parent_destroyed(entt::registry &registry, entt::entity entity) {
+    // 子节点被销毁或脱离父节点：从父节点的子节点列表中移除，自身变为根节点
+    unlink(registry, registry.get<ParentComponent>(entity).Parent, entity);
+    on_parent_changed(registry, entity);
+  }
+
+  void TransformHierarchy::on_children_destroyed(entt::registry &registry, entt::entity entity) {
+    // 父节点被销毁：子节点变为根节点。移除 ParentComponent 会回调 on_parent_destroyed
+    // 修改这个列表，所以先复制
+    const std::vector<entt::entity> children = registry.get<ChildrenComponent>(entity).Children;
+    for (entt::entity child : children) {
+      const auto *link = registry.valid(child) ? registry.try_get<ParentComponent>(child) : nullptr;
+      if (link && link->Parent == entity) registry.remove<ParentComponent>(child);
+    }
+  }
+
+  void TransformHierarchy::on_global_changed(entt::registry &, entt::entity) {
+    order_dirty_ = true;
+  }
+
+  void TransformHierarchy::sort_by_depth(entt::registry &registry) {
+    auto &globals = registry.storage<GlobalTransformComponent>();
+    auto &parents = registry.storage<ParentComponent>();
+    auto &children = registry.storage<ChildrenComponent>();
+
+    // 没有父节点（或父节点没有世界变换）的实体是根节点
+    queue_.clear();
+    for (auto [entity, global] : globals.each()) {
+      const bool has_parent =
+          parents.contains(entity) && globals.contains(parents.get(entity).Parent);
+      if (!has_parent) {
+        global.Depth = 0;
+        queue_.push_back(entity);
+      }
+    }
+
+    // 广度优先逐层赋予深度
+    for (size_t i = 0; i < queue_.size(); ++i) {
+      const entt::entity entity = queue_[i];
+      if (!children.contains(entity)) continue;
+      const uint32_t depth = globals.get(entity).Depth + 1;
+      for (entt::entity child : children.get(entity).Children) {
+        if (!globals.contains(child) || !parents.contains(child)) continue;
+        if (parents.get(child).Parent != entity) continue;
+        globals.get(child).Depth = depth;
+        queue_.push_back(child);
+      }
+    }
+
+    registry.sort<GlobalTransformComponent>(
+        [](const GlobalTransformComponent &lhs, const GlobalTransformComponent &rhs) {
+          return lhs.Depth < rhs.Depth;
+        });
+    order_dirty_ = false;
+  }
+
+  void TransformHierarchy::propagate(entt::registry &registry) {
+    // 新实体：先收集再插入，不在遍历视图时修改存储
+    auto missing = registry.view<TransformComponent>(entt::exclude<GlobalTransformComponent>);
+    queue_.assign(missing.begin(), missing.end());
+    if (!queue_.empty()) registry.insert<GlobalTransformComponent>(queue_.begin(), queue_.end());
+
+    if (order_dirty_) sort_by_depth(registry);
+
+    auto &globals = registry.storage<GlobalTransformComponent>();
+    auto &transforms = registry.storage<TransformComponent>();
+    auto &parents = registry.storage<ParentComponent>();
+
+    // 存储按深度排序，父节点的 Updated 总是先于子节点得出
+    static const TransformComponent identity{};
+    pending_.clear();
+    locals_.clear();
+    for (auto [entity, global] : globals.each()) {
+      const TransformComponent *local =
+          transforms.contains(entity) ? &transforms.get(entity) : nullptr;
+      const GlobalTransformComponent *parent = nullptr;
+      if (parents.contains(entity)) {
+        const entt::entity parent_entity = parents.get(entity).Parent;
+        if (globals.contains(parent_entity)) parent = &globals.get(parent_entity);
+      }
+
+      global.Updated = global.Dirty || (parent && parent->Updated)
+                       || (local && !same_local(*local, global.Local));
+      if (!global.Updated) continue;
+
+      pending_.push_back(Pending{&global, parent, local});
+      locals_.push_back(local ? local : &identity);
+    }
+
+    // 局部矩阵一次批量算完，再按同样的顺序乘上父节点本帧的世界矩阵
+    matrices_.resize(pending_.size());
+    Render::compute_model_matrices(locals_.data(), matrices_.data(), locals_.size());
+    for (size_t i = 0; i < pending_.size(); ++i) {
+      const Pending &item = pending_[i];
+      item.global->Matrix = item.parent ? item.parent->Matrix * matrices_[i] : matrices_[i];
+      if (item.local) item.global->Local = *item.local;
+      item.global->Dirty = false;
+    }
+    updated_ = pending_.size();
+  }
+
+  void transform_propagate_system(Resources &res, entt::registry &registry) {
+    if (auto *hierarchy = res.get<TransformHierarchy>()) hierarchy->propagate(registry);
+  }
+
+}  // namespace VIVID::Scene
@@ -0,0 +1,85 @@
+#include "vivid/scene/world_clone.h"
+
+#include "vivid/input/camera_controller.h"
+#include "vivid/log/log.h"
+#include "vivid/rendering/render_component.h"
+
+namespace VIVID::Scene {
+
+  WorldClone WorldClone::scene() {
+    WorldClone clone;
+    clone.component<TransformComponent>()
+        .component<TagComponent>()
+        .component<MeshComponent>()
+        .component<MeshHandle>()
+        .component<MaterialComponent>()
+        .component<LightComponent>()
+        .component<CameraComponent>()
+        .component<ViewportComponent>()
+        .component<CameraControllerComponent>()
+        .component<ParentComponent>()
+        .component<ChildrenComponent>()
+        .component<GlobalTransformComponent>()
+        .shared<GpuMeshComponent>()
+        .shared<GpuMaterialComponent>();
+    return clone;
+  }
+
+  WorldClone &WorldClone::add_copier(Copier copier) {
+    for (auto &existing : copiers_) {
+      if (existing.type_id == copier.type_id) {
+        existing = std::move(copier);
+        return *this;
+      }
+    }
+    copiers_.push_back(std::move(copier));
+    return *this;
+  }
+
+  const WorldClone::Copier *WorldClone::find_copier(entt::id_type type_id) const {
+    for (const auto &copier : copiers_) {
+      if (copier.type_id == type_id) return &copier;
+    }
+    return nullptr;
+  }
+
+  bool WorldClone::clone(entt::registry &from, entt::registry &to) const {
+    auto &target_entities = to.storage<entt::entity>();
+    if (target_entities.size() != 0) {
+      VividLogger::app_error("WorldClone: target registry is not empty");
+      return false;
+    }
+
+    // 实体存储按原顺序逐个以原标识（编号 + 版本）创建，再恢复空闲链表的位置，
+    // 已释放的实体在副本中同样是已释放的，之后 create() 复用的编号也与源世界一致
+    auto &source_entities = from.storage<entt::entity>();
+    const entt::entity *entities = source_entities.data();
+    target_entities.reserve(source_entities.size());
+    for (size_t i = 0; i < source_entities.size(); ++i) {
+      target_entities.emplace(entities[i]);
+    }
+    target_entities.free_list(source_entities.free_list());
+
+    const entt::id_type entity_type = entt::type_hash<entt::entity>::value();
+    for (auto [id, storage] : from.storage()) {
+      if (id == entity_type || storage.empty()) continue;
+      if (const Copier *copier = find_copier(id)) {
+        copier->copy(from, to);
+        continue;
+      }
+      const std::string name(storage.type().name());
+      if (std::find(warned_.begin(), warned_.end(), name) == warned_.end()) {
+        VividLogger::app_warn("WorldClone: skipping unregistered component %s", name.c_str());
+        warned_.push_back(name);
+      }
+    }
+    return true;
+  }
+
+  void WorldClone::restore(entt::registry &from, entt::registry &to) const {
+    to.clear();
+    to.storage<entt::entity>().clear();
+    clone(from, to);
+  }
+
+}  // namespace VIVID::Scene
@@ -0,0 +1,419 @@
+#include "vivid/scene/world_snapshot.h"
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <new>
+
+#include "vivid/input/camera_controller.h"
+#include "vivid/log/log.h"
+#include "vivid/rendering/render_component.h"
+
+#ifdef _WIN32
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace VIVID::Scene {
+
+  namespace {
+
+    constexpr char kSnapshotMagic[8] = {'V', 'I', 'V', 'I', 'D', 'W', 'S', '\0'};
+
+    struct SnapshotFileHeader {
+      char magic[8] = {};
+      uint32_t version = 0;
+      uint32_t chunk_count = 0;
+      uint64_t entity_count = 0;
+      uint64_t file_size = 0;
+      uint8_t reserved[32] = {};
+    };
+    static_assert(sizeof(SnapshotFileHeader) == kSnapshotAlignment);
+
+    constexpr uint64_t align_up(uint64_t value) {
+      return (value + kSnapshotAlignment - 1) & ~uint64_t(kSnapshotAlignment - 1);
+    }
+
+    // 只读映射整个文件；映射起始地址按页对齐，块内数据因此满足组件的对齐要求
+    class MappedFile {
+    private:
+      const std::byte *data_ = nullptr;
+      size_t size_ = 0;
+#ifdef _WIN32
+      HANDLE file_ = INVALID_HANDLE_VALUE;
+      HANDLE mapping_ = nullptr;
+#endif
+
+    public:
+      explicit MappedFile(const std::string &path) {
+#ifdef _WIN32
+        file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) return;
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file_, &size) || size.QuadPart == 0) return;
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping_) return;
+        data_ = static_cast<const std::byte *>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+        if (data_) size_ = static_cast<size_t>(size.QuadPart);
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat info;
+        if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+          void *mapped = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE,
+                                fd, 0);
+          if (mapped != MAP_FAILED) {
+            data_ = static_cast<const std::byte *>(mapped);
+            size_ = static_cast<size_t>(info.st_size);
+          }
+        }
+        ::close(fd);  // 映射在关闭文件后仍然有效
+#endif
+      }
+
+      ~MappedFile() {
+#ifdef _WIN32
+        if (data_) UnmapViewOfFile(data_);
+        if (mapping_) CloseHandle(mapping_);
+        if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+#else
+        if (data_) ::munmap(const_cast<std::byte *>(data_), size_);
+#endif
+      }
+
+      MappedFile(const MappedFile &) = delete;
+      MappedFile &operator=(const MappedFile &) = delete;
+
+      const std::byte *data() const { return data_; }
+      size_t size() const { return size_; }
+    };
+
+    struct AlignedFree {
+      void operator()(std::byte *data) const {
+        ::operator delete(data, std::align_val_t(kSnapshotAlignment));
+      }
+    };
+
+    // 场景组件的编解码
+    void encode_tag(BlobWriter &writer, const TagComponent &tag) { writer.write_string(tag.Tag); }
+    bool decode_tag(BlobReader &reader, TagComponent &tag) { return reader.read_string(tag.Tag); }
+
+    void encode_mesh(BlobWriter &writer, const MeshComponent &mesh) {
+      writer.write_array(mesh.m_Vertices);
+      writer.write_array(mesh.m_Indices);
+      writer.write<uint64_t>(mesh.m_IndexCount);
+    }
+    bool decode_mesh(BlobReader &reader, MeshComponent &mesh) {
+      uint64_t index_count = 0;
+      if (!reader.read_array(mesh.m_Vertices) || !reader.read_array(mesh.m_Indices)
+          || !reader.read(index_count)) {
+        return false;
+      }
+      mesh.m_IndexCount = static_cast<size_t>(index_count);
+      return true;
+    }
+
+    void encode_material(BlobWriter &writer, const MaterialComponent &material) {
+      writer.write_string(material.ShaderPath);
+      writer.write(material.ObjectColor);
+      writer.write(material.SpecularColor);
+      writer.write(material.Shininess);
+    }
+    bool decode_material(BlobReader &reader, MaterialComponent &material) {
+      return reader.read_string(material.ShaderPath) && reader.read(material.ObjectColor)
+             && reader.read(material.SpecularColor) && reader.read(material.Shininess);
+    }
+
+    // 父子关系：实体引用按文件中的实体序号保存，加载时映射到新建的实体
+    void encode_parent(BlobWriter &writer, const ParentComponent &parent) {
+      writer.write_entity(parent.Parent);
+    }
+    bool decode_parent(BlobReader &reader, ParentComponent &parent) {
+      return reader.read_entity(parent.Parent);
+    }
+
+    void encode_children(BlobWriter &writer, const ChildrenComponent &children) {
+      writer.write<uint64_t>(children.Children.size());
+      for (entt::entity child : children.Children) writer.write_entity(child);
+    }
+    bool decode_children(BlobReader &reader, ChildrenComponent &children) {
+      uint64_t count = 0;
+      if (!reader.read(count) || count > reader.remaining() / sizeof(uint32_t)) return false;
+      children.Children.reserve(static_cast<size_t>(count));
+      for (uint64_t i = 0; i < count; ++i) {
+        entt::entity child = entt::null;
+        if (!reader.read_entity(child)) return false;
+        if (child != entt::null) children.Children.push_back(child);  // 保存时已销毁的子节点
+      }
+      return true;
+    }
+
+    // 版本 1 的 TransformComponent：旋转是弧度欧拉角
+    struct TransformComponentV1 {
+      glm::vec3 Position{0.0f};
+      glm::vec3 Rotation{0.0f};
+      glm::vec3 Scale{1.0f};
+    };
+
+    // 与旧的 GetTransform 相同，按 R = Rx · Ry · Rz 组合
+    TransformComponent upgrade_transform_v1(const TransformComponentV1 &old) {
+      TransformComponent transform;
+      transform.Position = old.Position;
+      transform.Rotation = glm::angleAxis(old.Rotation.x, glm::vec3(1.0f, 0.0f, 0.0f))
+                           * glm::angleAxis(old.Rotation.y, glm::vec3(0.0f, 1.0f, 0.0f))
+                           * glm::angleAxis(old.Rotation.z, glm::vec3(0.0f, 0.0f, 1.0f));
+      transform.Scale = old.Scale;
+      return transform;
+    }
+
+  }  // namespace
+
+  WorldSnapshot WorldSnapshot::scene() {
+    WorldSnapshot snapshot;
+    // TransformComponent 版本 2：旋转由欧拉角改为四元数，版本 1 的块加载时转换
+    snapshot.component<TransformComponent>("TransformComponent", 2)
+        .upgrade<TransformComponent>("TransformComponent", 1, upgrade_transform_v1)
+        .component<TagComponent>("TagComponent", 1, encode_tag, decode_tag)
+        .component<MeshComponent>("MeshComponent", 1, encode_mesh, decode_mesh)
+        .component<MaterialComponent>("MaterialComponent", 1, encode_material, decode_material)
+        .component<LightComponent>("LightComponent")
+        .component<CameraComponent>("CameraComponent")
+        .component<ViewportComponent>("ViewportComponent")
+        .component<CameraControllerComponent>("CameraControllerComponent")
+        // GlobalTransformComponent 不保存，加载后由 transform_propagate 重新计算
+        .component<ParentComponent>("ParentComponent", 1, encode_parent, decode_parent)
+        .component<ChildrenComponent>("ChildrenComponent", 1, encode_children, decode_children);
+    return snapshot;
+  }
+
+  WorldSnapshot &WorldSnapshot::add_codec(Codec codec) {
+    auto it = std::find_if(codecs_.begin(), codecs_.end(),
+                           [&](const Codec &other) { return other.type_id == codec.type_id; });
+    if (it != codecs_.end()) {
+      *it = std::move(codec);
+    } else {
+      codecs_.push_back(std::move(codec));
+    }
+    return *this;
+  }
+
+  const WorldSnapshot::Codec *WorldSnapshot::find_codec(uint64_t type_id) const {
+    for (const auto &codec : codecs_) {
+      if (codec.type_id == type_id) return &codec;
+    }
+    return nullptr;
+  }
+
+  const WorldSnapshot::Upgrade *WorldSnapshot::find_upgrade(
+      const SnapshotChunkHeader &header) const {
+    if (header.kind != kSnapshotRaw) return nullptr;
+    for (const auto &entry : upgrades_) {
+      if (entry.type_id == header.type_id && entry.version == header.version
+          && entry.element_size == header.element_size) {
+        return &entry;
+      }
+    }
+    return nullptr;
+  }
+
+  std::vector<std::byte> WorldSnapshot::serialize(entt::registry &registry) const {
+    std::vector<std::byte> out(sizeof(SnapshotFileHeader));
+    EntityIndex index;
+    std::vector<uint32_t> indices;
+    std::vector<std::byte> data;
+    uint32_t chunk_count = 0;
+
+    for (const auto &codec : codecs_) {
+      indices.clear();
+      data.clear();
+      const size_t count = codec.save(registry, index, indices, data);
+      if (count == 0) continue;
+
+      SnapshotChunkHeader header;
+      header.type_id = codec.type_id;
+      header.version = codec.version;
+      header.kind = codec.kind;
+      header.element_size = codec.element_size;
+      header.element_align = codec.element_align;
+      header.count = count;
+      header.index_offset = sizeof(SnapshotChunkHeader);
+      header.data_offset = align_up(header.index_offset + count * sizeof(uint32_t));
+      header.data_size = data.size();
+      header.chunk_size = align_up(header.data_offset + data.size());
+
+      // 块之间的填充字节为零
+      const size_t start = out.size();
+      out.resize(start + header.chunk_size);
+      std::memcpy(out.data() + start, &header, sizeof(header));
+      std::memcpy(out.data() + start + header.index_offset, indices.data(),
+                  count * sizeof(uint32_t));
+      if (!data.empty()) {
+        std::memcpy(out.data() + start + header.data_offset, data.data(), data.size());
+      }
+      ++chunk_count;
+    }
+
+    SnapshotFileHeader file;
+    std::memcpy(file.magic, kSnapshotMagic, sizeof(kSnapshotMagic));
+    file.version = kFormatVersion;
+    file.chunk_count = chunk_count;
+    file.entity_count = index.count;
+    file.file_size = out.size();
+    std::memcpy(out.data(), &file, sizeof(file));
+    return out;
+  }
+
+  bool WorldSnapshot::save(entt::registry &registry, const std::string &path) const {
+    const auto bytes = serialize(registry);
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      VividLogger::app_error("WorldSnapshot: cannot open %s for writing", path.c_str());
+      return false;
+    }
+    out.write(reinterpret_cast<const char *>(bytes.data()),
+              static_cast<std::streamsize>(bytes.size()));
+    if (!out) {
+      VividLogger::app_error("WorldSnapshot: failed writing %s", path.c_str());
+      return false;
+    }
+    return true;
+  }
+
+  bool WorldSnapshot::deserialize(entt::registry &registry, const std::byte *data,
+                                  size_t size) const {
+    if (reinterpret_cast<uintptr_t>(data) % kSnapshotAlignment != 0) {
+      // 调用方的缓冲区未对齐：复制一份对齐的再读
+      std::unique_ptr<std::byte, AlignedFree> aligned(
+          static_cast<std::byte *>(::operator new(size, std::align_val_t(kSnapshotAlignment))));
+      if (size > 0) std::memcpy(aligned.get(), data, size);
+      return deserialize(registry, aligned.get(), size);
+    }
+
+    SnapshotFileHeader file;
+    if (size < sizeof(file)) {
+      VividLogger::app_error("WorldSnapshot: data too small (%zu bytes)", size);
+      return false;
+    }
+    std::memcpy(&file, data, sizeof(file));
+    if (std::memcmp(file.magic, kSnapshotMagic, sizeof(kSnapshotMagic)) != 0) {
+      VividLogger::app_error("WorldSnapshot: not a world snapshot");
+      return false;
+    }
+    if (file.version != kFormatVersion) {
+      VividLogger::app_error("WorldSnapshot: unsupported format version %u (expected %u)",
+                             file.version, kFormatVersion);
+      return false;
+    }
+    if (file.file_size > size) {
+      VividLogger::app_error("WorldSnapshot: truncated (%zu of %llu bytes)", size,
+                             static_cast<unsigned long long>(file.file_size));
+      return false;
+    }
+
+    // 先校验所有块的边界，再创建实体，损坏的文件不会留下一半的世界
+    std::vector<SnapshotChunkView> chunks;
+    chunks.reserve(file.chunk_count);
+    uint64_t offset = sizeof(SnapshotFileHeader);
+    uint64_t total_count = 0;
+    for (uint32_t i = 0; i < file.chunk_count; ++i) {
+      if (offset + sizeof(SnapshotChunkHeader) > file.file_size) {
+        VividLogger::app_error("WorldSnapshot: chunk %u out of bounds", i);
+        return false;
+      }
+      const auto *header = reinterpret_cast<const SnapshotChunkHeader *>(data + offset);
+      const bool valid
+          = header->chunk_size % kSnapshotAlignment == 0
+            && header->chunk_size <= file.file_size - offset
+            && header->index_offset >= sizeof(SnapshotChunkHeader)
+            && header->count <= (header->chunk_size - header->index_offset) / sizeof(uint32_t)
+            && header->data_offset % kSnapshotAlignment == 0
+            && header->data_offset >= header->index_offset + header->count * sizeof(uint32_t)
+            && header->data_offset <= header->chunk_size
+            && header->data_size <= header->chunk_size - header->data_offset
+            && (header->kind != kSnapshotRaw
+                || header->data_size == header->count * header->element_size);
+      if (!valid) {
+        VividLogger::app_error("WorldSnapshot: chunk %u is corrupt", i);
+        return false;
+      }
+
+      SnapshotChunkView chunk;
+      chunk.header = header;
+      chunk.indices = reinterpret_cast<const uint32_t *>(data + offset + header->index_offset);
+      chunk.data = data + offset + header->data_offset;
+      chunks.push_back(chunk);
+      total_count += header->count;
+      offset += header->chunk_size;
+    }
+    if (file.entity_count > total_count) {
+      VividLogger::app_error("WorldSnapshot: entity count %llu exceeds component count",
+                             static_cast<unsigned long long>(file.entity_count));
+      return false;
+    }
+
+    std::vector<entt::entity> entities(static_cast<size_t>(file.entity_count));
+    registry.create(entities.begin(), entities.end());
+
+    std::vector<entt::entity> targets;
+    std::vector<uint32_t> last_chunk(entities.size(), UINT32_MAX);  // 检查同一块中重复的实体
+    for (uint32_t i = 0; i < chunks.size(); ++i) {
+      const auto &chunk = chunks[i];
+      const auto &header = *chunk.header;
+      const Codec *codec = find_codec(header.type_id);
+      if (!codec) {
+        VividLogger::app_warn("WorldSnapshot: skipping unregistered component chunk %016llx",
+                              static_cast<unsigned long long>(header.type_id));
+        continue;
+      }
+      const Upgrade *legacy = nullptr;
+      if (header.version != codec->version || header.kind != codec->kind
+          || header.element_size != codec->element_size) {
+        legacy = find_upgrade(header);
+        if (!legacy) {
+          VividLogger::app_warn("WorldSnapshot: skipping %s (version %u, expected %u)",
+                                codec->name.c_str(), header.version, codec->version);
+          continue;
+        }
+      }
+
+      targets.resize(static_cast<size_t>(header.count));
+      for (size_t j = 0; j < targets.size(); ++j) {
+        const uint32_t index = chunk.indices[j];
+        if (index >= entities.size() || last_chunk[index] == i) {
+          VividLogger::app_error("WorldSnapshot: bad entity index in %s", codec->name.c_str());
+          return false;
+        }
+        last_chunk[index] = i;
+        targets[j] = entities[index];
+      }
+      const bool loaded = legacy ? legacy->load(registry, chunk, targets, entities)
+                                 : codec->load(registry, chunk, targets, entities);
+      if (!loaded) {
+        VividLogger::app_error("WorldSnapshot: failed to decode %s", codec->name.c_str());
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool WorldSnapshot::load(entt::registry &registry, const std::string &path) const {
+    MappedFile file(path);
+    if (!file.data()) {
+      VividLogger::app_error("WorldSnapshot: cannot map %s", path.c_str());
+      return false;
+    }
+    return deserialize(registry, file.data(), file.size());
+  }
+
+}  // namespace VIVID::Scene
@@ -128,13 +128,8 @@ namespace VIVID::UI {
 
   // 如何在SDL3窗口中显示imgui: 3.处理事件
 
-  void ProcessImGuiEvent(Resources& res, entt::registry& world) {
-    auto eventQueues = res.get<EventQueues>();
-
-    if (eventQueues) {
-      ImGui_ImplSDL3_ProcessEvent(&eventQueues->raw_sdl_events.front());
-      eventQueues->raw_sdl_events.pop();
-    }
+  void ProcessImGuiEvent(EventReader<SDL_Event> events, MainThread) {
+    events.each([](const SDL_Event& event) { ImGui_ImplSDL3_ProcessEvent(&event); });
   }
 
 // 如何在SDL3窗口中显示imgui: 4.显示imgui Demo
@@ -148,7 +143,7 @@ namespace VIVID::UI {
 //   while (!canCloseWindow)
 #endif
   void ShowImGuiDemo(Resources& res, entt::registry& world) {
-    // Build ImGui frame only; actual rendering happens in Render::Draw
+    // Build ImGui frame only; actual rendering happens in Render::ExtractRender
     ImGui_ImplWGPU_NewFrame();
     ImGui_ImplSDL3_NewFrame();
     ImGui::NewFrame();
@@ -201,7 +196,7 @@ namespace VIVID::UI {
       ImGui::End();
     }
 
-    // Do not call ImGui::Render() here; it will be invoked in Render::Draw
+    // Do not call ImGui::Render() here; it will be invoked in Render::ExtractRender
   }
 #ifdef __EMSCRIPTEN__
   EMSCRIPTEN_MAINLOOP_END;
@@ -213,4 +208,82 @@ namespace VIVID::UI {
 
     ImGui::DestroyContext();
   }
+
+  void ShowMemoryPanel(Resources& res, entt::registry& world) {
+    auto* tracker = res.get<MemoryTracker>();
+    if (!tracker) return;
+
+    // 生成报告要遍历全部被统计的组件，每隔一段时间刷新一次
+    static MemoryReport report;
+    static int frames_until_refresh = 0;
+    static bool auto_refresh = true;
+
+    ImGui::Begin("Memory");
+    bool refresh = ImGui::Button("Refresh");
+    ImGui::SameLine();
+    ImGui::Checkbox("Auto (every 60 frames)", &auto_refresh);
+    if (auto_refresh && --frames_until_refresh <= 0) refresh = true;
+    if (refresh) {
+      report = tracker->build(res, world);
+      frames_until_refresh = 60;
+    }
+
+    ImGui::Text("Components %.1f KiB  Resources %.1f KiB  External %.1f KiB",
+                MemoryReport::kib(report.storage_bytes()),
+                MemoryReport::kib(report.resource_bytes()),
+                MemoryReport::kib(report.external_bytes()));
+
+    const ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg
+                                  | ImGuiTableFlags_Resizable | ImGuiTableFlags_SizingStretchProp;
+    if (ImGui::CollapsingHeader("Components", ImGuiTreeNodeFlags_DefaultOpen)
+        && ImGui::BeginTable("components", 5, flags)) {
+      ImGui::TableSetupColumn("Component");
+      ImGui::TableSetupColumn("Count");
+      ImGui::TableSetupColumn("Dense KiB");
+      ImGui::TableSetupColumn("Sparse KiB");
+      ImGui::TableSetupColumn("Heap KiB");
+      ImGui::TableHeadersRow();
+      for (const auto& entry : report.storages) {
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(MemoryReport::short_name(entry.name).c_str());
+        ImGui::TableNextColumn();
+        ImGui::Text("%zu", entry.count);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.1f", MemoryReport::kib(entry.dense_bytes));
+        ImGui::TableNextColumn();
+        ImGui::Text("%.1f", MemoryReport::kib(entry.sparse_bytes));
+        ImGui::TableNextColumn();
+        if (entry.tracked) {
+          ImGui::Text("%.1f", MemoryReport::kib(entry.heap_bytes));
+        } else {
+          ImGui::TextDisabled("-");
+        }
+      }
+      ImGui::EndTable();
+    }
+
+    if (ImGui::CollapsingHeader("Resources") && ImGui::BeginTable("resources", 3, flags)) {
+      ImGui::TableSetupColumn("Resource");
+      ImGui::TableSetupColumn("KiB");
+      ImGui::TableSetupColumn("Heap KiB");
+      ImGui::TableHeadersRow();
+      for (const auto& entry : report.resources) {
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(MemoryReport::short_name(entry.name).c_str());
+        ImGui::TableNextColumn();
+        ImGui::Text("%.1f", MemoryReport::kib(entry.bytes));
+        ImGui::TableNextColumn();
+        ImGui::Text("%.1f", MemoryReport::kib(entry.heap_bytes));
+      }
+      ImGui::EndTable();
+    }
+
+    for (const auto& entry : report.external) {
+      ImGui::Text("%s: %zu object(s), %.1f KiB", entry.name.c_str(), entry.count,
+                  MemoryReport::kib(entry.bytes));
+    }
+    ImGui::End();
+  }
 }  // namespace VIVID::UI
@@ -76,10 +76,11 @@ namespace VIVID::Window {
   }
 
   // Window event processing system for Update schedule
+  // WindowComponent is written through registry.patch so Changed<WindowComponent> sees it
   void window_event_processing_system(Resources& resources, entt::registry& registry) {
     auto view = registry.view<WindowComponent, WindowGpuComponent, WindowEventsComponent>();
 
-    view.each([&](auto entity, auto& window_comp, auto& gpu_comp, auto& events_comp) {
+    view.each([&](auto entity, auto&, auto& gpu_comp, auto& events_comp) {
       if (!gpu_comp.initialized || !gpu_comp.window_handle) {
         return;
       }
@@ -110,7 +111,8 @@ namespace VIVID::Window {
           case SDL_EVENT_WINDOW_CLOSE_REQUESTED:
             if (is_window_event) {
               events_comp.close_requested = true;
-              window_comp.should_close = true;
+              registry.patch<WindowComponent>(
+                  entity, [](WindowComponent& window) { window.should_close = true; });
               events_comp.events.push_back(event);
               SDL_Log("Window close requested");
             }
@@ -118,8 +120,10 @@ namespace VIVID::Window {
 
           case SDL_EVENT_WINDOW_RESIZED:
             if (is_window_event) {
-              window_comp.width = event.window.data1;
-              window_comp.height = event.window.data2;
+              registry.patch<WindowComponent>(entity, [&](WindowComponent& window) {
+                window.width = event.window.data1;
+                window.height = event.window.data2;
+              });
               // Update cache to match the new size
               gpu_comp.cached_width = event.window.data1;
               gpu_comp.cached_height = event.window.data2;
@@ -131,8 +135,10 @@ namespace VIVID::Window {
 
           case SDL_EVENT_WINDOW_MOVED:
             if (is_window_event) {
-              window_comp.x = event.window.data1;
-              window_comp.y = event.window.data2;
+              registry.patch<WindowComponent>(entity, [&](WindowComponent& window) {
+                window.x = event.window.data1;
+                window.y = event.window.data2;
+              });
               // Update cache to match the new position
               gpu_comp.cached_x = event.window.data1;
               gpu_comp.cached_y = event.window.data2;
@@ -152,10 +158,11 @@ namespace VIVID::Window {
   }
 
   // Window update system for Update schedule
-  void window_update_system(Resources& resources, entt::registry& registry) {
-    auto view = registry.view<WindowComponent, WindowGpuComponent>();
-
-    view.each([&](auto entity, auto& window_comp, auto& gpu_comp) {
+  // Only visits windows whose WindowComponent was added or patched since the last run
+  void window_update_system(
+      Query<const WindowComponent, WindowGpuComponent, Changed<WindowComponent>> windows,
+      MainThread) {
+    windows.each([&](auto entity, auto& window_comp, auto& gpu_comp) {
       if (!gpu_comp.initialized || !gpu_comp.window_handle) {
         return;
       }
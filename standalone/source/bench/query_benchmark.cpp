@@ -0,0 +1,98 @@
+#include "query_benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "vivid/app/App.h"
+#include "vivid/rendering/render_component.h"
+
+namespace {
+
+  constexpr int kIterations = 200;
+
+  // 与 Update_system 相同的组件组合，GPU 组件只填 ID，不调用 OpenGL。
+  // 一半实体只有 TransformComponent，各组件按不同的随机顺序添加，
+  // 模拟真实场景里各存储之间实体顺序不一致的情况
+  void populate(entt::registry &world, size_t renderables) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+
+    std::vector<entt::entity> entities(renderables * 2);
+    world.create(entities.begin(), entities.end());
+    for (auto entity : entities) {
+      auto &transform = world.emplace<TransformComponent>(entity);
+      transform.Position = {position(rng), position(rng), position(rng)};
+    }
+
+    std::shuffle(entities.begin(), entities.end(), rng);
+    entities.resize(renderables);
+    for (auto entity : entities) world.emplace<MaterialComponent>(entity);
+    std::shuffle(entities.begin(), entities.end(), rng);
+    for (auto entity : entities) {
+      world.emplace<GpuMeshComponent>(entity, GpuMeshComponent{1, 2, 3, 36});
+    }
+    std::shuffle(entities.begin(), entities.end(), rng);
+    for (auto entity : entities) {
+      world.emplace<GpuMaterialComponent>(entity, GpuMaterialComponent{4});
+    }
+  }
+
+  // 读取 Update_system 每个实体用到的字段
+  float visit(const TransformComponent &transform, const GpuMeshComponent &mesh,
+              const GpuMaterialComponent &material, const MaterialComponent &surface) {
+    return transform.Position.x + transform.Rotation.y + transform.Scale.z
+           + static_cast<float>(mesh.IndexCount + material.ShaderProgram_ID)
+           + surface.ObjectColor.r + surface.Shininess;
+  }
+
+  // 每次遍历的平均耗时（毫秒）
+  template <typename Fn> double measure(Fn &&iterate) {
+    volatile float sink = 0.0f;
+    sink = sink + iterate();  // 预热
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kIterations; ++i) sink = sink + iterate();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::milli>(elapsed).count() / kIterations;
+  }
+
+}  // namespace
+
+void RunQueryBenchmark() {
+  std::printf("Render query benchmark (%d iterations, mean ms per pass)\n", kIterations);
+  for (size_t renderables : {size_t(10000), size_t(100000)}) {
+    double view_ms = 0.0;
+    {
+      entt::registry world;
+      populate(world, renderables);
+      auto view = world.view<TransformComponent, GpuMeshComponent, GpuMaterialComponent,
+                             MaterialComponent>();
+      view_ms = measure([&] {
+        float sum = 0.0f;
+        view.each([&](const auto &transform, const auto &mesh, const auto &material,
+                      const auto &surface) { sum += visit(transform, mesh, material, surface); });
+        return sum;
+      });
+    }
+
+    double group_ms = 0.0;
+    {
+      entt::registry world;
+      Resources resources;
+      populate(world, renderables);
+      auto group = owning_group<TransformComponent, GpuMeshComponent, GpuMaterialComponent,
+                                MaterialComponent>(resources, world);
+      group_ms = measure([&] {
+        float sum = 0.0f;
+        group.each([&](const auto &transform, const auto &mesh, const auto &material,
+                       const auto &surface) { sum += visit(transform, mesh, material, surface); });
+        return sum;
+      });
+    }
+
+    std::printf("  %7zu renderables: view %8.3f ms  owning group %8.3f ms  (%.2fx)\n",
+                renderables, view_ms, group_ms, group_ms > 0.0 ? view_ms / group_ms : 0.0);
+  }
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+// 渲染查询基准：比较 Update_system 的四组件视图与拥有型分组的遍历耗时（10k / 100k 个可渲染实体）
+void RunQueryBenchmark();
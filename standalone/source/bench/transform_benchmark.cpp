@@ -0,0 +1,127 @@
+#include "transform_benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "vivid/render/transform_kernel.h"
+#include "vivid/rendering/render_component.h"
+
+namespace {
+
+  constexpr int kIterations = 200;
+
+  // 与 WebGPU 渲染的每实体 uniform 布局相同：法线矩阵隔着 view / projection 写入
+  struct Uniforms {
+    glm::mat4 model;
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::mat4 normalMatrix;
+    glm::vec4 extra[7];
+  };
+
+  std::vector<TransformComponent> make_transforms(size_t count) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> angle(-3.14159f, 3.14159f);
+    std::uniform_real_distribution<float> axis(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+
+    std::vector<TransformComponent> transforms(count);
+    for (auto &transform : transforms) {
+      transform.Position = {position(rng), position(rng), position(rng)};
+      const glm::vec3 direction(axis(rng), axis(rng), axis(rng) + 2.0f);  // 不为零向量
+      transform.Rotation = glm::angleAxis(angle(rng), glm::normalize(direction));
+      transform.Scale = {scale(rng), scale(rng), scale(rng)};
+    }
+    return transforms;
+  }
+
+  // 每次计算的平均耗时（毫秒）
+  template <typename Fn> double measure(Fn &&compute) {
+    compute();  // 预热
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kIterations; ++i) compute();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::milli>(elapsed).count() / kIterations;
+  }
+
+}  // namespace
+
+void RunTransformBenchmark() {
+  std::printf("Model/normal matrix benchmark (%d iterations, mean ms per pass, kernel: %s)\n",
+              kIterations, VIVID::Render::transform_kernel_isa());
+  for (size_t count : {size_t(10000), size_t(100000)}) {
+    const auto transforms = make_transforms(count);
+    std::vector<Uniforms> uniforms(count);
+
+    // 原来的逐个实体路径
+    const double entity_ms = measure([&] {
+      for (size_t i = 0; i < count; ++i) {
+        const glm::mat4 model = transforms[i].GetTransform();
+        uniforms[i].model = model;
+        uniforms[i].normalMatrix = glm::transpose(glm::inverse(model));
+      }
+    });
+    std::vector<glm::mat4> reference_models(count);
+    std::vector<glm::mat4> reference_normals(count);
+    for (size_t i = 0; i < count; ++i) {
+      reference_models[i] = uniforms[i].model;
+      reference_normals[i] = uniforms[i].normalMatrix;
+    }
+
+    // 整批在同一遍 SoA 中由位置、旋转、缩放得出模型矩阵和法线矩阵
+    std::vector<const TransformComponent *> pointers(count);
+    for (size_t i = 0; i < count; ++i) pointers[i] = &transforms[i];
+    const double batch_ms = measure([&] {
+      VIVID::Render::compute_model_normal_matrices(pointers.data(), &uniforms[0].model,
+                                                   &uniforms[0].normalMatrix, count,
+                                                   sizeof(Uniforms));
+    });
+
+    // 所有实体的模型矩阵、法线矩阵左上 3x3 与逐个实体路径的最大误差，确认两条路径结果一致
+    float model_error = 0.0f;
+    float normal_error = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+      for (int c = 0; c < 4; ++c) {
+        for (int r = 0; r < 4; ++r) {
+          model_error = std::max(model_error,
+                                 std::abs(uniforms[i].model[c][r] - reference_models[i][c][r]));
+          if (c == 3 || r == 3) continue;
+          normal_error = std::max(
+              normal_error, std::abs(uniforms[i].normalMatrix[c][r] - reference_normals[i][c][r]));
+        }
+      }
+    }
+
+    // 分别比较模型矩阵和法线矩阵部分
+    const double transform_ms = measure([&] {
+      for (size_t i = 0; i < count; ++i) uniforms[i].model = transforms[i].GetTransform();
+    });
+    const double model_kernel_ms = measure([&] {
+      VIVID::Render::compute_model_matrices(pointers.data(), &uniforms[0].model, count,
+                                            sizeof(Uniforms));
+    });
+    const double inverse_ms = measure([&] {
+      for (size_t i = 0; i < count; ++i) {
+        uniforms[i].normalMatrix = glm::transpose(glm::inverse(uniforms[i].model));
+      }
+    });
+    const double kernel_ms = measure([&] {
+      VIVID::Render::compute_normal_matrices(&uniforms[0].model, &uniforms[0].normalMatrix, count,
+                                             sizeof(Uniforms));
+    });
+
+    std::printf("  %7zu entities: per-entity %8.3f ms  batched %8.3f ms  (%.2fx)\n", count,
+                entity_ms, batch_ms, batch_ms > 0.0 ? entity_ms / batch_ms : 0.0);
+    std::printf("  %7zu models:   scalar     %8.3f ms  kernel  %8.3f ms  (%.2fx, max error %g)\n",
+                count, transform_ms, model_kernel_ms,
+                model_kernel_ms > 0.0 ? transform_ms / model_kernel_ms : 0.0, model_error);
+    std::printf("  %7zu normals:  inverse    %8.3f ms  kernel  %8.3f ms  (%.2fx, max error %g)\n",
+                count, inverse_ms, kernel_ms, kernel_ms > 0.0 ? inverse_ms / kernel_ms : 0.0,
+                normal_error);
+  }
+}
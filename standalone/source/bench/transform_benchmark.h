@@ -0,0 +1,4 @@
+#pragma once
+
+// 变换基准：比较逐个实体 transpose(inverse(model)) 与批量法线矩阵内核的耗时（10k / 100k 个实体）
+void RunTransformBenchmark();
@@ -1,6 +1,7 @@
 #include "InspectorPanel.h"
 #include <vivid/rendering/render_component.h>
 
+#include <cmath>
 #include <imgui.h>
 #include <imgui_internal.h>
 #include <iostream> // 引入头文件
@@ -102,6 +103,43 @@ namespace
         return modified;
     }
 
+    // 欧拉角（弧度）按 R = Rx · Ry · Rz 组合，与改用四元数之前的 TransformComponent 含义相同
+    glm::quat EulerToQuat(const glm::vec3 &euler)
+    {
+        return glm::angleAxis(euler.x, glm::vec3(1.0f, 0.0f, 0.0f))
+               * glm::angleAxis(euler.y, glm::vec3(0.0f, 1.0f, 0.0f))
+               * glm::angleAxis(euler.z, glm::vec3(0.0f, 0.0f, 1.0f));
+    }
+
+    glm::vec3 QuatToEuler(const glm::quat &rotation)
+    {
+        // m[列][行]；R = Rx · Ry · Rz 的第 0 行第 2 列为 sin(y)
+        const glm::mat3 m = glm::mat3_cast(rotation);
+        const float sy = glm::clamp(m[2][0], -1.0f, 1.0f);
+        const float y = std::asin(sy);
+        if (std::abs(sy) < 0.9999f)
+            return {std::atan2(-m[2][1], m[2][2]), y, std::atan2(-m[1][0], m[0][0])};
+        // 万向节锁：x 与 z 绕同一轴，全部记在 x 上
+        return {std::atan2(m[1][2], m[1][1]), y, 0.0f};
+    }
+
+    // 旋转控件：以欧拉角（度）编辑四元数。四元数与欧拉角只在这里互相转换
+    bool DrawVec3Control(const std::string &label, glm::quat &rotation)
+    {
+        // 拖动期间沿用上一次编辑得到的角度，不从四元数反算，避免在 ±90° 附近跳变
+        static glm::quat s_LastRotation{1.0f, 0.0f, 0.0f, 0.0f};
+        static glm::vec3 s_LastDegrees{0.0f};
+
+        glm::vec3 degrees = (rotation == s_LastRotation) ? s_LastDegrees : glm::degrees(QuatToEuler(rotation));
+        if (!DrawVec3Control(label, degrees, 0.0f))
+            return false;
+
+        rotation = EulerToQuat(glm::radians(degrees));
+        s_LastRotation = rotation;
+        s_LastDegrees = degrees;
+        return true;
+    }
+
     // Core function: dynamically render data members with error handling
     bool DrawDataMember(const entt::meta_data &metaData, entt::meta_any &componentInstance)
     {
@@ -173,6 +211,17 @@ namespace
                 }
             }
         }
+        else if (memberType == entt::resolve<glm::quat>())
+        {
+            auto rotation = getter.cast<glm::quat>();
+            if (DrawVec3Control(memberName, rotation))
+            {
+                if (metaData.set(componentInstance, rotation))
+                {
+                    modified = true;
+                }
+            }
+        }
         else if (memberType == entt::resolve<bool>())
         {
             auto value = getter.cast<bool>();
@@ -22,8 +22,16 @@ void SceneHierarchyPanel::OnImGuiRender()
 
     if (m_Context)
     {
+        // 顶层只画根节点，子节点在父节点展开时画出
         for (auto entityID : m_Context->view<TagComponent>())
+        {
+            auto *parent = m_Context->try_get<ParentComponent>(entityID);
+            bool drawnByParent = parent && m_Context->valid(parent->Parent)
+                                 && m_Context->all_of<TagComponent>(parent->Parent);
+            if (drawnByParent)
+                continue;
             DrawEntityNode(entityID, m_Context, m_SelectionContext);
+        }
 
         if (ImGui::BeginPopupContextWindow())
         {
@@ -50,8 +58,13 @@ static void DrawEntityNode(entt::entity entity, entt::registry *registry, entt::
 {
     auto &tag = registry->get<TagComponent>(entity).Tag;
 
+    auto *children = registry->try_get<ChildrenComponent>(entity);
+    const bool hasChildren = children && !children->Children.empty();
+
     ImGuiTreeNodeFlags flags = ((selectionContext == entity) ? ImGuiTreeNodeFlags_Selected : 0) | ImGuiTreeNodeFlags_OpenOnArrow;
     flags |= ImGuiTreeNodeFlags_SpanAvailWidth;
+    if (!hasChildren)
+        flags |= ImGuiTreeNodeFlags_Leaf;
     bool opened = ImGui::TreeNodeEx((void *)(uint64_t)(uint32_t)entity, flags, tag.c_str());
 
     if (ImGui::IsItemClicked())
@@ -61,7 +74,14 @@ static void DrawEntityNode(entt::entity entity, entt::registry *registry, entt::
 
     if (opened)
     {
-        // TODO: draw children
+        if (hasChildren)
+        {
+            for (auto child : children->Children)
+            {
+                if (registry->valid(child) && registry->all_of<TagComponent>(child))
+                    DrawEntityNode(child, registry, selectionContext);
+            }
+        }
         ImGui::TreePop();
     }
 }
\ No newline at end of file
@@ -1,12 +1,24 @@
 #include "editor_plugin.h"
 
 #include <vivid/app/App.h>
+#include <vivid/log/log.h>
+#include <vivid/scene/world_clone.h>
+
+#include <chrono>
 
 #include "ComponentRegistry.h"
 
 // System implementations for UI
 namespace {
 
+  // 运行模式：Play 时克隆当前世界，Stop 时还原到 Play 之前的状态（实体编号不变，选中项仍有效）
+  struct EditorPlayState {
+    VIVID::Scene::WorldClone cloner = VIVID::Scene::WorldClone::scene();
+    entt::registry saved;
+    bool playing = false;
+    bool toggle_requested = false;
+  };
+
   void ui_startup_system(Resources &res, entt::registry &world) {
     VIVID::ComponentRegistry::RegisterAllComponents();
     // --- ImGui Setup ---
@@ -34,6 +46,7 @@ namespace {
     // --- Create & Register UI Panels as Resources ---
     res.insert<SceneHierarchyPanel>().SetContext(&world);
     res.insert<InspectorPanel>().SetContext(&world);
+    res.insert<EditorPlayState>();
   }
 
   void ui_update_system(Resources &res, entt::registry &world) {
@@ -53,6 +66,12 @@ namespace {
       }
     }
 
+    if (auto *play = res.get<EditorPlayState>()) {
+      ImGui::Begin("Toolbar");
+      if (ImGui::Button(play->playing ? "Stop" : "Play")) play->toggle_requested = true;
+      ImGui::End();
+    }
+
     ImGui::Begin("Viewport");
     world.view<ViewportComponent, CameraComponent>().each(
         [](auto entity, ViewportComponent &viewport, CameraComponent & /* camera */) {
@@ -70,6 +89,25 @@ namespace {
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
   }
 
+  // 在 Cleanup 阶段切换运行模式，此时没有系统在访问世界
+  void play_mode_system(Resources &res, entt::registry &world) {
+    auto *play = res.get<EditorPlayState>();
+    if (!play || !play->toggle_requested) return;
+    play->toggle_requested = false;
+
+    const auto start = std::chrono::steady_clock::now();
+    if (play->playing) {
+      play->cloner.restore(play->saved, world);
+    } else {
+      play->cloner.restore(world, play->saved);
+    }
+    play->playing = !play->playing;
+    const std::chrono::duration<double, std::milli> elapsed
+        = std::chrono::steady_clock::now() - start;
+    VividLogger::app_info("Play mode: world %s in %.2f ms", play->playing ? "saved" : "restored",
+                          elapsed.count());
+  }
+
   void ui_shutdown_system(Resources &, entt::registry &) {
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
@@ -81,6 +119,7 @@ namespace {
 void EditorPlugin::build(App &app) {
   app.add_system(ScheduleLabel::Startup, ui_startup_system);
   app.add_system(ScheduleLabel::Update, ui_update_system);
+  app.add_system(ScheduleLabel::Cleanup, play_mode_system);
   app.add_system(ScheduleLabel::Shutdown, ui_shutdown_system);
 }
 
@@ -1,8 +1,23 @@
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bench/query_benchmark.h"
+#include "bench/transform_benchmark.h"
 #include "editor/editor_plugin.h"
 #include "vivid/app/App.h"
+#include "vivid/app/BatchRunner.h"
+#include "vivid/input/camera_control_system.h"
 #include "vivid/input/camera_controller.h"
 #include "vivid/plugins/DefaultPlugin.h"
+#include "vivid/plugins/InputRecordingPlugin.h"
+#include "vivid/plugins/MemoryReportPlugin.h"
+#include "vivid/plugins/TransformPlugin.h"
 #include "vivid/rendering/render_plugin.h"
+#include "vivid/scene/mesh_assets.h"
+#include "vivid/scene/world_snapshot.h"
 
 // Helper function to create a cube mesh component
 MeshComponent CreateCubeMesh() {
@@ -58,13 +73,125 @@ void app_startup_system(Resources &, entt::registry &world) {
   world.emplace<CameraControllerComponent>(cameraEntity);
 }
 
-int main() {
-  auto &app = App::new_app()
-                  .add_plugin<DefaultPlugin>()
-                  .add_plugin<RenderPlugin>()
-                  .add_plugin<EditorPlugin>()
-                  .add_system(ScheduleLabel::Startup, app_startup_system);
-  app.run();
+// Lays out count cubes on a square grid in one spawn_batch call; the cubes reference one shared
+// mesh asset (one CPU copy, one set of GPU buffers) and share the material value
+void spawn_cube_grid(Resources &res, entt::registry &world, size_t count) {
+  const MeshHandle cube = VIVID::Scene::mesh_assets(res).add(CreateCubeMesh());
+  const auto side = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(count))));
+  std::vector<TransformComponent> transforms(count);
+  for (size_t i = 0; i < count; ++i) {
+    transforms[i].Position = {2.0f * static_cast<float>(i % side), 0.0f,
+                              -2.0f * static_cast<float>(i / side)};
+  }
+  spawn_batch(res, world, count, per_entity(std::move(transforms)), TagComponent{"Cube"}, cube,
+              MaterialComponent{"D:/ClineWorkSpace/VIVID/build/release/standalone/Release/"
+                                "res/shaders/BlinnPhong.shader",
+                                {1.0f, 0.5f, 0.2f}});
+}
+
+int main(int argc, char **argv) {
+  // --headless [frames]: run without window/render plugins and print frame statistics
+  // --trace <file>: profile systems and write the last frames as Chrome trace JSON on exit
+  // --scene <file>: load the scene from a world snapshot instead of building it in code
+  // --save-scene <file>: write the scene built at startup as a world snapshot
+  // --bench-queries: compare render query iteration (view vs owning group) and exit
+  // --bench-transforms: compare per-entity normal matrices with the batched kernel and exit
+  // --memory-report <frames>: print component/resource memory usage every N frames
+  // --replay <file>: drive the camera from an input recording (VIVID_RECORD_INPUT in hello_sdl3)
+  //                  and exit when it ends; combine with --headless for repeatable benchmarks
+  // --replay-delta <seconds>: advance every replayed frame by a fixed step
+  // --spawn-cubes <count>: add a grid of cubes to the scene with one bulk spawn
+  // --batch <worlds>: run that many independent headless worlds of the same scene in parallel
+  //                   for the --headless frame count (default 1000)
+  uint64_t headless_frames = 0;
+  uint64_t memory_report_frames = 0;
+  double replay_delta = 0.0;
+  size_t spawn_cubes = 0;
+  size_t batch_worlds = 0;
+  std::string trace_path;
+  std::string scene_path;
+  std::string save_scene_path;
+  std::string replay_path;
+  for (int i = 1; i < argc; ++i) {
+    if (std::string(argv[i]) == "--headless") {
+      headless_frames = (i + 1 < argc) ? std::strtoull(argv[i + 1], nullptr, 10) : 0;
+      if (headless_frames == 0) headless_frames = 1000;
+    } else if (std::string(argv[i]) == "--trace" && i + 1 < argc) {
+      trace_path = argv[++i];
+    } else if (std::string(argv[i]) == "--scene" && i + 1 < argc) {
+      scene_path = argv[++i];
+    } else if (std::string(argv[i]) == "--save-scene" && i + 1 < argc) {
+      save_scene_path = argv[++i];
+    } else if (std::string(argv[i]) == "--memory-report" && i + 1 < argc) {
+      memory_report_frames = std::strtoull(argv[++i], nullptr, 10);
+    } else if (std::string(argv[i]) == "--replay" && i + 1 < argc) {
+      replay_path = argv[++i];
+    } else if (std::string(argv[i]) == "--replay-delta" && i + 1 < argc) {
+      replay_delta = std::strtod(argv[++i], nullptr);
+    } else if (std::string(argv[i]) == "--spawn-cubes" && i + 1 < argc) {
+      spawn_cubes = std::strtoull(argv[++i], nullptr, 10);
+    } else if (std::string(argv[i]) == "--batch" && i + 1 < argc) {
+      batch_worlds = std::strtoull(argv[++i], nullptr, 10);
+    } else if (std::string(argv[i]) == "--bench-queries") {
+      RunQueryBenchmark();
+      return 0;
+    } else if (std::string(argv[i]) == "--bench-transforms") {
+      RunTransformBenchmark();
+      return 0;
+    }
+  }
+  if (!trace_path.empty()) Profiler::instance().set_enabled(true);
+
+  auto build_app = [&](App &app, size_t world_index) {
+    // OpenGL 渲染在 Update 阶段绘制，世界矩阵的传播注册在它之前、同一阶段
+    app.add_plugin<DefaultPlugin>()
+        .add_plugin<TransformPlugin>(ScheduleLabel::Update)
+        .add_plugin<RenderPlugin>()
+        .add_plugin<EditorPlugin>();
+    if (memory_report_frames > 0) app.add_plugin<MemoryReportPlugin>(memory_report_frames);
+    if (!replay_path.empty()) {
+      app.add_plugin<InputRecordingPlugin>(InputRecordingConfig::replay(replay_path, replay_delta))
+          .add_system(ScheduleLabel::Update, VIVID_SYSTEM(VIVID::Input::camera_control_system));
+    }
+
+    if (scene_path.empty()) {
+      app.add_system(ScheduleLabel::Startup, app_startup_system);
+    } else {
+      app.add_system(ScheduleLabel::Startup, [scene_path](Resources &, entt::registry &world) {
+        VIVID::Scene::WorldSnapshot::scene().load(world, scene_path);
+      });
+    }
+    if (spawn_cubes > 0) {
+      app.add_system(ScheduleLabel::Startup, [spawn_cubes](Resources &res, entt::registry &world) {
+        spawn_cube_grid(res, world, spawn_cubes);
+      });
+    }
+    if (!save_scene_path.empty() && world_index == 0) {
+      app.add_system(ScheduleLabel::Startup,
+                     [save_scene_path](Resources &, entt::registry &world) {
+                       VIVID::Scene::WorldSnapshot::scene().save(world, save_scene_path);
+                     });
+    }
+  };
+
+  if (batch_worlds > 0) {
+    BatchRunner batch(BatchConfig{batch_worlds}, build_app);
+    batch.run(headless_frames > 0 ? headless_frames : 1000);
+    if (!trace_path.empty()) Profiler::instance().write_chrome_trace(trace_path, 120);
+    return 0;
+  }
+
+  auto &app = App::new_app().set_run_mode(headless_frames > 0 ? RunMode::Headless
+                                                               : RunMode::Windowed);
+  build_app(app, 0);
+
+  if (headless_frames > 0) {
+    app.run_frames(headless_frames);
+  } else {
+    app.run();
+  }
+
+  if (!trace_path.empty()) Profiler::instance().write_chrome_trace(trace_path, 120);
 
   return 0;
 }
@@ -0,0 +1,152 @@
+#include <doctest/doctest.h>
+#include <vivid/app/App.h>
+
+#include <vector>
+
+namespace {
+
+  struct Position {
+    float x = 0.0f;
+  };
+
+  // 每一帧系统看到的实体
+  struct Seen {
+    std::vector<entt::entity> added;
+    std::vector<entt::entity> changed;
+    std::vector<entt::entity> removed;
+
+    void clear() {
+      added.clear();
+      changed.clear();
+      removed.clear();
+    }
+  };
+
+  void track_position(App &app, Seen &seen) {
+    app.add_system(ScheduleLabel::Update, [&seen](Query<const Position, Added<Position>> added,
+                                                  Query<const Position, Changed<Position>> changed,
+                                                  Removed<Position> removed) {
+      added.each([&](entt::entity entity, const Position &) { seen.added.push_back(entity); });
+      changed.each([&](entt::entity entity, const Position &) { seen.changed.push_back(entity); });
+      removed.each([&](entt::entity entity) { seen.removed.push_back(entity); });
+    });
+  }
+
+}  // namespace
+
+TEST_CASE("Added reports components inserted since the system last ran") {
+  App app;
+  Seen seen;
+  track_position(app, seen);
+  app.initialize(0, nullptr);
+
+  auto first = app.world().create();
+  app.world().emplace<Position>(first);
+  app.iterate();
+  CHECK(seen.added == std::vector<entt::entity>{first});
+
+  // 已经看到过的插入不再报告
+  seen.clear();
+  app.iterate();
+  CHECK(seen.added.empty());
+
+  auto second = app.world().create();
+  app.world().emplace<Position>(second);
+  app.iterate();
+  CHECK(seen.added == std::vector<entt::entity>{second});
+}
+
+TEST_CASE("Changed reports patched components once per run") {
+  App app;
+  Seen seen;
+  track_position(app, seen);
+  app.initialize(0, nullptr);
+
+  auto entity = app.world().create();
+  app.world().emplace<Position>(entity);
+  app.iterate();
+
+  // 两次 patch 只报告一次
+  seen.clear();
+  app.world().patch<Position>(entity, [](Position &position) { position.x = 1.0f; });
+  app.world().patch<Position>(entity, [](Position &position) { position.x = 2.0f; });
+  app.iterate();
+  CHECK(seen.changed == std::vector<entt::entity>{entity});
+  CHECK(seen.added.empty());
+
+  seen.clear();
+  app.iterate();
+  CHECK(seen.changed.empty());
+}
+
+TEST_CASE("Removed reports components removed or destroyed since the system last ran") {
+  App app;
+  Seen seen;
+  track_position(app, seen);
+  app.initialize(0, nullptr);
+
+  auto removed = app.world().create();
+  auto destroyed = app.world().create();
+  app.world().emplace<Position>(removed);
+  app.world().emplace<Position>(destroyed);
+  app.iterate();
+
+  seen.clear();
+  app.world().remove<Position>(removed);
+  app.world().destroy(destroyed);
+  app.iterate();
+  REQUIRE(seen.removed.size() == 2);
+  CHECK(seen.removed[0] == removed);
+  CHECK(seen.removed[1] == destroyed);
+  CHECK(seen.changed.empty());
+
+  seen.clear();
+  app.iterate();
+  CHECK(seen.removed.empty());
+}
+
+TEST_CASE("run_if(any_added) runs a system only after an insertion") {
+  App app;
+  int runs = 0;
+
+  app.add_system(
+      ScheduleLabel::Update, [&](entt::registry &) { ++runs; },
+      SystemConfig("on_spawn").run_if(any_added<Position>()));
+
+  app.initialize(0, nullptr);
+  app.iterate();
+  CHECK(runs == 0);
+
+  auto entity = app.world().create();
+  app.world().emplace<Position>(entity);
+  app.iterate();
+  CHECK(runs == 1);
+
+  app.iterate();
+  CHECK(runs == 1);
+}
+
+TEST_CASE("Change history is bounded when a reader never runs") {
+  App app;
+  app.resources().get<ChangeDetection>()->set_max_change_age(8);
+  int runs = 0;
+
+  // 读取 Changed<Position>，但运行条件从不满足，last_run_tick 一直停在 0
+  app.add_system(
+      ScheduleLabel::Update,
+      [&](Query<const Position, Changed<Position>>) { ++runs; },
+      SystemConfig("never").run_if([](Resources &, entt::registry &) { return false; }));
+
+  app.initialize(0, nullptr);
+  auto entity = app.world().create();
+  app.world().emplace<Position>(entity);
+  for (int frame = 0; frame < 100; ++frame) {
+    app.world().patch<Position>(entity, [&](Position &position) { position.x = frame; });
+    app.iterate();
+  }
+
+  auto *tracker = app.resources().get<ComponentTracker<Position>>();
+  REQUIRE(tracker != nullptr);
+  CHECK(runs == 0);
+  CHECK(tracker->history_size() <= 10);
+}
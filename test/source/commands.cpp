@@ -0,0 +1,152 @@
+#include <doctest/doctest.h>
+#include <vivid/app/App.h>
+
+#include <vector>
+
+namespace {
+
+  struct Health {
+    int value = 0;
+  };
+
+  struct Armor {
+    int value = 0;
+  };
+
+  struct Position {
+    float x = 0.0f;
+  };
+
+  // 自定义命令执行时看到的世界状态
+  struct Observed {
+    bool ran = false;
+    bool inserted = false;
+    bool removed = false;
+    bool despawned_still_valid = false;
+    size_t spawned = 0;
+  };
+
+}  // namespace
+
+TEST_CASE("Commands apply in a fixed order at the end of the stage") {
+  App app;
+  Observed observed;
+  entt::entity target = entt::null;
+  entt::entity doomed = entt::null;
+  bool visible_during_stage = true;
+
+  // 记录顺序与应用顺序相反：销毁 → 自定义 → 移除 → 插入 → 创建
+  app.add_system(
+      ScheduleLabel::Update,
+      [&](Commands commands) {
+        commands.despawn(doomed);
+        commands.add([&](entt::registry &world) {
+          observed.ran = true;
+          observed.inserted = world.all_of<Armor>(target);
+          observed.removed = !world.all_of<Health>(target);
+          observed.despawned_still_valid = world.valid(doomed);
+          observed.spawned = world.storage<Health>().size();
+        });
+        commands.remove<Health>(target);
+        commands.insert<Armor>(target, 3);
+        commands.spawn().insert<Health>(7).insert<Armor>(1);
+      },
+      SystemConfig("record"));
+
+  // 同一阶段中后运行的系统看不到尚未应用的命令
+  app.add_system(
+      ScheduleLabel::Update,
+      [&](entt::registry &world) { visible_during_stage = world.all_of<Armor>(target); },
+      SystemConfig("check").after("record"));
+
+  app.initialize(0, nullptr);
+  target = app.world().create();
+  app.world().emplace<Health>(target, 10);
+  doomed = app.world().create();
+  app.iterate();
+
+  CHECK(observed.ran);
+  CHECK(observed.inserted);
+  CHECK(observed.removed);
+  CHECK(observed.despawned_still_valid);
+  CHECK(observed.spawned == 1);
+  CHECK_FALSE(app.world().valid(doomed));
+  CHECK(app.world().get<Armor>(target).value == 3);
+
+  std::vector<entt::entity> spawned;
+  app.world().view<Health, Armor>().each(
+      [&](entt::entity entity, Health &, Armor &) { spawned.push_back(entity); });
+  REQUIRE(spawned.size() == 1);
+  CHECK(app.world().get<Health>(spawned[0]).value == 7);
+  CHECK(app.world().get<Armor>(spawned[0]).value == 1);
+}
+
+TEST_CASE("Commands apply inserts and removes of one component in recording order") {
+  App app;
+  entt::entity reinserted = entt::null;
+  entt::entity removed = entt::null;
+  entt::entity replaced = entt::null;
+
+  app.add_system(ScheduleLabel::Update, [&](Commands commands) {
+    commands.remove<Health>(reinserted);
+    commands.insert<Health>(reinserted, 5);
+
+    commands.insert<Health>(removed, 5);
+    commands.remove<Health>(removed);
+
+    commands.insert<Health>(replaced, 1);
+    commands.remove<Health>(replaced);
+    commands.insert<Health>(replaced, 2);
+  });
+
+  app.initialize(0, nullptr);
+  reinserted = app.world().create();
+  app.world().emplace<Health>(reinserted, 10);
+  removed = app.world().create();
+  replaced = app.world().create();
+  app.iterate();
+
+  REQUIRE(app.world().all_of<Health>(reinserted));
+  CHECK(app.world().get<Health>(reinserted).value == 5);
+  CHECK_FALSE(app.world().all_of<Health>(removed));
+  REQUIRE(app.world().all_of<Health>(replaced));
+  CHECK(app.world().get<Health>(replaced).value == 2);
+}
+
+TEST_CASE("Commands recorded on worker threads are all applied") {
+  App app;
+  app.insert_resource<TaskPool>(2);
+  constexpr int kPerSystem = 100;
+
+  // 两个互不冲突的系统可以在不同线程上同时记录
+  app.add_system(ScheduleLabel::Update, [&](Commands commands, Query<const Armor>) {
+    for (int i = 0; i < kPerSystem; ++i) commands.spawn().insert<Health>(i);
+  });
+  app.add_system(ScheduleLabel::Update, [&](Commands commands, Query<const Health>) {
+    for (int i = 0; i < kPerSystem; ++i) commands.spawn().insert<Armor>(i);
+  });
+
+  app.initialize(0, nullptr);
+  app.iterate();
+
+  CHECK(app.world().storage<Health>().size() == kPerSystem);
+  CHECK(app.world().storage<Armor>().size() == kPerSystem);
+}
+
+TEST_CASE("Entities spawned by Commands are seen as added by later stages") {
+  App app;
+  size_t added = 0;
+  app.add_system(ScheduleLabel::PreUpdate, [](Commands commands, Local<int> frame) {
+    if ((*frame)++ == 0) commands.spawn().insert<Position>(1.0f);
+  });
+  app.add_system(ScheduleLabel::Update, [&](Query<const Position, Added<Position>> query) {
+    query.each([&](entt::entity, const Position &) { ++added; });
+  });
+  app.initialize(0, nullptr);
+
+  app.iterate();
+  CHECK(added == 1);
+
+  app.iterate();
+  CHECK(added == 1);
+}
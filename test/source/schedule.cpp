@@ -0,0 +1,119 @@
+#include <doctest/doctest.h>
+#include <vivid/app/App.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+  struct Position {
+    float x = 0.0f;
+  };
+
+  struct Velocity {
+    float v = 0.0f;
+  };
+
+  // 记录系统的运行顺序和同时运行的系统数
+  struct Trace {
+    std::mutex mutex;
+    std::string order;
+    std::atomic<int> running{0};
+    std::atomic<int> max_running{0};
+
+    void enter(char name) {
+      const int now = ++running;
+      int seen = max_running.load();
+      while (now > seen && !max_running.compare_exchange_weak(seen, now)) {
+      }
+      std::lock_guard<std::mutex> lock(mutex);
+      order += name;
+    }
+
+    void leave() { --running; }
+  };
+
+  // 等待另一个系统也进入，最多等待 timeout；返回是否等到
+  bool rendezvous(std::atomic<int> &arrived, std::chrono::milliseconds timeout) {
+    ++arrived;
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (arrived.load() < 2 && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::yield();
+    }
+    return arrived.load() >= 2;
+  }
+
+}  // namespace
+
+TEST_CASE("Schedule keeps registration order for conflicting systems") {
+  App app;
+  app.insert_resource<TaskPool>(2);
+  Trace trace;
+
+  // 三个系统都写 Position，互相冲突：即使有工作线程也必须按注册顺序串行
+  for (char name : std::string("abc")) {
+    app.add_system(ScheduleLabel::Update, [&trace, name](Query<Position> q) {
+      trace.enter(name);
+      q.each([](Position &position) { position.x += 1.0f; });
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      trace.leave();
+    });
+  }
+
+  app.initialize(0, nullptr);
+  auto entity = app.world().create();
+  app.world().emplace<Position>(entity);
+  app.iterate();
+  app.iterate();
+
+  CHECK(trace.order == "abcabc");
+  CHECK(trace.max_running.load() == 1);
+  CHECK(app.world().get<Position>(entity).x == doctest::Approx(6.0f));
+}
+
+TEST_CASE("Schedule runs non-conflicting systems in parallel") {
+  App app;
+  app.insert_resource<TaskPool>(2);
+  std::atomic<int> arrived{0};
+  std::atomic<int> met{0};
+
+  // 两个系统访问不同的组件：只有同时运行才能都等到对方
+  app.add_system(ScheduleLabel::Update, [&](Query<Position>) {
+    if (rendezvous(arrived, std::chrono::seconds(5))) ++met;
+  });
+  app.add_system(ScheduleLabel::Update, [&](Query<Velocity>) {
+    if (rendezvous(arrived, std::chrono::seconds(5))) ++met;
+  });
+
+  app.initialize(0, nullptr);
+  app.iterate();
+
+  CHECK(met.load() == 2);
+}
+
+TEST_CASE("Schedule orders systems by before/after constraints") {
+  App app;
+  std::string order;
+
+  app.add_system(
+      ScheduleLabel::Update, [&](entt::registry &) { order += 'c'; },
+      SystemConfig("c").after("b"));
+  app.add_system(
+      ScheduleLabel::Update, [&](entt::registry &) { order += 'b'; },
+      SystemConfig("b").after("a"));
+  app.add_system(
+      ScheduleLabel::Update, [&](entt::registry &) { order += 'a'; }, SystemConfig("a"));
+  app.add_system(
+      ScheduleLabel::Update, [&](entt::registry &) { order += 'x'; },
+      SystemConfig("x").before("a"));
+
+  app.initialize(0, nullptr);
+  app.iterate();
+
+  CHECK(order == "xabc");
+}
@@ -0,0 +1,99 @@
+#include <doctest/doctest.h>
+#include <vivid/rendering/render_component.h>
+#include <vivid/scene/world_clone.h>
+
+#include <string>
+#include <vector>
+
+using namespace VIVID::Scene;
+
+namespace {
+
+  // 一部分实体同时有 TransformComponent 和 MaterialComponent（属于分组），其余只有变换
+  std::vector<entt::entity> populate(entt::registry &world) {
+    std::vector<entt::entity> entities;
+    for (int i = 0; i < 16; ++i) {
+      auto entity = world.create();
+      auto &transform = world.emplace<TransformComponent>(entity);
+      transform.Position = glm::vec3(static_cast<float>(i), 0.0f, 0.0f);
+      world.emplace<TagComponent>(entity, TagComponent{"entity " + std::to_string(i)});
+      if (i % 3 != 0) {
+        auto &material = world.emplace<MaterialComponent>(entity);
+        material.Shininess = static_cast<float>(i);
+      }
+      entities.push_back(entity);
+    }
+    // 释放的实体在副本中同样是释放的
+    world.destroy(entities[5]);
+    world.destroy(entities[9]);
+    return entities;
+  }
+
+  // 每个实体的组件值与 expected 中同一实体的相同
+  void check_same_world(entt::registry &expected, entt::registry &actual,
+                        const std::vector<entt::entity> &entities) {
+    for (auto entity : entities) {
+      REQUIRE(actual.valid(entity) == expected.valid(entity));
+      if (!expected.valid(entity)) continue;
+
+      CHECK(actual.get<TransformComponent>(entity).Position
+            == expected.get<TransformComponent>(entity).Position);
+      CHECK(actual.get<TagComponent>(entity).Tag == expected.get<TagComponent>(entity).Tag);
+      REQUIRE(actual.all_of<MaterialComponent>(entity)
+              == expected.all_of<MaterialComponent>(entity));
+      if (expected.all_of<MaterialComponent>(entity)) {
+        CHECK(actual.get<MaterialComponent>(entity).Shininess
+              == expected.get<MaterialComponent>(entity).Shininess);
+      }
+    }
+  }
+
+}  // namespace
+
+TEST_CASE("WorldClone preserves entities and values with an owning group in the target") {
+  entt::registry source;
+  auto entities = populate(source);
+
+  // 目标在复制之前就有拥有型分组：插入时分组会交换实体在存储中的位置
+  entt::registry copy;
+  auto group = copy.group<TransformComponent, MaterialComponent>();
+
+  auto cloner = WorldClone::scene();
+  REQUIRE(cloner.clone(source, copy));
+  check_same_world(source, copy, entities);
+  CHECK(group.size() == copy.storage<MaterialComponent>().size());
+
+  // 已释放实体的编号按相同顺序复用
+  CHECK(copy.create() == source.create());
+
+  // 目标不为空时不复制
+  CHECK_FALSE(cloner.clone(source, copy));
+}
+
+TEST_CASE("WorldClone restores a world that owns a group") {
+  entt::registry world;
+  auto group = world.group<TransformComponent, MaterialComponent>();
+  auto entities = populate(world);
+
+  auto cloner = WorldClone::scene();
+  entt::registry saved;
+  REQUIRE(cloner.clone(world, saved));
+
+  // 运行模式中修改世界：移动、删除组件、销毁和新建实体
+  world.get<TransformComponent>(entities[1]).Position.y = 10.0f;
+  world.remove<MaterialComponent>(entities[2]);
+  world.destroy(entities[4]);
+  world.emplace<TransformComponent>(world.create());
+
+  cloner.restore(saved, world);
+  check_same_world(saved, world, entities);
+  CHECK(world.storage<TransformComponent>().size() == saved.storage<TransformComponent>().size());
+
+  size_t grouped = 0;
+  group.each([&](entt::entity entity, TransformComponent &transform, MaterialComponent &material) {
+    CHECK(transform.Position == saved.get<TransformComponent>(entity).Position);
+    CHECK(material.Shininess == saved.get<MaterialComponent>(entity).Shininess);
+    ++grouped;
+  });
+  CHECK(grouped == saved.storage<MaterialComponent>().size());
+}
@@ -0,0 +1,134 @@
+#include <doctest/doctest.h>
+#include <vivid/rendering/render_component.h>
+#include <vivid/scene/world_snapshot.h>
+
+#include <vector>
+
+using namespace VIVID::Scene;
+
+namespace {
+
+  // 版本 1 的 TransformComponent：旋转为欧拉角（弧度）
+  struct TransformV1 {
+    glm::vec3 Position{0.0f};
+    glm::vec3 Rotation{0.0f};
+    glm::vec3 Scale{1.0f};
+  };
+
+  // 按 tag 查找实体，没有时返回 entt::null
+  entt::entity find_tagged(entt::registry &world, const std::string &tag) {
+    for (auto [entity, component] : world.storage<TagComponent>().each()) {
+      if (component.Tag == tag) return entity;
+    }
+    return entt::null;
+  }
+
+}  // namespace
+
+TEST_CASE("WorldSnapshot round-trips scene components") {
+  entt::registry source;
+  auto cube = source.create();
+  source.emplace<TagComponent>(cube, TagComponent{"cube"});
+  auto &transform = source.emplace<TransformComponent>(cube);
+  transform.Position = glm::vec3(1.0f, 2.0f, 3.0f);
+  transform.Rotation = glm::angleAxis(0.5f, glm::vec3(0.0f, 1.0f, 0.0f));
+  transform.Scale = glm::vec3(2.0f);
+  source.emplace<MeshComponent>(
+      cube, MeshComponent{{0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f}, {0, 1, 2}, 3});
+  auto &material = source.emplace<MaterialComponent>(cube);
+  material.ShaderPath = "res/shaders/Unlit.shader";
+  material.Shininess = 8.0f;
+
+  auto light = source.create();
+  source.emplace<TagComponent>(light, TagComponent{"light"});
+  source.emplace<LightComponent>(light).Linear = 0.5f;
+
+  // 没有已注册组件的实体不保存
+  source.create();
+
+  auto snapshot = WorldSnapshot::scene();
+  auto bytes = snapshot.serialize(source);
+
+  entt::registry target;
+  target.create();  // 加载作为新实体追加，已有实体不受影响
+  REQUIRE(snapshot.deserialize(target, bytes.data(), bytes.size()));
+  CHECK(target.storage<TagComponent>().size() == 2);
+
+  auto loaded_cube = find_tagged(target, "cube");
+  REQUIRE(loaded_cube != entt::null);
+  const auto &loaded_transform = target.get<TransformComponent>(loaded_cube);
+  CHECK(loaded_transform.Position == transform.Position);
+  CHECK(loaded_transform.Rotation == transform.Rotation);
+  CHECK(loaded_transform.Scale == transform.Scale);
+  const auto &loaded_mesh = target.get<MeshComponent>(loaded_cube);
+  CHECK(loaded_mesh.m_Vertices == source.get<MeshComponent>(cube).m_Vertices);
+  CHECK(loaded_mesh.m_Indices == source.get<MeshComponent>(cube).m_Indices);
+  CHECK(loaded_mesh.m_IndexCount == 3);
+  CHECK(target.get<MaterialComponent>(loaded_cube).ShaderPath == material.ShaderPath);
+  CHECK(target.get<MaterialComponent>(loaded_cube).Shininess == material.Shininess);
+  CHECK_FALSE(target.all_of<LightComponent>(loaded_cube));
+
+  auto loaded_light = find_tagged(target, "light");
+  REQUIRE(loaded_light != entt::null);
+  CHECK(target.get<LightComponent>(loaded_light).Linear == 0.5f);
+}
+
+TEST_CASE("WorldSnapshot remaps parent and child references") {
+  entt::registry source;
+  // 先释放一个实体，让保存时的实体编号与加载后的不同
+  source.destroy(source.create());
+  auto car = source.create();
+  auto left = source.create();
+  auto right = source.create();
+  auto gone = source.create();
+  for (auto entity : {car, left, right, gone}) source.emplace<TransformComponent>(entity);
+  source.emplace<TagComponent>(car, TagComponent{"car"});
+  source.emplace<ParentComponent>(left, car);
+  source.emplace<ParentComponent>(right, car);
+  source.emplace<ChildrenComponent>(car, ChildrenComponent{{left, right, gone}});
+  source.destroy(gone);  // 悬空引用加载时丢弃
+
+  auto snapshot = WorldSnapshot::scene();
+  auto bytes = snapshot.serialize(source);
+
+  entt::registry target;
+  for (int i = 0; i < 5; ++i) target.create();
+  REQUIRE(snapshot.deserialize(target, bytes.data(), bytes.size()));
+
+  auto parent = find_tagged(target, "car");
+  REQUIRE(parent != entt::null);
+  const auto &children = target.get<ChildrenComponent>(parent).Children;
+  REQUIRE(children.size() == 2);
+  for (auto child : children) {
+    REQUIRE(target.valid(child));
+    CHECK(target.get<ParentComponent>(child).Parent == parent);
+  }
+  CHECK(target.storage<ParentComponent>().size() == 2);
+}
+
+TEST_CASE("WorldSnapshot upgrades version 1 transforms") {
+  entt::registry source;
+  auto entity = source.create();
+  auto &old = source.emplace<TransformV1>(entity);
+  old.Position = glm::vec3(4.0f, 5.0f, 6.0f);
+  old.Rotation = glm::vec3(0.25f, 0.0f, 0.0f);
+  old.Scale = glm::vec3(3.0f);
+
+  // 用旧的注册方式写出版本 1 的块
+  WorldSnapshot legacy;
+  legacy.component<TransformV1>("TransformComponent", 1);
+  auto bytes = legacy.serialize(source);
+
+  entt::registry target;
+  REQUIRE(WorldSnapshot::scene().deserialize(target, bytes.data(), bytes.size()));
+  REQUIRE(target.storage<TransformComponent>().size() == 1);
+
+  const auto &transform = target.get<TransformComponent>(target.view<TransformComponent>().front());
+  CHECK(transform.Position == old.Position);
+  CHECK(transform.Scale == old.Scale);
+  const glm::quat expected = glm::angleAxis(0.25f, glm::vec3(1.0f, 0.0f, 0.0f));
+  CHECK(transform.Rotation.w == doctest::Approx(expected.w));
+  CHECK(transform.Rotation.x == doctest::Approx(expected.x));
+  CHECK(transform.Rotation.y == doctest::Approx(expected.y));
+  CHECK(transform.Rotation.z == doctest::Approx(expected.z));
+}
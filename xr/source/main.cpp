@@ -1055,7 +1055,9 @@ bool RenderLayer(Resources &res, entt::registry &world) {
   // RenderLayerInfo renderlarInfo;
   // xrRes->renderLayerInfo.predictedDisplayTime = 0;
   // Locate the views from the view configuration within the (reference) space at the display time.
-  std::vector<XrView> views(xrRes->viewConfigurationViews.size(), {XR_TYPE_VIEW});
+  // Per-frame scratch: the views are only needed until the layer is submitted.
+  std::pmr::vector<XrView> views(xrRes->viewConfigurationViews.size(), {XR_TYPE_VIEW},
+                                 frame_scratch(res));
 
   XrViewState viewState{XR_TYPE_VIEW_STATE};  // Will contain information on whether the position
                                               // and/or orientation is valid and/or tracked.